@@ -130,6 +130,22 @@ bool _ResourceLoader::exists(const String &p_path, const String &p_type_hint) {
 	return ResourceLoader::exists(p_path, p_type_hint);
 }
 
+void _ResourceLoader::begin_load_manifest_recording() {
+	ResourceLoader::begin_load_manifest_recording();
+}
+
+Error _ResourceLoader::end_load_manifest_recording(const String &p_manifest_path) {
+	return ResourceLoader::end_load_manifest_recording(p_manifest_path);
+}
+
+bool _ResourceLoader::is_recording_load_manifest() {
+	return ResourceLoader::is_recording_load_manifest();
+}
+
+Error _ResourceLoader::prefetch_load_manifest(const String &p_manifest_path) {
+	return ResourceLoader::prefetch_load_manifest(p_manifest_path);
+}
+
 void _ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_threaded_request", "path", "type_hint", "use_sub_threads"), &_ResourceLoader::load_threaded_request, DEFVAL(""), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("load_threaded_get_status", "path", "progress"), &_ResourceLoader::load_threaded_get_status, DEFVAL(Array()));
@@ -142,6 +158,11 @@ void _ResourceLoader::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("has_cached", "path"), &_ResourceLoader::has_cached);
 	ClassDB::bind_method(D_METHOD("exists", "path", "type_hint"), &_ResourceLoader::exists, DEFVAL(""));
 
+	ClassDB::bind_method(D_METHOD("begin_load_manifest_recording"), &_ResourceLoader::begin_load_manifest_recording);
+	ClassDB::bind_method(D_METHOD("end_load_manifest_recording", "manifest_path"), &_ResourceLoader::end_load_manifest_recording);
+	ClassDB::bind_method(D_METHOD("is_recording_load_manifest"), &_ResourceLoader::is_recording_load_manifest);
+	ClassDB::bind_method(D_METHOD("prefetch_load_manifest", "manifest_path"), &_ResourceLoader::prefetch_load_manifest);
+
 	BIND_ENUM_CONSTANT(THREAD_LOAD_INVALID_RESOURCE);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_IN_PROGRESS);
 	BIND_ENUM_CONSTANT(THREAD_LOAD_FAILED);
@@ -69,6 +69,11 @@ public:
 	bool has_cached(const String &p_path);
 	bool exists(const String &p_path, const String &p_type_hint = "");
 
+	void begin_load_manifest_recording();
+	Error end_load_manifest_recording(const String &p_manifest_path);
+	bool is_recording_load_manifest();
+	Error prefetch_load_manifest(const String &p_manifest_path);
+
 	_ResourceLoader() { singleton = this; }
 };
 
@@ -513,6 +513,29 @@ Object *ClassDB::instance(const StringName &p_class) {
 	return ti->creation_func();
 }
 
+// Resolves the constructor ClassDB::instance() would use, so callers creating
+// the same class many times can skip the lookup. Returns nullptr whenever
+// instance() would fail, so the caller can fall back to it for the error.
+Object *(*ClassDB::get_creation_func(const StringName &p_class))() {
+	OBJTYPE_RLOCK;
+
+	ClassInfo *ti = classes.getptr(p_class);
+	if (!ti || ti->disabled || !ti->creation_func) {
+		if (compat_classes.has(p_class)) {
+			ti = classes.getptr(compat_classes[p_class]);
+		}
+	}
+	if (!ti || ti->disabled) {
+		return nullptr;
+	}
+#ifdef TOOLS_ENABLED
+	if (ti->api == API_EDITOR && !Engine::get_singleton()->is_editor_hint()) {
+		return nullptr;
+	}
+#endif
+	return ti->creation_func;
+}
+
 bool ClassDB::can_instance(const StringName &p_class) {
 	OBJTYPE_RLOCK;
 
@@ -1237,6 +1260,24 @@ StringName ClassDB::get_property_setter(StringName p_class, const StringName &p_
 	return StringName();
 }
 
+bool ClassDB::get_property_setget(const StringName &p_class, const StringName &p_property, PropertySetGet *r_setget) {
+	OBJTYPE_RLOCK;
+
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			*r_setget = *psg;
+			return true;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return false;
+}
+
 StringName ClassDB::get_property_getter(StringName p_class, const StringName &p_property) {
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
@@ -0,0 +1,235 @@
+/*************************************************************************/
+/*  file_access_async.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "file_access_async.h"
+
+Mutex FileAccessAsync::mutex;
+Map<FileAccess *, FileAccessAsync::SerialFile *> FileAccessAsync::serial_files;
+Semaphore FileAccessAsync::queue_semaphore;
+List<FileAccessAsync::Request *> FileAccessAsync::queue;
+HashMap<FileAccessAsync::RequestID, FileAccessAsync::Request *> FileAccessAsync::requests;
+Vector<Thread *> FileAccessAsync::threads;
+FileAccessAsync::RequestID FileAccessAsync::last_id = 0;
+bool FileAccessAsync::threads_started = false;
+bool FileAccessAsync::exit_threads = false;
+
+void FileAccessAsync::_perform(Request *p_request) {
+	const Read &r = p_request->read;
+	if (!r.file || (!r.dst && r.length > 0) || r.length < 0) {
+		p_request->error = ERR_INVALID_PARAMETER;
+		return;
+	}
+
+	if (r.file->has_concurrent_reads()) {
+		p_request->result = r.file->get_buffer_at(r.offset, r.dst, r.length);
+	} else {
+		SerialFile *serial;
+		{
+			MutexLock lock(mutex);
+			Map<FileAccess *, SerialFile *>::Element *E = serial_files.find(r.file);
+			if (E) {
+				serial = E->get();
+			} else {
+				serial = memnew(SerialFile);
+				serial_files.insert(r.file, serial);
+			}
+			serial->reads++;
+		}
+
+		serial->mutex.lock();
+		p_request->result = r.file->get_buffer_at(r.offset, r.dst, r.length);
+		serial->mutex.unlock();
+
+		MutexLock lock(mutex);
+		if (--serial->reads == 0) {
+			serial_files.erase(r.file);
+			memdelete(serial);
+		}
+	}
+
+	if (p_request->result < 0) {
+		p_request->result = 0;
+		p_request->error = ERR_FILE_CANT_READ;
+	} else if (p_request->result < r.length) {
+		p_request->error = ERR_FILE_EOF;
+	}
+}
+
+void FileAccessAsync::_complete(Request *p_request) {
+	if (p_request->read.completion) {
+		p_request->read.completion(p_request->read.userdata, p_request->id, p_request->error, p_request->result);
+		memdelete(p_request);
+		return;
+	}
+
+	{
+		MutexLock lock(mutex);
+		p_request->done = true;
+	}
+	p_request->finished.post();
+}
+
+void FileAccessAsync::_thread_function(void *p_userdata) {
+	while (true) {
+		queue_semaphore.wait();
+
+		Request *request = nullptr;
+		{
+			MutexLock lock(mutex);
+			if (queue.empty()) {
+				if (exit_threads) {
+					break;
+				}
+				continue;
+			}
+			request = queue.front()->get();
+			queue.pop_front();
+		}
+
+		_perform(request);
+		_complete(request);
+	}
+}
+
+FileAccessAsync::RequestID FileAccessAsync::read(const Read &p_read) {
+	RequestID id;
+	read_batch(&p_read, 1, &id);
+	return id;
+}
+
+void FileAccessAsync::read_batch(const Read *p_reads, int p_count, RequestID *r_ids) {
+	ERR_FAIL_COND(p_count < 0);
+
+	Vector<Request *> submitted;
+	submitted.resize(p_count);
+
+	bool threaded;
+	{
+		MutexLock lock(mutex);
+		ERR_FAIL_COND_MSG(exit_threads, "Asynchronous file access was already finalized.");
+
+		// Threads are only started the first time something is read this way.
+		if (!threads_started) {
+			threads_started = true;
+			for (int i = 0; i < IO_THREAD_COUNT; i++) {
+				Thread *thread = Thread::create(_thread_function, nullptr);
+				if (!thread) {
+					break;
+				}
+				threads.push_back(thread);
+			}
+		}
+		threaded = threads.size() > 0;
+
+		for (int i = 0; i < p_count; i++) {
+			Request *request = memnew(Request);
+			request->id = ++last_id;
+			request->read = p_reads[i];
+			if (!request->read.completion) {
+				requests.set(request->id, request);
+			}
+			if (r_ids) {
+				r_ids[i] = request->id;
+			}
+			if (threaded) {
+				queue.push_back(request);
+			}
+			submitted.write[i] = request;
+		}
+	}
+
+	if (!threaded) {
+		// No thread support, complete everything right away.
+		for (int i = 0; i < p_count; i++) {
+			_perform(submitted[i]);
+			_complete(submitted[i]);
+		}
+		return;
+	}
+
+	for (int i = 0; i < p_count; i++) {
+		queue_semaphore.post();
+	}
+}
+
+bool FileAccessAsync::is_done(RequestID p_id) {
+	MutexLock lock(mutex);
+	Request **request = requests.getptr(p_id);
+	// Unknown requests were either waited on already or released after their completion.
+	return !request || (*request)->done;
+}
+
+Error FileAccessAsync::wait(RequestID p_id, int *r_read) {
+	Request *request;
+	{
+		MutexLock lock(mutex);
+		Request **E = requests.getptr(p_id);
+		ERR_FAIL_COND_V_MSG(!E, ERR_INVALID_PARAMETER, "Invalid or already released asynchronous read: " + itos(p_id) + ".");
+		request = *E;
+	}
+
+	request->finished.wait();
+
+	{
+		MutexLock lock(mutex);
+		requests.erase(p_id);
+	}
+
+	Error err = request->error;
+	if (r_read) {
+		*r_read = request->result;
+	}
+	memdelete(request);
+	return err;
+}
+
+void FileAccessAsync::finalize() {
+	{
+		MutexLock lock(mutex);
+		exit_threads = true;
+	}
+
+	// Pending reads are drained before the threads exit.
+	for (int i = 0; i < threads.size(); i++) {
+		queue_semaphore.post();
+	}
+	for (int i = 0; i < threads.size(); i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+	threads.clear();
+
+	// Anything nobody waited on is released here.
+	const RequestID *K = nullptr;
+	while ((K = requests.next(K))) {
+		memdelete(requests[*K]);
+	}
+	requests.clear();
+}
@@ -0,0 +1,111 @@
+/*************************************************************************/
+/*  file_access_async.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef FILE_ACCESS_ASYNC_H
+#define FILE_ACCESS_ASYNC_H
+
+#include "core/hash_map.h"
+#include "core/list.h"
+#include "core/map.h"
+#include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+
+/**
+ * Ranged reads serviced by a small pool of I/O threads, so loaders can keep
+ * parsing while data for other files (or other parts of a pack) arrives.
+ *
+ * Files stay owned by the caller and must outlive their requests. Files that
+ * can't read concurrently (see FileAccess::has_concurrent_reads()) are read
+ * one request at a time per file and must not be used directly until they
+ * complete.
+ */
+
+class FileAccessAsync {
+public:
+	typedef uint64_t RequestID;
+	typedef void (*CompletionFunc)(void *p_userdata, RequestID p_id, Error p_error, int p_read);
+
+	struct Read {
+		FileAccess *file = nullptr;
+		uint64_t offset = 0;
+		uint8_t *dst = nullptr;
+		int length = 0;
+		// Called from an I/O thread; requests with a completion are released once it returns and can't be waited on.
+		CompletionFunc completion = nullptr;
+		void *userdata = nullptr;
+	};
+
+	enum {
+		IO_THREAD_COUNT = 4
+	};
+
+private:
+	struct Request {
+		RequestID id = 0;
+		Read read;
+		Error error = OK;
+		int result = 0;
+		bool done = false;
+		Semaphore finished;
+	};
+
+	// Files that can't read concurrently get one lock each, kept while they have reads in flight.
+	struct SerialFile {
+		Mutex mutex;
+		int reads = 0;
+	};
+
+	static Mutex mutex;
+	static Map<FileAccess *, SerialFile *> serial_files;
+	static Semaphore queue_semaphore;
+	static List<Request *> queue;
+	static HashMap<RequestID, Request *> requests;
+	static Vector<Thread *> threads;
+	static RequestID last_id;
+	static bool threads_started;
+	static bool exit_threads;
+
+	static void _perform(Request *p_request);
+	static void _complete(Request *p_request);
+	static void _thread_function(void *p_userdata);
+
+public:
+	static RequestID read(const Read &p_read);
+	static void read_batch(const Read *p_reads, int p_count, RequestID *r_ids = nullptr);
+
+	static bool is_done(RequestID p_id);
+	static Error wait(RequestID p_id, int *r_read = nullptr); ///< blocks until the read finishes and releases it; only one caller may wait on a request
+
+	static void finalize();
+};
+
+#endif // FILE_ACCESS_ASYNC_H
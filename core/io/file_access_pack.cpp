@@ -285,6 +285,30 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 	return to_read;
 }
 
+void FileAccessPack::prefetch(size_t p_offset, size_t p_length) {
+	if (p_offset >= pf.size) {
+		return;
+	}
+	// Only hint the slice of the pack that belongs to this file.
+	size_t length = pf.size - p_offset;
+	if (p_length) {
+		length = MIN(length, p_length);
+	}
+	f->prefetch(pf.offset + p_offset, length);
+}
+
+int FileAccessPack::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, int p_length) {
+	if (p_offset >= pf.size) {
+		return 0;
+	}
+	int length = MIN((uint64_t)p_length, pf.size - p_offset);
+	return f->get_buffer_at(pf.offset + p_offset, p_dst, length);
+}
+
+bool FileAccessPack::has_concurrent_reads() const {
+	return f->has_concurrent_reads();
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
 	f->set_endian_swap(p_swap);
@@ -157,6 +157,11 @@ public:
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
 
+	virtual void prefetch(size_t p_offset = 0, size_t p_length = 0);
+
+	virtual int get_buffer_at(uint64_t p_offset, uint8_t *p_dst, int p_length);
+	virtual bool has_concurrent_reads() const;
+
 	virtual void set_endian_swap(bool p_swap);
 
 	virtual Error get_error() const;
@@ -165,6 +165,157 @@ static inline double decode_double(const uint8_t *p_arr) {
 	return md.d;
 }
 
+/**
+  * Bit level writer and reader, to pack values which don't need whole bytes.
+  * The writer appends to a buffer owned by the caller and only resizes it when
+  * it runs out of room, so reusing the same buffer doesn't allocate.
+  */
+class BitWriter {
+	Vector<uint8_t> *buffer;
+	int bit_pos;
+
+	_FORCE_INLINE_ void _ensure_room(int p_bits) {
+		int needed = (bit_pos + p_bits + 7) >> 3;
+		if (needed > buffer->size()) {
+			buffer->resize(next_power_of_2(needed));
+		}
+	}
+
+public:
+	_FORCE_INLINE_ void put_bits(uint64_t p_value, int p_bits) {
+		_ensure_room(p_bits);
+		uint8_t *w = buffer->ptrw();
+		while (p_bits > 0) {
+			int shift = bit_pos & 7;
+			int n = MIN(8 - shift, p_bits);
+			uint8_t mask = (1 << n) - 1;
+			uint8_t &byte = w[bit_pos >> 3];
+			byte = (byte & ~(mask << shift)) | ((p_value & mask) << shift);
+			p_value >>= n;
+			p_bits -= n;
+			bit_pos += n;
+		}
+	}
+
+	_FORCE_INLINE_ void put_bool(bool p_value) { put_bits(p_value ? 1 : 0, 1); }
+
+	_FORCE_INLINE_ void put_float(float p_value) {
+		MarshallFloat mf;
+		mf.f = p_value;
+		put_bits(mf.i, 32);
+	}
+
+	// 7 bits per group, each followed by a continuation bit.
+	void put_varint(uint64_t p_value) {
+		do {
+			put_bits(p_value & 0x7F, 7);
+			p_value >>= 7;
+			put_bool(p_value != 0);
+		} while (p_value);
+	}
+
+	_FORCE_INLINE_ void put_zigzag(int64_t p_value) { put_varint((uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63)); }
+
+	_FORCE_INLINE_ void align() { bit_pos = (bit_pos + 7) & ~7; }
+
+	// Aligns to the next byte and returns room for `p_bytes` to be written directly.
+	uint8_t *reserve_bytes(int p_bytes) {
+		align();
+		_ensure_room(p_bytes * 8);
+		uint8_t *w = &buffer->ptrw()[bit_pos >> 3];
+		bit_pos += p_bytes * 8;
+		return w;
+	}
+
+	void put_bytes(const uint8_t *p_data, int p_bytes) {
+		if (p_bytes > 0) {
+			memcpy(reserve_bytes(p_bytes), p_data, p_bytes);
+		}
+	}
+
+	_FORCE_INLINE_ int get_byte_size() const { return (bit_pos + 7) >> 3; }
+
+	BitWriter(Vector<uint8_t> &p_buffer, int p_byte_offset = 0) {
+		buffer = &p_buffer;
+		bit_pos = p_byte_offset * 8;
+	}
+};
+
+class BitReader {
+	const uint8_t *data;
+	int size;
+	int bit_pos;
+	bool error = false;
+
+public:
+	_FORCE_INLINE_ uint64_t get_bits(int p_bits) {
+		if (bit_pos + p_bits > size * 8) {
+			error = true;
+			bit_pos = size * 8;
+			return 0;
+		}
+		uint64_t value = 0;
+		int written = 0;
+		while (written < p_bits) {
+			int shift = bit_pos & 7;
+			int n = MIN(8 - shift, p_bits - written);
+			value |= uint64_t((data[bit_pos >> 3] >> shift) & ((1 << n) - 1)) << written;
+			written += n;
+			bit_pos += n;
+		}
+		return value;
+	}
+
+	_FORCE_INLINE_ bool get_bool() { return get_bits(1) != 0; }
+
+	_FORCE_INLINE_ float get_float() {
+		MarshallFloat mf;
+		mf.i = get_bits(32);
+		return mf.f;
+	}
+
+	uint64_t get_varint() {
+		uint64_t value = 0;
+		for (int shift = 0; shift < 64 && !error; shift += 7) {
+			value |= get_bits(7) << shift;
+			if (!get_bool()) {
+				return value;
+			}
+		}
+		error = true;
+		return 0;
+	}
+
+	_FORCE_INLINE_ int64_t get_zigzag() {
+		uint64_t v = get_varint();
+		return int64_t(v >> 1) ^ -int64_t(v & 1);
+	}
+
+	_FORCE_INLINE_ void align() { bit_pos = (bit_pos + 7) & ~7; }
+
+	// Aligns to the next byte and returns the next `p_bytes` to be read directly, or nullptr if there aren't enough.
+	const uint8_t *read_bytes(int p_bytes) {
+		align();
+		if (p_bytes < 0 || bit_pos + p_bytes * 8 > size * 8) {
+			error = true;
+			return nullptr;
+		}
+		const uint8_t *r = &data[bit_pos >> 3];
+		bit_pos += p_bytes * 8;
+		return r;
+	}
+
+	_FORCE_INLINE_ int get_remaining_bytes() const { return size - ((bit_pos + 7) >> 3); }
+	_FORCE_INLINE_ int get_byte_position() const { return (bit_pos + 7) >> 3; }
+	_FORCE_INLINE_ bool has_error() const { return error; }
+
+	BitReader(const uint8_t *p_data, int p_size, int p_byte_offset = 0) {
+		data = p_data;
+		size = p_size;
+		bit_pos = p_byte_offset * 8;
+	}
+};
+
 class EncodedObjectAsID : public Reference {
 	GDCLASS(EncodedObjectAsID, Reference);
 
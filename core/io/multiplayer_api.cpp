@@ -39,6 +39,7 @@
 #define NODE_ID_COMPRESSION_SHIFT 3
 #define NAME_ID_COMPRESSION_SHIFT 5
 #define BYTE_ONLY_OR_NO_ARGS_SHIFT 6
+#define TYPED_ARGS_SHIFT 7
 
 #ifdef DEBUG_ENABLED
 #include "core/os/os.h"
@@ -128,18 +129,44 @@ void MultiplayerAPI::poll() {
 			break; // It's also possible that a packet or RPC caused a disconnection, so also check here.
 		}
 	}
+
+	if (!network_peer.is_valid()) {
+		return;
+	}
+
+	_update_interest();
+
+	if (!replicated_nodes.empty() && network_peer->is_server()) {
+		_send_snapshots();
+	}
+
+	_flush_packet_batches();
 }
 
 void MultiplayerAPI::clear() {
 	connected_peers.clear();
 	path_get_cache.clear();
 	path_send_cache.clear();
+	path_send_cache_by_id.clear();
+	path_send_cache_epoch++;
 	packet_cache.clear();
 	last_send_cache_id = 1;
+	peer_snapshots.clear();
+	sent_snapshots.clear();
+	received_snapshots.clear();
+	last_applied_snapshot = 0;
+	snapshot_node_cache.clear();
+	interest_peers.clear();
+	_rebuild_interest();
+	for (int i = 0; i < 3; i++) {
+		packet_batches[i].clear();
+	}
 }
 
 void MultiplayerAPI::set_root_node(Node *p_node) {
 	root_node = p_node;
+	// Paths are relative to the root, so the IDs nodes remember are stale now.
+	path_send_cache_epoch++;
 }
 
 void MultiplayerAPI::set_network_peer(const Ref<NetworkedMultiplayerPeer> &p_peer) {
@@ -211,14 +238,20 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 	ERR_FAIL_COND_MSG(root_node == nullptr, "Multiplayer root node was not initialized. If you are using custom multiplayer, remember to set the root node via MultiplayerAPI.set_root_node before using it.");
 	ERR_FAIL_COND_MSG(p_packet_len < 1, "Invalid packet received. Size too small.");
 
-#ifdef DEBUG_ENABLED
-	_profile_bandwidth_data("in", p_packet_len);
-#endif
-
 	// Extract the `packet_type` from the LSB three bits:
 	uint8_t packet_type = p_packet[0] & 7;
 
+#ifdef DEBUG_ENABLED
+	if (packet_type != NETWORK_COMMAND_BATCH) { // Batched messages are counted one by one.
+		_profile_bandwidth_data("in", p_packet_len);
+	}
+#endif
+
 	switch (packet_type) {
+		case NETWORK_COMMAND_BATCH: {
+			_process_batch(p_from, p_packet, p_packet_len);
+		} break;
+
 		case NETWORK_COMMAND_SIMPLIFY_PATH: {
 			_process_simplify_path(p_from, p_packet, p_packet_len);
 		} break;
@@ -310,6 +343,17 @@ void MultiplayerAPI::_process_packet(int p_from, const uint8_t *p_packet, int p_
 		case NETWORK_COMMAND_RAW: {
 			_process_raw(p_from, p_packet, p_packet_len);
 		} break;
+
+		case NETWORK_COMMAND_SNAPSHOT: {
+			// Snapshots set properties directly, so only the server may send them.
+			ERR_FAIL_COND_MSG(network_peer->is_server() || p_from != 1, "Invalid packet received. Snapshots can only be sent by the server.");
+			_process_snapshot(p_from, p_packet, p_packet_len);
+		} break;
+
+		case NETWORK_COMMAND_SNAPSHOT_ACK: {
+			ERR_FAIL_COND_MSG(!network_peer->is_server(), "Invalid packet received. Only the server receives snapshot acknowledgments.");
+			_process_snapshot_ack(p_from, p_packet, p_packet_len);
+		} break;
 	}
 }
 
@@ -371,9 +415,16 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id,
 
 	int argc = 0;
 	bool byte_only = false;
+	const Vector<RPCArgument> *signature = nullptr;
 
 	const bool byte_only_or_no_args = ((p_packet[0] & 64) >> BYTE_ONLY_OR_NO_ARGS_SHIFT) == 1;
-	if (byte_only_or_no_args) {
+	const bool typed_args = ((p_packet[0] & 128) >> TYPED_ARGS_SHIFT) == 1;
+	if (typed_args) {
+		// The argument count and types come from the signature.
+		signature = p_node->get_node_rpc_signature(name);
+		ERR_FAIL_COND_MSG(!signature, "Invalid packet received. RPC '" + String(name) + "' has typed arguments, but no signature on node " + p_node->get_path() + ".");
+		argc = signature->size();
+	} else if (byte_only_or_no_args) {
 		if (p_offset < p_packet_len) {
 			// This packet contains only bytes.
 			argc = 1;
@@ -405,6 +456,13 @@ void MultiplayerAPI::_process_rpc(Node *p_node, const uint16_t p_rpc_method_id,
 		args.write[0] = pure_data;
 		argp.write[0] = &args[0];
 		p_offset += len;
+	} else if (signature) {
+		BitReader reader(p_packet, p_packet_len, p_offset);
+		for (int i = 0; i < argc; i++) {
+			Error err = _decode_typed_argument(args.write[i], (*signature)[i], reader);
+			ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode RPC argument.");
+			argp.write[i] = &args[i];
+		}
 	} else {
 		for (int i = 0; i < argc; i++) {
 			ERR_FAIL_COND_MSG(p_offset >= p_packet_len, "Invalid packet received. Size too small.");
@@ -504,9 +562,7 @@ void MultiplayerAPI::_process_simplify_path(int p_from, const uint8_t *p_packet,
 	packet.write[1] = valid_rpc_checksum;
 	encode_cstring(pname.get_data(), &packet.write[2]);
 
-	network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-	network_peer->set_target_peer(p_from);
-	network_peer->put_packet(packet.ptr(), packet.size());
+	_put_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size());
 }
 
 void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -531,7 +587,37 @@ void MultiplayerAPI::_process_confirm_path(int p_from, const uint8_t *p_packet,
 	E->get() = true;
 }
 
-bool MultiplayerAPI::_send_confirm_path(Node *p_node, NodePath p_path, PathSentCache *psc, int p_target) {
+MultiplayerAPI::PathSentCache *MultiplayerAPI::_get_path_send_cache(Node *p_node) {
+	// Fast path, the node remembers the ID we gave it until its path changes.
+	int id = p_node->get_network_path_id(get_instance_id(), path_send_cache_epoch);
+	if (id > 0) {
+		return path_send_cache_by_id[id - 1];
+	}
+
+	NodePath path = (root_node->get_path()).rel_path_to(p_node->get_path());
+	ERR_FAIL_COND_V_MSG(path.is_empty(), nullptr, "Unable to send RPC. Relative path is empty. THIS IS LIKELY A BUG IN THE ENGINE!");
+
+	PathSentCache *psc = _get_path_send_cache(path);
+	p_node->set_network_path_id(get_instance_id(), path_send_cache_epoch, psc->id);
+	return psc;
+}
+
+MultiplayerAPI::PathSentCache *MultiplayerAPI::_get_path_send_cache(const NodePath &p_path) {
+	// See if the path is cached.
+	PathSentCache *psc = path_send_cache.getptr(p_path);
+	if (!psc) {
+		// Path is not cached, create.
+		path_send_cache[p_path] = PathSentCache();
+		psc = path_send_cache.getptr(p_path);
+		psc->id = last_send_cache_id++;
+		psc->path = p_path;
+		psc->path_utf8 = String(p_path).utf8();
+		path_send_cache_by_id.push_back(psc);
+	}
+	return psc;
+}
+
+bool MultiplayerAPI::_send_confirm_path(Node *p_node, PathSentCache *psc, int p_target) {
 	bool has_all_peers = true;
 	List<int> peers_to_add; // If one is missing, take note to add it.
 
@@ -561,7 +647,7 @@ bool MultiplayerAPI::_send_confirm_path(Node *p_node, NodePath p_path, PathSentC
 		// Those that need to be added, send a message for this.
 
 		// Encode function name.
-		const CharString path = String(p_path).utf8();
+		const CharString &path = psc->path_utf8;
 		const int path_len = encode_cstring(path.get_data(), nullptr);
 
 		// Extract MD5 from rpc methods list.
@@ -582,9 +668,7 @@ bool MultiplayerAPI::_send_confirm_path(Node *p_node, NodePath p_path, PathSentC
 		ofs += encode_cstring(path.get_data(), &packet.write[ofs]);
 
 		for (List<int>::Element *E = peers_to_add.front(); E; E = E->next()) {
-			network_peer->set_target_peer(E->get()); // To all of you.
-			network_peer->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
-			network_peer->put_packet(packet.ptr(), packet.size());
+			_put_packet(E->get(), NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE, packet.ptr(), packet.size()); // To all of you.
 
 			psc->confirmed_peers.insert(E->get(), false); // Insert into confirmed, but as false since it was not confirmed.
 		}
@@ -748,6 +832,146 @@ Error MultiplayerAPI::_decode_and_decompress_variant(Variant &r_variant, const u
 	return OK;
 }
 
+static _FORCE_INLINE_ void _put_quantized(BitWriter &r_writer, real_t p_value, const MultiplayerAPI::RPCArgument &p_argument) {
+	if (p_argument.bits == 0) {
+		r_writer.put_float(p_value);
+		return;
+	}
+	uint64_t steps = (uint64_t(1) << p_argument.bits) - 1;
+	real_t t = (CLAMP(p_value, p_argument.min, p_argument.max) - p_argument.min) / (p_argument.max - p_argument.min);
+	r_writer.put_bits(uint64_t(Math::round(t * steps)), p_argument.bits);
+}
+
+static _FORCE_INLINE_ real_t _get_quantized(BitReader &r_reader, const MultiplayerAPI::RPCArgument &p_argument) {
+	if (p_argument.bits == 0) {
+		return r_reader.get_float();
+	}
+	uint64_t steps = (uint64_t(1) << p_argument.bits) - 1;
+	return p_argument.min + (p_argument.max - p_argument.min) * (real_t(r_reader.get_bits(p_argument.bits)) / steps);
+}
+
+Error MultiplayerAPI::_encode_typed_argument(const Variant &p_value, const RPCArgument &p_argument, BitWriter &r_writer) {
+	if (p_argument.type != Variant::NIL && p_value.get_type() != p_argument.type) {
+		ERR_FAIL_COND_V(!Variant::can_convert_strict(p_value.get_type(), p_argument.type), ERR_INVALID_PARAMETER);
+	}
+
+	switch (p_argument.type) {
+		case Variant::BOOL: {
+			r_writer.put_bool(p_value);
+		} break;
+		case Variant::INT: {
+			int64_t value = p_value;
+			if (p_argument.bits == 0) {
+				r_writer.put_zigzag(value);
+			} else {
+				int64_t offset = value - int64_t(p_argument.min);
+				r_writer.put_bits(CLAMP(offset, int64_t(0), int64_t((uint64_t(1) << p_argument.bits) - 1)), p_argument.bits);
+			}
+		} break;
+		case Variant::FLOAT: {
+			_put_quantized(r_writer, p_value, p_argument);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = p_value;
+			_put_quantized(r_writer, v.x, p_argument);
+			_put_quantized(r_writer, v.y, p_argument);
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_value;
+			_put_quantized(r_writer, v.x, p_argument);
+			_put_quantized(r_writer, v.y, p_argument);
+			_put_quantized(r_writer, v.z, p_argument);
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			CharString utf8 = String(p_value).utf8();
+			r_writer.put_varint(utf8.length());
+			r_writer.put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			Vector<uint8_t> data = p_value;
+			r_writer.put_varint(data.size());
+			r_writer.put_bytes(data.ptr(), data.size());
+		} break;
+		default: {
+			// No compact form, use the regular encoding. It knows its own length.
+			ERR_FAIL_COND_V(p_argument.type != Variant::NIL && p_value.get_type() != p_argument.type, ERR_INVALID_PARAMETER);
+			int len = 0;
+			Error err = _encode_and_compress_variant(p_value, nullptr, len);
+			ERR_FAIL_COND_V(err != OK, err);
+			return _encode_and_compress_variant(p_value, r_writer.reserve_bytes(len), len);
+		}
+	}
+
+	return OK;
+}
+
+Error MultiplayerAPI::_decode_typed_argument(Variant &r_value, const RPCArgument &p_argument, BitReader &r_reader) {
+	switch (p_argument.type) {
+		case Variant::BOOL: {
+			r_value = r_reader.get_bool();
+		} break;
+		case Variant::INT: {
+			if (p_argument.bits == 0) {
+				r_value = r_reader.get_zigzag();
+			} else {
+				r_value = int64_t(p_argument.min) + int64_t(r_reader.get_bits(p_argument.bits));
+			}
+		} break;
+		case Variant::FLOAT: {
+			r_value = _get_quantized(r_reader, p_argument);
+		} break;
+		case Variant::VECTOR2: {
+			real_t x = _get_quantized(r_reader, p_argument);
+			real_t y = _get_quantized(r_reader, p_argument);
+			r_value = Vector2(x, y);
+		} break;
+		case Variant::VECTOR3: {
+			real_t x = _get_quantized(r_reader, p_argument);
+			real_t y = _get_quantized(r_reader, p_argument);
+			real_t z = _get_quantized(r_reader, p_argument);
+			r_value = Vector3(x, y, z);
+		} break;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			uint64_t len = r_reader.get_varint();
+			ERR_FAIL_COND_V(len > uint64_t(r_reader.get_remaining_bytes()), ERR_INVALID_DATA);
+			const uint8_t *r = r_reader.read_bytes(len);
+			ERR_FAIL_COND_V(!r, ERR_INVALID_DATA);
+			String str;
+			str.parse_utf8((const char *)r, len);
+			if (p_argument.type == Variant::STRING_NAME) {
+				r_value = StringName(str);
+			} else {
+				r_value = str;
+			}
+		} break;
+		case Variant::PACKED_BYTE_ARRAY: {
+			uint64_t len = r_reader.get_varint();
+			ERR_FAIL_COND_V(len > uint64_t(r_reader.get_remaining_bytes()), ERR_INVALID_DATA);
+			const uint8_t *r = r_reader.read_bytes(len);
+			ERR_FAIL_COND_V(!r, ERR_INVALID_DATA);
+			Vector<uint8_t> data;
+			data.resize(len);
+			if (len) {
+				memcpy(data.ptrw(), r, len);
+			}
+			r_value = data;
+		} break;
+		default: {
+			const uint8_t *r = r_reader.read_bytes(0);
+			ERR_FAIL_COND_V(!r, ERR_INVALID_DATA);
+			int len = 0;
+			Error err = _decode_and_decompress_variant(r_value, r, r_reader.get_remaining_bytes(), &len);
+			ERR_FAIL_COND_V(err != OK, err);
+			r_reader.read_bytes(len);
+			ERR_FAIL_COND_V(p_argument.type != Variant::NIL && r_value.get_type() != p_argument.type, ERR_INVALID_DATA);
+		}
+	}
+
+	return r_reader.has_error() ? ERR_INVALID_DATA : OK;
+}
+
 void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount) {
 	ERR_FAIL_COND_MSG(network_peer.is_null(), "Attempt to remote call/set when networking is not active in SceneTree.");
 
@@ -763,20 +987,24 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 		ERR_FAIL_MSG("Attempt to remote call unexisting ID: " + itos(p_to) + ".");
 	}
 
-	NodePath from_path = (root_node->get_path()).rel_path_to(p_from->get_path());
-	ERR_FAIL_COND_MSG(from_path.is_empty(), "Unable to send RPC. Relative path is empty. THIS IS LIKELY A BUG IN THE ENGINE!");
-
-	// See if the path is cached.
-	PathSentCache *psc = path_send_cache.getptr(from_path);
-	if (!psc) {
-		// Path is not cached, create.
-		path_send_cache[from_path] = PathSentCache();
-		psc = path_send_cache.getptr(from_path);
-		psc->id = last_send_cache_id++;
+	if (p_to <= 0 && interest_nodes.has(p_from->get_instance_id())) {
+		// Interest managed, so only send to the peers this node is relevant to.
+		for (Set<int>::Element *E = connected_peers.front(); E; E = E->next()) {
+			if (p_to < 0 && E->get() == -p_to) {
+				continue; // Excluded.
+			}
+			if (_is_relevant(p_from, E->get())) {
+				_send_rpc(p_from, E->get(), p_unreliable, p_set, p_name, p_arg, p_argcount);
+			}
+		}
+		return;
 	}
 
+	PathSentCache *psc = _get_path_send_cache(p_from);
+	ERR_FAIL_COND(!psc);
+
 	// See if all peers have cached path (if so, call can be fast).
-	const bool has_all_peers = _send_confirm_path(p_from, from_path, psc, p_to);
+	const bool has_all_peers = _send_confirm_path(p_from, psc, p_to);
 
 	// Create base packet, lots of hardcode because it must be tight.
 
@@ -797,6 +1025,7 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	uint8_t node_id_compression = UINT8_MAX;
 	uint8_t name_id_compression = UINT8_MAX;
 	bool byte_only_or_no_args = false;
+	bool typed_args = false;
 
 	MAKE_ROOM(1);
 	// The meta is composed along the way, so just set 0 for now.
@@ -886,6 +1115,9 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 			ofs += 2;
 		}
 
+		const Vector<RPCArgument> *signature = p_from->get_node_rpc_signature(p_name);
+		ERR_FAIL_COND_MSG(signature && signature->size() != p_argcount, vformat("RPC \"%s\" was called with %d arguments, but its signature declares %d.", p_name, p_argcount, signature->size()));
+
 		if (p_argcount == 0) {
 			byte_only_or_no_args = true;
 		} else if (p_argcount == 1 && p_arg[0]->get_type() == Variant::PACKED_BYTE_ARRAY) {
@@ -895,6 +1127,15 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 			MAKE_ROOM(ofs + data.size());
 			copymem(&(packet_cache.write[ofs]), data.ptr(), sizeof(uint8_t) * data.size());
 			ofs += data.size();
+		} else if (signature) {
+			// Typed arguments, bit packed without count nor headers.
+			typed_args = true;
+			BitWriter writer(packet_cache, ofs);
+			for (int i = 0; i < p_argcount; i++) {
+				Error err = _encode_typed_argument(*p_arg[i], (*signature)[i], writer);
+				ERR_FAIL_COND_MSG(err != OK, vformat("Unable to encode argument %d of RPC \"%s\", it doesn't match the declared type.", i, p_name));
+			}
+			ofs = writer.get_byte_size();
 		} else {
 			// Arguments
 			MAKE_ROOM(ofs + 1);
@@ -916,19 +1157,17 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 	ERR_FAIL_COND(name_id_compression > 1);
 
 	// We can now set the meta
-	packet_cache.write[0] = command_type + (node_id_compression << NODE_ID_COMPRESSION_SHIFT) + (name_id_compression << NAME_ID_COMPRESSION_SHIFT) + ((byte_only_or_no_args ? 1 : 0) << BYTE_ONLY_OR_NO_ARGS_SHIFT);
+	packet_cache.write[0] = command_type + (node_id_compression << NODE_ID_COMPRESSION_SHIFT) + (name_id_compression << NAME_ID_COMPRESSION_SHIFT) + ((byte_only_or_no_args ? 1 : 0) << BYTE_ONLY_OR_NO_ARGS_SHIFT) + ((typed_args ? 1 : 0) << TYPED_ARGS_SHIFT);
 
 #ifdef DEBUG_ENABLED
 	_profile_bandwidth_data("out", ofs);
 #endif
 
-	// Take chance and set transfer mode, since all send methods will use it.
-	network_peer->set_transfer_mode(p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	NetworkedMultiplayerPeer::TransferMode transfer_mode = p_unreliable ? NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE;
 
 	if (has_all_peers) {
 		// They all have verified paths, so send fast.
-		network_peer->set_target_peer(p_to); // To all of you.
-		network_peer->put_packet(packet_cache.ptr(), ofs); // A message with love.
+		_put_packet(p_to, transfer_mode, packet_cache.ptr(), ofs); // A message with love.
 	} else {
 		// Unreachable because the node ID is never compressed if the peers doesn't know it.
 		CRASH_COND(node_id_compression != NETWORK_NODE_ID_COMPRESSION_32);
@@ -936,7 +1175,7 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 		// Not all verified path, so send one by one.
 
 		// Append path at the end, since we will need it for some packets.
-		CharString pname = String(from_path).utf8();
+		const CharString &pname = psc->path_utf8;
 		int path_len = encode_cstring(pname.get_data(), nullptr);
 		MAKE_ROOM(ofs + path_len);
 		encode_cstring(pname.get_data(), &(packet_cache.write[ofs]));
@@ -953,16 +1192,14 @@ void MultiplayerAPI::_send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p
 			Map<int, bool>::Element *F = psc->confirmed_peers.find(E->get());
 			ERR_CONTINUE(!F); // Should never happen.
 
-			network_peer->set_target_peer(E->get()); // To this one specifically.
-
 			if (F->get()) {
 				// This one confirmed path, so use id.
 				encode_uint32(psc->id, &(packet_cache.write[1]));
-				network_peer->put_packet(packet_cache.ptr(), ofs);
+				_put_packet(E->get(), transfer_mode, packet_cache.ptr(), ofs); // To this one specifically.
 			} else {
 				// This one did not confirm path yet, so use entire path (sorry!).
 				encode_uint32(0x80000000 | ofs, &(packet_cache.write[1])); // Offset to path and flag.
-				network_peer->put_packet(packet_cache.ptr(), ofs + path_len);
+				_put_packet(E->get(), transfer_mode, packet_cache.ptr(), ofs + path_len);
 			}
 		}
 	}
@@ -979,12 +1216,26 @@ void MultiplayerAPI::_del_peer(int p_id) {
 	// Cleanup get cache.
 	path_get_cache.erase(p_id);
 	// Cleanup sent cache.
-	// Some refactoring is needed to make this faster and do paths GC.
-	List<NodePath> keys;
-	path_send_cache.get_key_list(&keys);
-	for (List<NodePath>::Element *E = keys.front(); E; E = E->next()) {
-		PathSentCache *psc = path_send_cache.getptr(E->get());
-		psc->confirmed_peers.erase(p_id);
+	for (int i = 0; i < path_send_cache_by_id.size(); i++) {
+		path_send_cache_by_id[i]->confirmed_peers.erase(p_id);
+	}
+	peer_snapshots.erase(p_id);
+	clear_peer_interest_origin(p_id);
+	for (Map<ObjectID, InterestNode>::Element *E = interest_nodes.front(); E; E = E->next()) {
+		E->get().filtered.erase(p_id);
+	}
+	for (int i = 0; i < 3; i++) {
+		// The peer is no longer a valid target, so drop what was queued for it.
+		packet_batches[i].erase(p_id);
+		// What was queued for everyone but the peer now goes to everyone left.
+		Map<int, PacketBatch>::Element *E = packet_batches[i].find(-p_id);
+		if (E) {
+			if (network_peer.is_valid()) {
+				_flush_packet_batch(NetworkedMultiplayerPeer::TransferMode(i), E, NetworkedMultiplayerPeer::TARGET_PEER_BROADCAST);
+			} else {
+				packet_batches[i].erase(E);
+			}
+		}
 	}
 	emit_signal("network_peer_disconnected", p_id);
 }
@@ -1141,10 +1392,26 @@ Error MultiplayerAPI::send_bytes(Vector<uint8_t> p_data, int p_to, NetworkedMult
 	packet_cache.write[0] = NETWORK_COMMAND_RAW;
 	memcpy(&packet_cache.write[1], &r[0], p_data.size());
 
-	network_peer->set_target_peer(p_to);
-	network_peer->set_transfer_mode(p_mode);
+	return _put_packet(p_to, p_mode, packet_cache.ptr(), p_data.size() + 1);
+}
+
+void MultiplayerAPI::_process_batch(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	// Batches are framed as the command byte, followed by each message prefixed with its 16 bit length.
+	int ofs = 1;
+	while (ofs < p_packet_len) {
+		ERR_FAIL_COND_MSG(ofs + 2 > p_packet_len, "Invalid packet received. Size too small.");
+		int len = decode_uint16(&p_packet[ofs]);
+		ofs += 2;
+		ERR_FAIL_COND_MSG(len < 1 || ofs + len > p_packet_len, "Invalid packet received. Batched message size is out of bounds.");
+		ERR_FAIL_COND_MSG((p_packet[ofs] & 7) == NETWORK_COMMAND_BATCH, "Invalid packet received. Batches can't be nested.");
+
+		_process_packet(p_from, &p_packet[ofs], len);
+		ofs += len;
 
-	return network_peer->put_packet(packet_cache.ptr(), p_data.size() + 1);
+		if (!network_peer.is_valid()) {
+			return; // A message caused a disconnection, drop the rest.
+		}
+	}
 }
 
 void MultiplayerAPI::_process_raw(int p_from, const uint8_t *p_packet, int p_packet_len) {
@@ -1160,6 +1427,855 @@ void MultiplayerAPI::_process_raw(int p_from, const uint8_t *p_packet, int p_pac
 	emit_signal("network_peer_packet", p_from, out);
 }
 
+// Snapshots replicate registered node properties from the server to every peer.
+// Each one only carries what changed since the last snapshot that peer acknowledged,
+// so the peer rebuilds the full state on top of its copy of that snapshot.
+//
+// Layout: command, sequence (4), baseline sequence (4, 0 for none), node count (2), then per node:
+// path cache ID (4), flags (1), the property table when the peer doesn't know the node yet,
+// a changed property mask (4) and the changed values.
+#define SNAPSHOT_FLAG_TABLE 1
+
+Error MultiplayerAPI::_encode_snapshot_value(const Variant &p_value, real_t p_precision, uint8_t *r_buffer, int &r_len) {
+	real_t components[3];
+	int count = 0;
+	if (p_precision > 0) {
+		switch (p_value.get_type()) {
+			case Variant::FLOAT: {
+				components[0] = p_value;
+				count = 1;
+			} break;
+			case Variant::VECTOR2: {
+				Vector2 v = p_value;
+				components[0] = v.x;
+				components[1] = v.y;
+				count = 2;
+			} break;
+			case Variant::VECTOR3: {
+				Vector3 v = p_value;
+				components[0] = v.x;
+				components[1] = v.y;
+				components[2] = v.z;
+				count = 3;
+			} break;
+			default: {
+			}
+		}
+	}
+
+	if (count == 0) {
+		return _encode_and_compress_variant(p_value, r_buffer, r_len);
+	}
+
+	// Quantized components are sent as integers, which the compressor shrinks to the smallest size that fits.
+	r_len = 0;
+	for (int i = 0; i < count; i++) {
+		int len = 0;
+		Error err = _encode_and_compress_variant((int64_t)Math::round(components[i] / p_precision), r_buffer ? r_buffer + r_len : nullptr, len);
+		ERR_FAIL_COND_V(err != OK, err);
+		r_len += len;
+	}
+	return OK;
+}
+
+Error MultiplayerAPI::_decode_snapshot_value(Variant &r_value, Variant::Type p_type, real_t p_precision, const uint8_t *p_buffer, int p_len, int *r_len) {
+	int count = 0;
+	if (p_precision > 0) {
+		switch (p_type) {
+			case Variant::FLOAT: {
+				count = 1;
+			} break;
+			case Variant::VECTOR2: {
+				count = 2;
+			} break;
+			case Variant::VECTOR3: {
+				count = 3;
+			} break;
+			default: {
+			}
+		}
+	}
+
+	if (count == 0) {
+		return _decode_and_decompress_variant(r_value, p_buffer, p_len, r_len);
+	}
+
+	real_t components[3];
+	int ofs = 0;
+	for (int i = 0; i < count; i++) {
+		Variant quantized;
+		int len = 0;
+		Error err = _decode_and_decompress_variant(quantized, p_buffer + ofs, p_len - ofs, &len);
+		ERR_FAIL_COND_V(err != OK, err);
+		ERR_FAIL_COND_V(quantized.get_type() != Variant::INT, ERR_INVALID_DATA);
+		components[i] = (int64_t)quantized * p_precision;
+		ofs += len;
+	}
+
+	switch (p_type) {
+		case Variant::FLOAT: {
+			r_value = components[0];
+		} break;
+		case Variant::VECTOR2: {
+			r_value = Vector2(components[0], components[1]);
+		} break;
+		default: {
+			r_value = Vector3(components[0], components[1], components[2]);
+		}
+	}
+	if (r_len) {
+		*r_len = ofs;
+	}
+	return OK;
+}
+
+// Length of a null terminated string within the given bounds, or -1 if it is not terminated.
+static int _get_cstring_len(const uint8_t *p_buffer, int p_len) {
+	for (int i = 0; i < p_len; i++) {
+		if (p_buffer[i] == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static Variant _quantize_snapshot_value(const Variant &p_value, real_t p_precision) {
+	if (p_precision <= 0) {
+		return p_value;
+	}
+	switch (p_value.get_type()) {
+		case Variant::FLOAT: {
+			return Math::round((real_t)p_value / p_precision) * p_precision;
+		}
+		case Variant::VECTOR2: {
+			Vector2 v = p_value;
+			return Vector2(Math::round(v.x / p_precision), Math::round(v.y / p_precision)) * p_precision;
+		}
+		case Variant::VECTOR3: {
+			Vector3 v = p_value;
+			return Vector3(Math::round(v.x / p_precision), Math::round(v.y / p_precision), Math::round(v.z / p_precision)) * p_precision;
+		}
+		default: {
+			return p_value;
+		}
+	}
+}
+
+void MultiplayerAPI::_send_snapshots() {
+	ERR_FAIL_COND_MSG(root_node == nullptr, "Multiplayer root node was not initialized. If you are using custom multiplayer, remember to set the root node via MultiplayerAPI.set_root_node before using it.");
+
+	// Gather the current (quantized) values once for all peers.
+	SnapshotState current;
+	Map<int, Node *> nodes;
+	Map<int, PathSentCache *> paths;
+	Map<int, const Vector<ReplicatedProperty> *> tables;
+	List<ObjectID> freed;
+
+	for (Map<ObjectID, Vector<ReplicatedProperty>>::Element *E = replicated_nodes.front(); E; E = E->next()) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(E->key()));
+		if (!node) {
+			freed.push_back(E->key());
+			continue;
+		}
+		if (!node->is_inside_tree() || !root_node->is_a_parent_of(node)) {
+			continue;
+		}
+
+		PathSentCache *psc = _get_path_send_cache(node);
+		ERR_CONTINUE(!psc);
+
+		const Vector<ReplicatedProperty> &properties = E->get();
+		Vector<Variant> values;
+		values.resize(properties.size());
+		for (int i = 0; i < properties.size(); i++) {
+			values.write[i] = _quantize_snapshot_value(node->get(properties[i].name), properties[i].precision);
+		}
+
+		current[psc->id] = values;
+		nodes[psc->id] = node;
+		paths[psc->id] = psc;
+		tables[psc->id] = &properties;
+	}
+
+	for (List<ObjectID>::Element *E = freed.front(); E; E = E->next()) {
+		replicated_nodes.erase(E->get());
+	}
+
+	if (current.empty()) {
+		return;
+	}
+
+	snapshot_sequence++;
+
+	// The state is kept once per sequence; what each peer knows of it follows from relevance.
+	sent_snapshots[snapshot_sequence] = current;
+	while (sent_snapshots.size() > SNAPSHOT_HISTORY_SIZE) {
+		sent_snapshots.erase(sent_snapshots.front());
+	}
+
+	for (Set<int>::Element *P = connected_peers.front(); P; P = P->next()) {
+		PeerSnapshots &peer = peer_snapshots[P->get()];
+		Map<uint32_t, SnapshotState>::Element *B = peer.acked ? sent_snapshots.find(peer.acked) : nullptr;
+		const SnapshotState *baseline = B ? &B->get() : nullptr;
+
+		int ofs = 0;
+		MAKE_ROOM(11);
+		packet_cache.write[ofs] = NETWORK_COMMAND_SNAPSHOT;
+		ofs += 1;
+		ofs += encode_uint32(snapshot_sequence, &packet_cache.write[ofs]);
+		ofs += encode_uint32(baseline ? peer.acked : 0, &packet_cache.write[ofs]);
+		int count_ofs = ofs;
+		ofs += 2;
+		int count = 0;
+
+		for (SnapshotState::Element *E = current.front(); E; E = E->next()) {
+			if (!_is_relevant(nodes[E->key()], P->get())) {
+				peer.relevant_since.erase(E->key());
+				continue;
+			}
+
+			Map<int, uint32_t>::Element *R = peer.relevant_since.find(E->key());
+			if (!R) {
+				R = peer.relevant_since.insert(E->key(), snapshot_sequence);
+			}
+
+			const Vector<Variant> &values = E->get();
+			const Vector<Variant> *known = nullptr;
+			// The peer only has the baseline values of nodes that were already relevant to it back then.
+			if (baseline && R->get() <= peer.acked) {
+				const SnapshotState::Element *K = baseline->find(E->key());
+				if (K && K->get().size() == values.size()) {
+					known = &K->get();
+				}
+			}
+
+			uint32_t mask = 0;
+			for (int i = 0; i < values.size(); i++) {
+				if (!known || (*known)[i] != values[i]) {
+					mask |= 1u << i;
+				}
+			}
+			if (mask == 0) {
+				continue; // Unchanged since the peer's baseline.
+			}
+
+			MAKE_ROOM(ofs + 5);
+			ofs += encode_uint32(E->key(), &packet_cache.write[ofs]);
+			packet_cache.write[ofs] = known ? 0 : SNAPSHOT_FLAG_TABLE;
+			ofs += 1;
+
+			if (!known) {
+				// Tell the peer where the node is and how to read its properties.
+				const Vector<ReplicatedProperty> &properties = *tables[E->key()];
+				const CharString &path = paths[E->key()]->path_utf8;
+				MAKE_ROOM(ofs + encode_cstring(path.get_data(), nullptr) + 1);
+				ofs += encode_cstring(path.get_data(), &packet_cache.write[ofs]);
+				packet_cache.write[ofs] = properties.size();
+				ofs += 1;
+				for (int i = 0; i < properties.size(); i++) {
+					CharString name = String(properties[i].name).utf8();
+					MAKE_ROOM(ofs + encode_cstring(name.get_data(), nullptr) + 5);
+					ofs += encode_cstring(name.get_data(), &packet_cache.write[ofs]);
+					packet_cache.write[ofs] = values[i].get_type();
+					ofs += 1;
+					ofs += encode_float(properties[i].precision, &packet_cache.write[ofs]);
+				}
+			}
+
+			MAKE_ROOM(ofs + 4);
+			ofs += encode_uint32(mask, &packet_cache.write[ofs]);
+
+			const Vector<ReplicatedProperty> &properties = *tables[E->key()];
+			for (int i = 0; i < values.size(); i++) {
+				if (!(mask & (1u << i))) {
+					continue;
+				}
+				int len = 0;
+				Error err = _encode_snapshot_value(values[i], properties[i].precision, nullptr, len);
+				ERR_FAIL_COND_MSG(err != OK, "Unable to encode replicated property '" + String(properties[i].name) + "'.");
+				MAKE_ROOM(ofs + len);
+				_encode_snapshot_value(values[i], properties[i].precision, &packet_cache.write[ofs], len);
+				ofs += len;
+			}
+
+			count++;
+		}
+
+		if (count == 0) {
+			continue; // Nothing new for this peer.
+		}
+		encode_uint16(count, &packet_cache.write[count_ofs]);
+
+		// Remember what was sent so an acknowledgment can turn it into the next baseline.
+		peer.sent.insert(snapshot_sequence);
+		while (peer.sent.size() > SNAPSHOT_HISTORY_SIZE) {
+			peer.sent.erase(peer.sent.front());
+		}
+
+#ifdef DEBUG_ENABLED
+		_profile_bandwidth_data("out", ofs);
+#endif
+
+		_put_packet(P->get(), NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, packet_cache.ptr(), ofs);
+	}
+}
+
+void MultiplayerAPI::_process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	ERR_FAIL_COND_MSG(p_packet_len < 11, "Invalid packet received. Size too small.");
+
+	int ofs = 1;
+	uint32_t sequence = decode_uint32(&p_packet[ofs]);
+	ofs += 4;
+	uint32_t baseline_sequence = decode_uint32(&p_packet[ofs]);
+	ofs += 4;
+	int count = decode_uint16(&p_packet[ofs]);
+	ofs += 2;
+
+	if (sequence <= last_applied_snapshot) {
+		return; // Late or duplicated, a newer state was already applied.
+	}
+
+	SnapshotState state;
+	if (baseline_sequence) {
+		Map<uint32_t, SnapshotState>::Element *B = received_snapshots.find(baseline_sequence);
+		if (!B) {
+			return; // Baseline is gone, wait for a snapshot built on a more recent one.
+		}
+		state = B->get();
+	}
+
+	for (int i = 0; i < count; i++) {
+		ERR_FAIL_COND_MSG(ofs + 5 > p_packet_len, "Invalid packet received. Size too small.");
+		int id = decode_uint32(&p_packet[ofs]);
+		ofs += 4;
+		uint8_t flags = p_packet[ofs];
+		ofs += 1;
+
+		if (flags & SNAPSHOT_FLAG_TABLE) {
+			SnapshotNodeInfo info;
+			int len = _get_cstring_len(&p_packet[ofs], p_packet_len - ofs);
+			ERR_FAIL_COND_MSG(len < 0, "Invalid packet received. Unable to decode node path.");
+			String path;
+			path.parse_utf8((const char *)&p_packet[ofs], len);
+			ofs += len + 1;
+			info.path = path;
+			ERR_FAIL_COND_MSG(ofs >= p_packet_len, "Invalid packet received. Size too small.");
+			int property_count = p_packet[ofs];
+			ofs += 1;
+			for (int j = 0; j < property_count; j++) {
+				len = _get_cstring_len(&p_packet[ofs], p_packet_len - ofs);
+				ERR_FAIL_COND_MSG(len < 0, "Invalid packet received. Unable to decode property name.");
+				String name;
+				name.parse_utf8((const char *)&p_packet[ofs], len);
+				ofs += len + 1;
+				ERR_FAIL_COND_MSG(ofs + 5 > p_packet_len, "Invalid packet received. Size too small.");
+				info.properties.push_back(name);
+				info.types.push_back(p_packet[ofs]);
+				ofs += 1;
+				info.precisions.push_back(decode_float(&p_packet[ofs]));
+				ofs += 4;
+			}
+			snapshot_node_cache[id] = info;
+		}
+
+		Map<int, SnapshotNodeInfo>::Element *I = snapshot_node_cache.find(id);
+		ERR_FAIL_COND_MSG(!I, "Invalid packet received. Snapshot references an unknown node.");
+		const SnapshotNodeInfo &info = I->get();
+
+		ERR_FAIL_COND_MSG(ofs + 4 > p_packet_len, "Invalid packet received. Size too small.");
+		uint32_t mask = decode_uint32(&p_packet[ofs]);
+		ofs += 4;
+
+		Vector<Variant> values;
+		SnapshotState::Element *K = state.find(id);
+		if (K && K->get().size() == info.properties.size()) {
+			values = K->get();
+		} else {
+			values.resize(info.properties.size());
+		}
+
+		for (int j = 0; j < info.properties.size(); j++) {
+			if (!(mask & (1u << j))) {
+				continue;
+			}
+			int len = 0;
+			Error err = _decode_snapshot_value(values.write[j], (Variant::Type)info.types[j], info.precisions[j], &p_packet[ofs], p_packet_len - ofs, &len);
+			ERR_FAIL_COND_MSG(err != OK, "Invalid packet received. Unable to decode replicated property.");
+			ofs += len;
+		}
+		state[id] = values;
+	}
+
+	// Apply whatever differs from the last state we applied, which may be newer than the baseline.
+	Map<uint32_t, SnapshotState>::Element *A = received_snapshots.find(last_applied_snapshot);
+	for (SnapshotState::Element *E = state.front(); E; E = E->next()) {
+		Map<int, SnapshotNodeInfo>::Element *I = snapshot_node_cache.find(E->key());
+		if (!I) {
+			continue;
+		}
+		SnapshotNodeInfo &info = I->get();
+
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(info.instance));
+		if (!node) {
+			node = root_node->get_node_or_null(info.path);
+			if (!node) {
+				continue;
+			}
+			info.instance = node->get_instance_id();
+		}
+
+		const Vector<Variant> *applied = nullptr;
+		if (A) {
+			SnapshotState::Element *K = A->get().find(E->key());
+			if (K && K->get().size() == E->get().size()) {
+				applied = &K->get();
+			}
+		}
+
+		const Vector<Variant> &values = E->get();
+		for (int i = 0; i < values.size(); i++) {
+			if (values[i].get_type() == Variant::NIL || (applied && (*applied)[i] == values[i])) {
+				continue;
+			}
+			node->set(info.properties[i], values[i]);
+		}
+	}
+
+	received_snapshots[sequence] = state;
+	while (received_snapshots.size() > SNAPSHOT_HISTORY_SIZE) {
+		received_snapshots.erase(received_snapshots.front());
+	}
+	last_applied_snapshot = sequence;
+
+	uint8_t ack[5];
+	ack[0] = NETWORK_COMMAND_SNAPSHOT_ACK;
+	encode_uint32(sequence, &ack[1]);
+	_put_packet(p_from, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE, ack, 5);
+}
+
+void MultiplayerAPI::_process_snapshot_ack(int p_from, const uint8_t *p_packet, int p_packet_len) {
+	ERR_FAIL_COND_MSG(p_packet_len < 5, "Invalid packet received. Size too small.");
+
+	Map<int, PeerSnapshots>::Element *E = peer_snapshots.find(p_from);
+	if (!E) {
+		return;
+	}
+	PeerSnapshots &peer = E->get();
+
+	uint32_t sequence = decode_uint32(&p_packet[1]);
+	if (sequence <= peer.acked || !peer.sent.has(sequence)) {
+		return;
+	}
+	peer.acked = sequence;
+
+	// Older snapshots can no longer become a baseline.
+	while (peer.sent.front() && peer.sent.front()->get() < sequence) {
+		peer.sent.erase(peer.sent.front());
+	}
+}
+
+void MultiplayerAPI::add_replicated_property(Object *p_node, const StringName &p_property, real_t p_precision) {
+	Node *node = Object::cast_to<Node>(p_node);
+	ERR_FAIL_COND_MSG(!node, "Only nodes can be replicated.");
+
+	Vector<ReplicatedProperty> &properties = replicated_nodes[node->get_instance_id()];
+	for (int i = 0; i < properties.size(); i++) {
+		if (properties[i].name == p_property) {
+			properties.write[i].precision = p_precision;
+			return;
+		}
+	}
+	ERR_FAIL_COND_MSG(properties.size() >= SNAPSHOT_MAX_PROPERTIES, "Too many replicated properties on node, the maximum is " + itos(SNAPSHOT_MAX_PROPERTIES) + ".");
+
+	ReplicatedProperty property;
+	property.name = p_property;
+	property.precision = p_precision;
+	properties.push_back(property);
+}
+
+void MultiplayerAPI::remove_replicated_property(Object *p_node, const StringName &p_property) {
+	ERR_FAIL_NULL(p_node);
+	Map<ObjectID, Vector<ReplicatedProperty>>::Element *E = replicated_nodes.find(p_node->get_instance_id());
+	if (!E) {
+		return;
+	}
+	for (int i = 0; i < E->get().size(); i++) {
+		if (E->get()[i].name == p_property) {
+			E->get().remove(i);
+			break;
+		}
+	}
+	if (E->get().empty()) {
+		replicated_nodes.erase(E);
+	}
+}
+
+void MultiplayerAPI::remove_replicated_node(Object *p_node) {
+	ERR_FAIL_NULL(p_node);
+	replicated_nodes.erase(p_node->get_instance_id());
+}
+
+// Interest management: nodes added with add_interest_node() are bucketed in a grid by
+// their global position, and so are peers by the origin given to set_peer_interest_origin().
+// A node is relevant to the peers within `interest_radius` cells of it. Both sides are
+// updated incrementally, a node when it changes cells and a peer when its origin does.
+
+Vector3i MultiplayerAPI::_get_interest_cell(const Vector3 &p_position) const {
+	return Vector3i(Math::floor(p_position.x / interest_cell_size), Math::floor(p_position.y / interest_cell_size), Math::floor(p_position.z / interest_cell_size));
+}
+
+void MultiplayerAPI::_update_interest_node(const ObjectID &p_id, InterestNode &r_interest, Node *p_node) {
+	Vector3 position;
+	bool positioned = p_node->is_inside_tree() && p_node->get_network_interest_position(position);
+
+	Vector3i cell = positioned ? _get_interest_cell(position) : Vector3i();
+	if (positioned == r_interest.positioned && cell == r_interest.cell) {
+		return;
+	}
+
+	if (r_interest.positioned) {
+		Map<Vector3i, Set<ObjectID>>::Element *E = interest_nodes_by_cell.find(r_interest.cell);
+		if (E) {
+			E->get().erase(p_id);
+			if (E->get().empty()) {
+				interest_nodes_by_cell.erase(E);
+			}
+		}
+	}
+
+	r_interest.positioned = positioned;
+	r_interest.cell = cell;
+	r_interest.peers.clear();
+	r_interest.filtered.clear();
+
+	if (!positioned) {
+		return;
+	}
+
+	interest_nodes_by_cell[cell].insert(p_id);
+	for (int x = -interest_radius; x <= interest_radius; x++) {
+		for (int y = -interest_radius; y <= interest_radius; y++) {
+			for (int z = -interest_radius; z <= interest_radius; z++) {
+				Map<Vector3i, Set<int>>::Element *E = interest_peers_by_cell.find(cell + Vector3i(x, y, z));
+				if (!E) {
+					continue;
+				}
+				for (Set<int>::Element *F = E->get().front(); F; F = F->next()) {
+					r_interest.peers.insert(F->get());
+				}
+			}
+		}
+	}
+}
+
+void MultiplayerAPI::_update_interest_peer(int p_peer, const Vector3i *p_old_cell, const Vector3i *p_new_cell) {
+	// Only nodes around the old and new cells can change relevance for this peer.
+	if (p_old_cell) {
+		Map<Vector3i, Set<int>>::Element *E = interest_peers_by_cell.find(*p_old_cell);
+		if (E) {
+			E->get().erase(p_peer);
+			if (E->get().empty()) {
+				interest_peers_by_cell.erase(E);
+			}
+		}
+
+		for (int x = -interest_radius; x <= interest_radius; x++) {
+			for (int y = -interest_radius; y <= interest_radius; y++) {
+				for (int z = -interest_radius; z <= interest_radius; z++) {
+					Map<Vector3i, Set<ObjectID>>::Element *F = interest_nodes_by_cell.find(*p_old_cell + Vector3i(x, y, z));
+					if (!F) {
+						continue;
+					}
+					for (Set<ObjectID>::Element *G = F->get().front(); G; G = G->next()) {
+						InterestNode &interest = interest_nodes[G->get()];
+						interest.peers.erase(p_peer);
+						interest.filtered.erase(p_peer);
+					}
+				}
+			}
+		}
+	}
+
+	if (p_new_cell) {
+		interest_peers_by_cell[*p_new_cell].insert(p_peer);
+
+		for (int x = -interest_radius; x <= interest_radius; x++) {
+			for (int y = -interest_radius; y <= interest_radius; y++) {
+				for (int z = -interest_radius; z <= interest_radius; z++) {
+					Map<Vector3i, Set<ObjectID>>::Element *F = interest_nodes_by_cell.find(*p_new_cell + Vector3i(x, y, z));
+					if (!F) {
+						continue;
+					}
+					for (Set<ObjectID>::Element *G = F->get().front(); G; G = G->next()) {
+						InterestNode &interest = interest_nodes[G->get()];
+						interest.peers.insert(p_peer);
+						interest.filtered.erase(p_peer);
+					}
+				}
+			}
+		}
+	}
+}
+
+void MultiplayerAPI::_update_interest() {
+	List<ObjectID> freed;
+	for (Map<ObjectID, InterestNode>::Element *E = interest_nodes.front(); E; E = E->next()) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(E->key()));
+		if (!node) {
+			freed.push_back(E->key());
+			continue;
+		}
+		_update_interest_node(E->key(), E->get(), node);
+	}
+
+	for (List<ObjectID>::Element *E = freed.front(); E; E = E->next()) {
+		InterestNode &interest = interest_nodes[E->get()];
+		if (interest.positioned) {
+			interest_nodes_by_cell[interest.cell].erase(E->get());
+		}
+		interest_nodes.erase(E->get());
+	}
+}
+
+void MultiplayerAPI::_rebuild_interest() {
+	interest_nodes_by_cell.clear();
+	interest_peers_by_cell.clear();
+
+	for (Map<int, InterestPeer>::Element *E = interest_peers.front(); E; E = E->next()) {
+		E->get().cell = _get_interest_cell(E->get().origin);
+		interest_peers_by_cell[E->get().cell].insert(E->key());
+	}
+
+	for (Map<ObjectID, InterestNode>::Element *E = interest_nodes.front(); E; E = E->next()) {
+		E->get().positioned = false;
+		E->get().peers.clear();
+	}
+	_update_interest();
+}
+
+bool MultiplayerAPI::_is_relevant(Node *p_node, int p_peer) {
+	Map<ObjectID, InterestNode>::Element *E = interest_nodes.find(p_node->get_instance_id());
+	if (!E) {
+		return true; // Not interest managed.
+	}
+
+	// Peers without an origin see every node, only the filter can hide nodes from them.
+	if (E->get().positioned && interest_peers.has(p_peer) && !E->get().peers.has(p_peer)) {
+		return false;
+	}
+
+	if (!interest_filter.is_null()) {
+		Map<int, bool>::Element *F = E->get().filtered.find(p_peer);
+		if (F) {
+			return F->get();
+		}
+
+		Variant node = p_node;
+		Variant peer = p_peer;
+		const Variant *args[2] = { &node, &peer };
+		Variant ret;
+		Callable::CallError ce;
+		interest_filter.call(args, 2, ret, ce);
+		ERR_FAIL_COND_V_MSG(ce.error != Callable::CallError::CALL_OK, true, "Error calling the interest filter: " + Variant::get_callable_error_text(interest_filter, args, 2, ce) + ".");
+		bool relevant = ret.booleanize();
+		E->get().filtered[p_peer] = relevant;
+		return relevant;
+	}
+
+	return true;
+}
+
+void MultiplayerAPI::add_interest_node(Object *p_node) {
+	Node *node = Object::cast_to<Node>(p_node);
+	ERR_FAIL_COND_MSG(!node, "Only nodes can be interest managed.");
+	if (interest_nodes.has(node->get_instance_id())) {
+		return;
+	}
+	_update_interest_node(node->get_instance_id(), interest_nodes[node->get_instance_id()], node);
+}
+
+void MultiplayerAPI::remove_interest_node(Object *p_node) {
+	ERR_FAIL_NULL(p_node);
+	Map<ObjectID, InterestNode>::Element *E = interest_nodes.find(p_node->get_instance_id());
+	if (!E) {
+		return;
+	}
+	if (E->get().positioned) {
+		interest_nodes_by_cell[E->get().cell].erase(E->key());
+	}
+	interest_nodes.erase(E);
+}
+
+bool MultiplayerAPI::is_node_relevant_to_peer(Object *p_node, int p_peer) {
+	Node *node = Object::cast_to<Node>(p_node);
+	ERR_FAIL_COND_V(!node, false);
+	return _is_relevant(node, p_peer);
+}
+
+void MultiplayerAPI::set_peer_interest_origin(int p_peer, const Vector3 &p_origin) {
+	Vector3i cell = _get_interest_cell(p_origin);
+	Map<int, InterestPeer>::Element *E = interest_peers.find(p_peer);
+	if (E) {
+		E->get().origin = p_origin;
+		if (E->get().cell == cell) {
+			return;
+		}
+		Vector3i old_cell = E->get().cell;
+		E->get().cell = cell;
+		_update_interest_peer(p_peer, &old_cell, &cell);
+	} else {
+		InterestPeer peer;
+		peer.origin = p_origin;
+		peer.cell = cell;
+		interest_peers[p_peer] = peer;
+		_update_interest_peer(p_peer, nullptr, &cell);
+	}
+}
+
+void MultiplayerAPI::clear_peer_interest_origin(int p_peer) {
+	Map<int, InterestPeer>::Element *E = interest_peers.find(p_peer);
+	if (!E) {
+		return;
+	}
+	Vector3i old_cell = E->get().cell;
+	interest_peers.erase(E);
+	_update_interest_peer(p_peer, &old_cell, nullptr);
+}
+
+void MultiplayerAPI::set_interest_cell_size(real_t p_size) {
+	ERR_FAIL_COND_MSG(p_size <= 0, "Interest cell size must be greater than zero.");
+	interest_cell_size = p_size;
+	_rebuild_interest();
+}
+
+real_t MultiplayerAPI::get_interest_cell_size() const {
+	return interest_cell_size;
+}
+
+void MultiplayerAPI::set_interest_radius(int p_cells) {
+	ERR_FAIL_COND_MSG(p_cells < 0, "Interest radius can't be negative.");
+	interest_radius = p_cells;
+	_rebuild_interest();
+}
+
+int MultiplayerAPI::get_interest_radius() const {
+	return interest_radius;
+}
+
+void MultiplayerAPI::set_interest_filter(const Callable &p_filter) {
+	interest_filter = p_filter;
+	refresh_interest_filter();
+}
+
+Callable MultiplayerAPI::get_interest_filter() const {
+	return interest_filter;
+}
+
+void MultiplayerAPI::refresh_interest_filter() {
+	for (Map<ObjectID, InterestNode>::Element *E = interest_nodes.front(); E; E = E->next()) {
+		E->get().filtered.clear();
+	}
+}
+
+// Packet batching: when enabled, messages are queued per transfer mode and target peer, and
+// each queue is sent as a single framed packet at the end of poll(), or as soon as it would
+// grow past `packet_batch_size`. Messages bigger than that are sent on their own.
+
+Error MultiplayerAPI::_put_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_packet, int p_packet_len) {
+	if (!packet_batching) {
+		network_peer->set_target_peer(p_to);
+		network_peer->set_transfer_mode(p_mode);
+		return network_peer->put_packet(p_packet, p_packet_len);
+	}
+
+	ERR_FAIL_INDEX_V(p_mode, 3, ERR_INVALID_PARAMETER);
+	Map<int, PacketBatch> &batches = packet_batches[p_mode];
+
+	// Batches are sent in no particular order, so first flush the ones which could reach
+	// the same peers as this message. This keeps the order every peer receives them in.
+	// Broadcasts and exclusions (target <= 0) sort first.
+	Map<int, PacketBatch>::Element *E = batches.front();
+	while (E && (p_to <= 0 || E->key() <= 0)) {
+		Map<int, PacketBatch>::Element *N = E->next();
+		if (E->key() != p_to && E->key() != -p_to) {
+			_flush_packet_batch(p_mode, E, E->key());
+		}
+		E = N;
+	}
+
+	E = batches.find(p_to);
+	if (E && E->get().size + 2 + p_packet_len > packet_batch_size) {
+		_flush_packet_batch(p_mode, E, E->key());
+		E = nullptr;
+	}
+
+	if (3 + p_packet_len > packet_batch_size) {
+		// Too big to be batched.
+		network_peer->set_target_peer(p_to);
+		network_peer->set_transfer_mode(p_mode);
+		return network_peer->put_packet(p_packet, p_packet_len);
+	}
+
+	if (!E) {
+		E = batches.insert(p_to, PacketBatch());
+		E->get().data.resize(packet_batch_size);
+		E->get().data.write[0] = NETWORK_COMMAND_BATCH;
+		E->get().size = 1;
+	}
+
+	PacketBatch &batch = E->get();
+	uint8_t *w = batch.data.ptrw();
+	encode_uint16(p_packet_len, &w[batch.size]);
+	memcpy(&w[batch.size + 2], p_packet, p_packet_len);
+	batch.size += 2 + p_packet_len;
+	batch.count++;
+
+	return OK;
+}
+
+void MultiplayerAPI::_flush_packet_batch(NetworkedMultiplayerPeer::TransferMode p_mode, Map<int, PacketBatch>::Element *p_batch, int p_target) {
+	const PacketBatch &batch = p_batch->get();
+	network_peer->set_target_peer(p_target);
+	network_peer->set_transfer_mode(p_mode);
+	if (batch.count == 1) {
+		network_peer->put_packet(&batch.data[3], batch.size - 3); // A single message doesn't need the framing.
+	} else {
+		network_peer->put_packet(batch.data.ptr(), batch.size);
+	}
+	packet_batches[p_mode].erase(p_batch);
+}
+
+void MultiplayerAPI::_flush_packet_batches() {
+	for (int i = 0; i < 3; i++) {
+		while (packet_batches[i].front()) {
+			_flush_packet_batch(NetworkedMultiplayerPeer::TransferMode(i), packet_batches[i].front(), packet_batches[i].front()->key());
+		}
+	}
+}
+
+void MultiplayerAPI::set_packet_batching_enabled(bool p_enabled) {
+	if (packet_batching && !p_enabled && network_peer.is_valid()) {
+		_flush_packet_batches();
+	}
+	packet_batching = p_enabled;
+}
+
+bool MultiplayerAPI::is_packet_batching_enabled() const {
+	return packet_batching;
+}
+
+void MultiplayerAPI::set_packet_batch_size(int p_size) {
+	ERR_FAIL_COND_MSG(p_size < 64 || p_size > 65535, "Packet batch size must be between 64 and 65535 bytes.");
+	if (network_peer.is_valid()) {
+		_flush_packet_batches(); // Pending batches were allocated with the previous size.
+	}
+	packet_batch_size = p_size;
+}
+
+int MultiplayerAPI::get_packet_batch_size() const {
+	return packet_batch_size;
+}
+
 int MultiplayerAPI::get_network_unique_id() const {
 	ERR_FAIL_COND_V_MSG(!network_peer.is_valid(), 0, "No network peer is assigned. Unable to get unique network ID.");
 	return network_peer->get_unique_id();
@@ -1217,10 +2333,34 @@ void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_refusing_new_network_connections"), &MultiplayerAPI::is_refusing_new_network_connections);
 	ClassDB::bind_method(D_METHOD("set_allow_object_decoding", "enable"), &MultiplayerAPI::set_allow_object_decoding);
 	ClassDB::bind_method(D_METHOD("is_object_decoding_allowed"), &MultiplayerAPI::is_object_decoding_allowed);
+	ClassDB::bind_method(D_METHOD("add_replicated_property", "node", "property", "precision"), &MultiplayerAPI::add_replicated_property, DEFVAL(0.0));
+	ClassDB::bind_method(D_METHOD("remove_replicated_property", "node", "property"), &MultiplayerAPI::remove_replicated_property);
+	ClassDB::bind_method(D_METHOD("remove_replicated_node", "node"), &MultiplayerAPI::remove_replicated_node);
+	ClassDB::bind_method(D_METHOD("set_packet_batching_enabled", "enabled"), &MultiplayerAPI::set_packet_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_packet_batching_enabled"), &MultiplayerAPI::is_packet_batching_enabled);
+	ClassDB::bind_method(D_METHOD("set_packet_batch_size", "size"), &MultiplayerAPI::set_packet_batch_size);
+	ClassDB::bind_method(D_METHOD("get_packet_batch_size"), &MultiplayerAPI::get_packet_batch_size);
+	ClassDB::bind_method(D_METHOD("add_interest_node", "node"), &MultiplayerAPI::add_interest_node);
+	ClassDB::bind_method(D_METHOD("remove_interest_node", "node"), &MultiplayerAPI::remove_interest_node);
+	ClassDB::bind_method(D_METHOD("is_node_relevant_to_peer", "node", "peer"), &MultiplayerAPI::is_node_relevant_to_peer);
+	ClassDB::bind_method(D_METHOD("set_peer_interest_origin", "peer", "origin"), &MultiplayerAPI::set_peer_interest_origin);
+	ClassDB::bind_method(D_METHOD("clear_peer_interest_origin", "peer"), &MultiplayerAPI::clear_peer_interest_origin);
+	ClassDB::bind_method(D_METHOD("set_interest_cell_size", "size"), &MultiplayerAPI::set_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("get_interest_cell_size"), &MultiplayerAPI::get_interest_cell_size);
+	ClassDB::bind_method(D_METHOD("set_interest_radius", "cells"), &MultiplayerAPI::set_interest_radius);
+	ClassDB::bind_method(D_METHOD("get_interest_radius"), &MultiplayerAPI::get_interest_radius);
+	ClassDB::bind_method(D_METHOD("set_interest_filter", "filter"), &MultiplayerAPI::set_interest_filter);
+	ClassDB::bind_method(D_METHOD("get_interest_filter"), &MultiplayerAPI::get_interest_filter);
+	ClassDB::bind_method(D_METHOD("refresh_interest_filter"), &MultiplayerAPI::refresh_interest_filter);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_network_connections"), "set_refuse_new_network_connections", "is_refusing_new_network_connections");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "network_peer", PROPERTY_HINT_RESOURCE_TYPE, "NetworkedMultiplayerPeer", 0), "set_network_peer", "get_network_peer");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "packet_batching_enabled"), "set_packet_batching_enabled", "is_packet_batching_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "packet_batch_size", PROPERTY_HINT_RANGE, "64,65535,1"), "set_packet_batch_size", "get_packet_batch_size");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "interest_cell_size", PROPERTY_HINT_RANGE, "0.01,4096,0.01,or_greater"), "set_interest_cell_size", "get_interest_cell_size");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "interest_radius", PROPERTY_HINT_RANGE, "0,16,1,or_greater"), "set_interest_radius", "get_interest_radius");
+	ADD_PROPERTY(PropertyInfo(Variant::CALLABLE, "interest_filter"), "set_interest_filter", "get_interest_filter");
 	ADD_PROPERTY_DEFAULT("refuse_new_network_connections", false);
 
 	ADD_SIGNAL(MethodInfo("network_peer_connected", PropertyInfo(Variant::INT, "id")));
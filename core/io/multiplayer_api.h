@@ -34,14 +34,30 @@
 #include "core/io/networked_multiplayer_peer.h"
 #include "core/reference.h"
 
+class BitReader;
+class BitWriter;
+
 class MultiplayerAPI : public Reference {
 	GDCLASS(MultiplayerAPI, Reference);
 
-private:
+public:
+	// Declared type of a RPC argument, so it can be sent without the variant header.
+	// Integers, floats and vector components are packed in `bits` bits when non zero,
+	// floats and vectors quantized in the [min, max] range and integers offset by min.
+	struct RPCArgument {
+		Variant::Type type = Variant::NIL; // NIL accepts any type, with the regular encoding.
+		real_t min = 0.0;
+		real_t max = 0.0;
+		int bits = 0;
+	};
+
+protected:
 	//path sent caches
 	struct PathSentCache {
 		Map<int, bool> confirmed_peers;
 		int id;
+		NodePath path;
+		CharString path_utf8;
 	};
 
 	//path get caches
@@ -54,16 +70,87 @@ private:
 		Map<int, NodeInfo> nodes;
 	};
 
-	Ref<NetworkedMultiplayerPeer> network_peer;
-	int rpc_sender_id = 0;
-	Set<int> connected_peers;
 	HashMap<NodePath, PathSentCache> path_send_cache;
+	Vector<PathSentCache *> path_send_cache_by_id; // Index is the cache ID minus one.
+	uint32_t path_send_cache_epoch = 0; // Bumped whenever IDs remembered by nodes become invalid.
 	Map<int, PathGetCache> path_get_cache;
 	int last_send_cache_id;
+
+private:
+	//replication
+	struct ReplicatedProperty {
+		StringName name;
+		real_t precision = 0.0;
+	};
+
+	struct SnapshotNodeInfo {
+		NodePath path;
+		ObjectID instance;
+		Vector<StringName> properties;
+		Vector<uint8_t> types;
+		Vector<real_t> precisions;
+	};
+
+	typedef Map<int, Vector<Variant>> SnapshotState; // Values of each replicated node, by path cache ID.
+
+	struct PeerSnapshots {
+		Set<uint32_t> sent; // Sequences sent to the peer, their state is in `sent_snapshots`.
+		uint32_t acked = 0;
+		Map<int, uint32_t> relevant_since; // Sequence since which each node has been relevant to the peer.
+	};
+
+	//interest management
+	struct InterestNode {
+		bool positioned = false; // Nodes without a position stay relevant to every peer.
+		Vector3i cell;
+		Set<int> peers;
+		Map<int, bool> filtered; // Cached interest_filter results by peer, until the node or the peer changes cells.
+	};
+
+	struct InterestPeer {
+		Vector3 origin;
+		Vector3i cell;
+	};
+
+	//packet batching
+	struct PacketBatch {
+		Vector<uint8_t> data; // Allocated to the batch size up front, only the first `size` bytes are used.
+		int size = 0;
+		int count = 0;
+	};
+
+	enum {
+		SNAPSHOT_HISTORY_SIZE = 32,
+		SNAPSHOT_MAX_PROPERTIES = 32,
+	};
+
+	Ref<NetworkedMultiplayerPeer> network_peer;
+	int rpc_sender_id = 0;
+	Set<int> connected_peers;
 	Vector<uint8_t> packet_cache;
 	Node *root_node = nullptr;
 	bool allow_object_decoding = false;
 
+	Map<ObjectID, Vector<ReplicatedProperty>> replicated_nodes;
+	Map<int, PeerSnapshots> peer_snapshots;
+	Map<uint32_t, SnapshotState> sent_snapshots; // Shared by all peers, each only knows its relevant nodes.
+	uint32_t snapshot_sequence = 0;
+	Map<uint32_t, SnapshotState> received_snapshots;
+	uint32_t last_applied_snapshot = 0;
+	Map<int, SnapshotNodeInfo> snapshot_node_cache;
+
+	Map<ObjectID, InterestNode> interest_nodes;
+	Map<Vector3i, Set<ObjectID>> interest_nodes_by_cell;
+	Map<int, InterestPeer> interest_peers;
+	Map<Vector3i, Set<int>> interest_peers_by_cell;
+	real_t interest_cell_size = 64.0;
+	int interest_radius = 1;
+	Callable interest_filter;
+
+	Map<int, PacketBatch> packet_batches[3]; // By transfer mode, then target peer.
+	bool packet_batching = false;
+	int packet_batch_size = 1200;
+
 protected:
 	static void _bind_methods();
 
@@ -74,12 +161,33 @@ protected:
 	void _process_rpc(Node *p_node, const uint16_t p_rpc_method_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_rset(Node *p_node, const uint16_t p_rpc_property_id, int p_from, const uint8_t *p_packet, int p_packet_len, int p_offset);
 	void _process_raw(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_snapshot(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _process_snapshot_ack(int p_from, const uint8_t *p_packet, int p_packet_len);
+	void _send_snapshots();
+
+	Vector3i _get_interest_cell(const Vector3 &p_position) const;
+	void _update_interest_node(const ObjectID &p_id, InterestNode &r_interest, Node *p_node);
+	void _update_interest_peer(int p_peer, const Vector3i *p_old_cell, const Vector3i *p_new_cell);
+	void _update_interest();
+	void _rebuild_interest();
+	bool _is_relevant(Node *p_node, int p_peer);
+
+	Error _put_packet(int p_to, NetworkedMultiplayerPeer::TransferMode p_mode, const uint8_t *p_packet, int p_packet_len);
+	void _flush_packet_batch(NetworkedMultiplayerPeer::TransferMode p_mode, Map<int, PacketBatch>::Element *p_batch, int p_target);
+	void _flush_packet_batches();
+	void _process_batch(int p_from, const uint8_t *p_packet, int p_packet_len);
 
 	void _send_rpc(Node *p_from, int p_to, bool p_unreliable, bool p_set, const StringName &p_name, const Variant **p_arg, int p_argcount);
-	bool _send_confirm_path(Node *p_node, NodePath p_path, PathSentCache *psc, int p_target);
+	PathSentCache *_get_path_send_cache(Node *p_node);
+	PathSentCache *_get_path_send_cache(const NodePath &p_path);
+	bool _send_confirm_path(Node *p_node, PathSentCache *psc, int p_target);
 
 	Error _encode_and_compress_variant(const Variant &p_variant, uint8_t *p_buffer, int &r_len);
 	Error _decode_and_decompress_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len);
+	Error _encode_typed_argument(const Variant &p_value, const RPCArgument &p_argument, BitWriter &r_writer);
+	Error _decode_typed_argument(Variant &r_value, const RPCArgument &p_argument, BitReader &r_reader);
+	Error _encode_snapshot_value(const Variant &p_value, real_t p_precision, uint8_t *r_buffer, int &r_len);
+	Error _decode_snapshot_value(Variant &r_value, Variant::Type p_type, real_t p_precision, const uint8_t *p_buffer, int p_len, int *r_len);
 
 public:
 	enum NetworkCommands {
@@ -88,6 +196,9 @@ public:
 		NETWORK_COMMAND_SIMPLIFY_PATH,
 		NETWORK_COMMAND_CONFIRM_PATH,
 		NETWORK_COMMAND_RAW,
+		NETWORK_COMMAND_SNAPSHOT,
+		NETWORK_COMMAND_SNAPSHOT_ACK,
+		NETWORK_COMMAND_BATCH,
 	};
 
 	enum NetworkNodeIdCompression {
@@ -141,6 +252,28 @@ public:
 	void set_allow_object_decoding(bool p_enable);
 	bool is_object_decoding_allowed() const;
 
+	void add_replicated_property(Object *p_node, const StringName &p_property, real_t p_precision = 0.0);
+	void remove_replicated_property(Object *p_node, const StringName &p_property);
+	void remove_replicated_node(Object *p_node);
+
+	void set_packet_batching_enabled(bool p_enabled);
+	bool is_packet_batching_enabled() const;
+	void set_packet_batch_size(int p_size);
+	int get_packet_batch_size() const;
+
+	void add_interest_node(Object *p_node);
+	void remove_interest_node(Object *p_node);
+	bool is_node_relevant_to_peer(Object *p_node, int p_peer);
+	void set_peer_interest_origin(int p_peer, const Vector3 &p_origin);
+	void clear_peer_interest_origin(int p_peer);
+	void set_interest_cell_size(real_t p_size);
+	real_t get_interest_cell_size() const;
+	void set_interest_radius(int p_cells);
+	int get_interest_radius() const;
+	void set_interest_filter(const Callable &p_filter);
+	Callable get_interest_filter() const;
+	void refresh_interest_filter();
+
 	MultiplayerAPI();
 	~MultiplayerAPI();
 };
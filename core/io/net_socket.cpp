@@ -40,3 +40,85 @@ NetSocket *NetSocket::create() {
 	ERR_PRINT("Unable to create network socket, platform not supported");
 	return nullptr;
 }
+
+Error NetSocket::recvfrom_batch(Datagram *r_datagrams, int p_count, int &r_received) {
+	r_received = 0;
+	while (r_received < p_count) {
+		Datagram &dgram = r_datagrams[r_received];
+		Error err = recvfrom(dgram.buffer, dgram.capacity, dgram.size, dgram.ip, dgram.port);
+		if (err != OK) {
+			// Errors after the first datagram will be reported by the next call.
+			return r_received > 0 ? OK : err;
+		}
+		r_received++;
+	}
+	return OK;
+}
+
+Error NetSocket::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent) {
+	r_sent = 0;
+	while (r_sent < p_count) {
+		const Datagram &dgram = p_datagrams[r_sent];
+		int sent = 0;
+		Error err;
+		if (dgram.ip.is_valid()) {
+			err = sendto(dgram.buffer, dgram.size, sent, dgram.ip, dgram.port);
+		} else {
+			err = send(dgram.buffer, dgram.size, sent);
+		}
+		if (err != OK) {
+			return err;
+		}
+		r_sent++;
+	}
+	return OK;
+}
+
+NetSocketPoller *(*NetSocketPoller::_create)() = nullptr;
+
+NetSocketPoller *NetSocketPoller::create() {
+	if (_create) {
+		return _create();
+	}
+	return memnew(NetSocketPoller);
+}
+
+Error NetSocketPoller::add_socket(const Ref<NetSocket> &p_socket, int p_id, NetSocket::PollType p_type) {
+	ERR_FAIL_COND_V(p_socket.is_null() || !p_socket->is_open(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(sockets.has(p_id), ERR_ALREADY_EXISTS, "A socket with ID " + itos(p_id) + " is already being polled.");
+
+	Entry entry;
+	entry.socket = p_socket;
+	entry.type = p_type;
+	sockets.insert(p_id, entry);
+	return OK;
+}
+
+void NetSocketPoller::remove_socket(int p_id) {
+	sockets.erase(p_id);
+}
+
+void NetSocketPoller::clear() {
+	sockets.clear();
+}
+
+int NetSocketPoller::wait(Event *r_events, int p_max_events, int p_timeout) {
+	// No native way to wait on all of them, check each without blocking.
+	int count = 0;
+	for (Map<int, Entry>::Element *E = sockets.front(); E && count < p_max_events; E = E->next()) {
+		const Entry &entry = E->get();
+		if (!entry.socket->is_open()) {
+			continue;
+		}
+		Error err = entry.socket->poll(entry.type, 0);
+		if (err == ERR_BUSY) {
+			continue;
+		}
+		Event &event = r_events[count++];
+		event.id = E->key();
+		event.readable = err == OK && entry.type != NetSocket::POLL_TYPE_OUT;
+		event.writable = err == OK && entry.type != NetSocket::POLL_TYPE_IN;
+		event.error = err != OK;
+	}
+	return count;
+}
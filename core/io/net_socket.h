@@ -53,6 +53,18 @@ public:
 		TYPE_UDP,
 	};
 
+	// Used by the batched datagram functions. When receiving, up to capacity bytes are
+	// read into buffer, size is set to the datagram size and ip/port to the sender.
+	// When sending, size bytes from buffer are sent to ip/port, or to the connected
+	// host if ip is not valid.
+	struct Datagram {
+		uint8_t *buffer = nullptr;
+		int capacity = 0;
+		int size = 0;
+		IP_Address ip;
+		uint16_t port = 0;
+	};
+
 	virtual Error open(Type p_type, IP::Type &ip_type) = 0;
 	virtual void close() = 0;
 	virtual Error bind(IP_Address p_addr, uint16_t p_port) = 0;
@@ -65,8 +77,15 @@ public:
 	virtual Error sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP_Address p_ip, uint16_t p_port) = 0;
 	virtual Ref<NetSocket> accept(IP_Address &r_ip, uint16_t &r_port) = 0;
 
+	// Move many datagrams with as few system calls as the platform allows.
+	// recvfrom_batch returns OK if at least one datagram was received, ERR_BUSY if none was available.
+	// sendto_batch sets r_sent to the amount of datagrams sent, and returns ERR_BUSY if it could not send them all.
+	virtual Error recvfrom_batch(Datagram *r_datagrams, int p_count, int &r_received);
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent);
+
 	virtual bool is_open() const = 0;
 	virtual int get_available_bytes() const = 0;
+	virtual Error get_socket_address(IP_Address *r_ip, uint16_t *r_port) const = 0;
 
 	virtual Error set_broadcasting_enabled(bool p_enabled) = 0; // Returns OK if the socket option has been set successfully.
 	virtual void set_blocking_enabled(bool p_enabled) = 0;
@@ -77,4 +96,43 @@ public:
 	virtual Error leave_multicast_group(const IP_Address &p_multi_address, String p_if_name) = 0;
 };
 
+// Waits for readiness on many sockets with a single call, so the cost of polling depends
+// on how many sockets are active instead of how many are open. Sockets are identified by
+// an ID chosen by the caller. The default implementation polls each socket in turn,
+// platforms override it with a native mechanism where available.
+class NetSocketPoller : public Reference {
+public:
+	struct Event {
+		int id;
+		bool readable;
+		bool writable;
+		bool error;
+	};
+
+protected:
+	static NetSocketPoller *(*_create)();
+
+	struct Entry {
+		Ref<NetSocket> socket;
+		NetSocket::PollType type;
+	};
+
+	Map<int, Entry> sockets;
+
+public:
+	static NetSocketPoller *create();
+
+	virtual Error add_socket(const Ref<NetSocket> &p_socket, int p_id, NetSocket::PollType p_type = NetSocket::POLL_TYPE_IN);
+	virtual void remove_socket(int p_id);
+	virtual void clear();
+	bool has_socket(int p_id) const { return sockets.has(p_id); }
+	int get_socket_count() const { return sockets.size(); }
+
+	// Waits up to p_timeout msec (-1 to block) for sockets to be ready, and stores up to
+	// p_max_events of them in r_events. Returns the amount stored, or -1 on error.
+	virtual int wait(Event *r_events, int p_max_events, int p_timeout);
+
+	virtual ~NetSocketPoller() {}
+};
+
 #endif // NET_SOCKET_H
@@ -133,6 +133,10 @@ Error PacketPeerUDP::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 		_sock->set_broadcasting_enabled(broadcast);
 	}
 
+	if (udp_server && udp_server->is_send_batching_enabled()) {
+		return udp_server->queue_packet(peer_addr, peer_port, p_buffer, p_buffer_size);
+	}
+
 	do {
 		if (connected && !udp_server) {
 			err = _sock->send(p_buffer, p_buffer_size, sent);
@@ -254,6 +258,8 @@ void PacketPeerUDP::close() {
 		_sock->close();
 	}
 	rb.resize(16);
+	recv_buffer.clear();
+	recv_batch_size = 0;
 	queue_count = 0;
 	connected = false;
 }
@@ -263,6 +269,16 @@ Error PacketPeerUDP::wait() {
 	return _sock->poll(NetSocket::POLL_TYPE_IN, -1);
 }
 
+void PacketPeerUDP::_resize_recv_batch(int p_size) {
+	recv_buffer.resize(PACKET_BUFFER_SIZE * p_size);
+	uint8_t *buf = recv_buffer.ptrw();
+	for (int i = 0; i < p_size; i++) {
+		recv_batch[i].buffer = buf + i * PACKET_BUFFER_SIZE;
+		recv_batch[i].capacity = PACKET_BUFFER_SIZE;
+	}
+	recv_batch_size = p_size;
+}
+
 Error PacketPeerUDP::_poll() {
 	ERR_FAIL_COND_V(!_sock.is_valid(), ERR_UNAVAILABLE);
 
@@ -273,20 +289,14 @@ Error PacketPeerUDP::_poll() {
 		return OK; // Handled by UDPServer.
 	}
 
-	Error err;
-	int read;
-	IP_Address ip;
-	uint16_t port;
+	if (recv_batch_size == 0) {
+		_resize_recv_batch(1);
+	}
 
+	bool refill = false; // A previous call in this poll filled the whole batch.
 	while (true) {
-		if (connected) {
-			err = _sock->recv(recv_buffer, sizeof(recv_buffer), read);
-			ip = peer_addr;
-			port = peer_port;
-		} else {
-			err = _sock->recvfrom(recv_buffer, sizeof(recv_buffer), read, ip, port);
-		}
-
+		int received = 0;
+		Error err = _sock->recvfrom_batch(recv_batch, recv_batch_size, received);
 		if (err != OK) {
 			if (err == ERR_BUSY) {
 				break;
@@ -294,12 +304,29 @@ Error PacketPeerUDP::_poll() {
 			return FAILED;
 		}
 
-		err = store_packet(ip, port, recv_buffer, read);
+		for (int i = 0; i < received; i++) {
+			const NetSocket::Datagram &dgram = recv_batch[i];
+			if (connected) {
+				err = store_packet(peer_addr, peer_port, dgram.buffer, dgram.size);
+			} else {
+				err = store_packet(dgram.ip, dgram.port, dgram.buffer, dgram.size);
+			}
 #ifdef TOOLS_ENABLED
-		if (err != OK) {
-			WARN_PRINT("Buffer full, dropping packets!");
-		}
+			if (err != OK) {
+				WARN_PRINT("Buffer full, dropping packets!");
+			}
 #endif
+		}
+
+		bool full = received == recv_batch_size;
+		if (refill && recv_batch_size < RECV_BATCH_MAX) {
+			// Draining took more than one call, take more datagrams per call from now on.
+			_resize_recv_batch(MIN(recv_batch_size * 2, (int)RECV_BATCH_MAX));
+		}
+		if (!full) {
+			break; // Drained, no need to ask again.
+		}
+		refill = true;
 	}
 
 	return OK;
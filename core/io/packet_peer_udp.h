@@ -42,11 +42,14 @@ class PacketPeerUDP : public PacketPeer {
 
 protected:
 	enum {
-		PACKET_BUFFER_SIZE = 65536
+		PACKET_BUFFER_SIZE = 65536,
+		RECV_BATCH_MAX = 4,
 	};
 
 	RingBuffer<uint8_t> rb;
-	uint8_t recv_buffer[PACKET_BUFFER_SIZE];
+	Vector<uint8_t> recv_buffer; // recv_batch_size slots of PACKET_BUFFER_SIZE, one until bursts need more.
+	NetSocket::Datagram recv_batch[RECV_BATCH_MAX];
+	int recv_batch_size = 0;
 	uint8_t packet_buffer[PACKET_BUFFER_SIZE];
 	IP_Address packet_ip;
 	int packet_port = 0;
@@ -65,6 +68,7 @@ protected:
 	String _get_packet_ip() const;
 
 	Error _set_dest_address(const String &p_address, int p_port);
+	void _resize_recv_batch(int p_size);
 	Error _poll();
 
 public:
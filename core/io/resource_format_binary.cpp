@@ -81,18 +81,66 @@ enum {
 	VARIANT_VECTOR3I = 47,
 	VARIANT_INT64_ARRAY = 48,
 	VARIANT_FLOAT64_ARRAY = 49,
+	VARIANT_STRING_ARRAY_UTF8 = 50,
 	OBJECT_EMPTY = 0,
 	OBJECT_EXTERNAL_RESOURCE = 1,
 	OBJECT_INTERNAL_RESOURCE = 2,
 	OBJECT_EXTERNAL_RESOURCE_INDEX = 3,
 	//version 2: added 64 bits support for float and int
 	//version 3: changed nodepath encoding
-	FORMAT_VERSION = 3,
+	//version 4: string arrays stored as a length table plus a single utf8 blob
+	FORMAT_VERSION = 4,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
 
 };
 
+// Packed arrays are moved with a single buffer transfer. The file stores words in the endianness
+// given by its header, so a swap is only needed when that differs from the host.
+
+static _FORCE_INLINE_ bool _packed_needs_swap(const FileAccess *f) {
+#ifdef BIG_ENDIAN_ENABLED
+	return !f->get_endian_swap();
+#else
+	return f->get_endian_swap();
+#endif
+}
+
+static void _packed_swap_words(uint8_t *p_data, uint32_t p_count, uint32_t p_word_size) {
+	// Plain loops over contiguous words, simple enough for the compiler to vectorize.
+	if (p_word_size == 8) {
+		uint64_t *ptr = (uint64_t *)p_data;
+		for (uint32_t i = 0; i < p_count; i++) {
+			ptr[i] = BSWAP64(ptr[i]);
+		}
+	} else {
+		uint32_t *ptr = (uint32_t *)p_data;
+		for (uint32_t i = 0; i < p_count; i++) {
+			ptr[i] = BSWAP32(ptr[i]);
+		}
+	}
+}
+
+static void _packed_get_words(FileAccess *f, void *p_dst, uint32_t p_count, uint32_t p_word_size) {
+	f->get_buffer((uint8_t *)p_dst, p_count * p_word_size);
+	if (_packed_needs_swap(f)) {
+		_packed_swap_words((uint8_t *)p_dst, p_count, p_word_size);
+	}
+}
+
+static void _packed_store_words(FileAccess *f, const void *p_src, uint32_t p_count, uint32_t p_word_size) {
+	if (!_packed_needs_swap(f)) {
+		f->store_buffer((const uint8_t *)p_src, p_count * p_word_size);
+		return;
+	}
+
+	Vector<uint8_t> swapped;
+	swapped.resize(p_count * p_word_size);
+	memcpy(swapped.ptrw(), p_src, swapped.size());
+	_packed_swap_words(swapped.ptrw(), p_count, p_word_size);
+	f->store_buffer(swapped.ptr(), swapped.size());
+}
+
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	uint32_t extra = 4 - (p_len % 4);
 	if (extra < 4) {
@@ -440,17 +488,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 			Vector<int32_t> array;
 			array.resize(len);
-			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
-				}
-			}
-
-#endif
+			_packed_get_words(f, array.ptrw(), len, sizeof(int32_t));
 
 			r_v = array;
 		} break;
@@ -459,17 +497,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 			Vector<int64_t> array;
 			array.resize(len);
-			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint64_t *ptr = (uint64_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP64(ptr[i]);
-				}
-			}
-
-#endif
+			_packed_get_words(f, array.ptrw(), len, sizeof(int64_t));
 
 			r_v = array;
 		} break;
@@ -478,17 +506,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 			Vector<float> array;
 			array.resize(len);
-			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
-				}
-			}
-
-#endif
+			_packed_get_words(f, array.ptrw(), len, sizeof(float));
 
 			r_v = array;
 		} break;
@@ -497,17 +515,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 			Vector<double> array;
 			array.resize(len);
-			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
-#ifdef BIG_ENDIAN_ENABLED
-			{
-				uint64_t *ptr = (uint64_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP64(ptr[i]);
-				}
-			}
-
-#endif
+			_packed_get_words(f, array.ptrw(), len, sizeof(double));
 
 			r_v = array;
 		} break;
@@ -523,26 +531,49 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			r_v = array;
 
 		} break;
-		case VARIANT_VECTOR2_ARRAY: {
+		case VARIANT_STRING_ARRAY_UTF8: {
 			uint32_t len = f->get_32();
 
-			Vector<Vector2> array;
+			Vector<uint32_t> lengths;
+			lengths.resize(len);
+			_packed_get_words(f, lengths.ptrw(), len, sizeof(uint32_t));
+
+			uint64_t total = 0;
+			for (uint32_t i = 0; i < len; i++) {
+				total += lengths[i];
+			}
+			ERR_FAIL_COND_V_MSG(total > f->get_len(), ERR_FILE_CORRUPT, "String array is larger than the file.");
+
+			Vector<uint8_t> blob;
+			blob.resize(total);
+			if (total) {
+				f->get_buffer(blob.ptrw(), total);
+			}
+			_advance_padding(total);
+
+			Vector<String> array;
 			array.resize(len);
-			Vector2 *w = array.ptrw();
-			if (sizeof(Vector2) == 8) {
-				f->get_buffer((uint8_t *)w, len * sizeof(real_t) * 2);
-#ifdef BIG_ENDIAN_ENABLED
-				{
-					uint32_t *ptr = (uint32_t *)w.ptr();
-					for (int i = 0; i < len * 2; i++) {
-						ptr[i] = BSWAP32(ptr[i]);
-					}
+			String *w = array.ptrw();
+			const char *utf8 = (const char *)blob.ptr();
+			for (uint32_t i = 0; i < len; i++) {
+				if (lengths[i]) {
+					w[i].parse_utf8(utf8, lengths[i]);
+					utf8 += lengths[i];
 				}
+			}
 
-#endif
+			r_v = array;
+
+		} break;
+		case VARIANT_VECTOR2_ARRAY: {
+			uint32_t len = f->get_32();
 
+			Vector<Vector2> array;
+			array.resize(len);
+			if (sizeof(Vector2) == sizeof(real_t) * 2) {
+				_packed_get_words(f, array.ptrw(), len * 2, sizeof(real_t));
 			} else {
-				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Vector2 size is NOT 8!");
+				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Vector2 is not tightly packed!");
 			}
 
 			r_v = array;
@@ -553,21 +584,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 			Vector<Vector3> array;
 			array.resize(len);
-			Vector3 *w = array.ptrw();
-			if (sizeof(Vector3) == 12) {
-				f->get_buffer((uint8_t *)w, len * sizeof(real_t) * 3);
-#ifdef BIG_ENDIAN_ENABLED
-				{
-					uint32_t *ptr = (uint32_t *)w.ptr();
-					for (int i = 0; i < len * 3; i++) {
-						ptr[i] = BSWAP32(ptr[i]);
-					}
-				}
-
-#endif
-
+			if (sizeof(Vector3) == sizeof(real_t) * 3) {
+				_packed_get_words(f, array.ptrw(), len * 3, sizeof(real_t));
 			} else {
-				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Vector3 size is NOT 12!");
+				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Vector3 is not tightly packed!");
 			}
 
 			r_v = array;
@@ -578,21 +598,21 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 			Vector<Color> array;
 			array.resize(len);
-			Color *w = array.ptrw();
-			if (sizeof(Color) == 16) {
-				f->get_buffer((uint8_t *)w, len * sizeof(real_t) * 4);
-#ifdef BIG_ENDIAN_ENABLED
-				{
-					uint32_t *ptr = (uint32_t *)w.ptr();
-					for (int i = 0; i < len * 4; i++) {
-						ptr[i] = BSWAP32(ptr[i]);
-					}
-				}
-
-#endif
-
+			if (sizeof(Color) != sizeof(float) * 4) {
+				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Color is not tightly packed!");
+			}
+			// Components are saved as real_t, see write_variant().
+			if (sizeof(real_t) == sizeof(float)) {
+				_packed_get_words(f, array.ptrw(), len * 4, sizeof(float));
 			} else {
-				ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Color size is NOT 16!");
+				Vector<real_t> components;
+				components.resize(len * 4);
+				_packed_get_words(f, components.ptrw(), len * 4, sizeof(real_t));
+				float *w = (float *)array.ptrw();
+				const real_t *r = components.ptr();
+				for (uint32_t i = 0; i < len * 4; i++) {
+					w[i] = r[i];
+				}
 			}
 
 			r_v = array;
@@ -1545,10 +1565,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<int32_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const int32_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_32(r[i]);
-			}
+			_packed_store_words(f, arr.ptr(), len, sizeof(int32_t));
 
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
@@ -1556,10 +1573,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<int64_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const int64_t *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_64(r[i]);
-			}
+			_packed_store_words(f, arr.ptr(), len, sizeof(int64_t));
 
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
@@ -1567,10 +1581,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<float> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const float *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i]);
-			}
+			_packed_store_words(f, arr.ptr(), len, sizeof(float));
 
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
@@ -1578,21 +1589,39 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<double> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const double *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_double(r[i]);
-			}
+			_packed_store_words(f, arr.ptr(), len, sizeof(double));
 
 		} break;
 		case Variant::PACKED_STRING_ARRAY: {
-			f->store_32(VARIANT_STRING_ARRAY);
+			f->store_32(VARIANT_STRING_ARRAY_UTF8);
 			Vector<String> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
 			const String *r = arr.ptr();
+
+			Vector<CharString> utf8;
+			utf8.resize(len);
+			Vector<uint32_t> lengths;
+			lengths.resize(len);
+			uint32_t total = 0;
 			for (int i = 0; i < len; i++) {
-				save_unicode_string(f, r[i]);
+				utf8.write[i] = r[i].utf8();
+				lengths.write[i] = utf8[i].length();
+				total += lengths[i];
 			}
+			_packed_store_words(f, lengths.ptr(), len, sizeof(uint32_t));
+
+			Vector<uint8_t> blob;
+			blob.resize(total);
+			uint8_t *w = blob.ptrw();
+			for (int i = 0; i < len; i++) {
+				if (lengths[i]) {
+					memcpy(w, utf8[i].get_data(), lengths[i]);
+					w += lengths[i];
+				}
+			}
+			f->store_buffer(blob.ptr(), total);
+			_pad_buffer(f, total);
 
 		} break;
 		case Variant::PACKED_VECTOR3_ARRAY: {
@@ -1600,12 +1629,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<Vector3> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Vector3 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-				f->store_real(r[i].z);
-			}
+			_packed_store_words(f, arr.ptr(), len * 3, sizeof(real_t));
 
 		} break;
 		case Variant::PACKED_VECTOR2_ARRAY: {
@@ -1613,11 +1637,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<Vector2> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Vector2 *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].x);
-				f->store_real(r[i].y);
-			}
+			_packed_store_words(f, arr.ptr(), len * 2, sizeof(real_t));
 
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
@@ -1625,12 +1645,17 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			Vector<Color> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
-			const Color *r = arr.ptr();
-			for (int i = 0; i < len; i++) {
-				f->store_real(r[i].r);
-				f->store_real(r[i].g);
-				f->store_real(r[i].b);
-				f->store_real(r[i].a);
+			// Saved with store_real(), so the layout depends on the size of real_t.
+			if (sizeof(real_t) == sizeof(float)) {
+				_packed_store_words(f, arr.ptr(), len * 4, sizeof(float));
+			} else {
+				const Color *r = arr.ptr();
+				for (int i = 0; i < len; i++) {
+					f->store_real(r[i].r);
+					f->store_real(r[i].g);
+					f->store_real(r[i].b);
+					f->store_real(r[i].a);
+				}
 			}
 
 		} break;
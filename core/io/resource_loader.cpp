@@ -206,6 +206,23 @@ RES ResourceLoader::_load(const String &p_path, const String &p_original_path, c
 	ERR_FAIL_V_MSG(RES(), "No loader found for resource: " + p_path + ".");
 }
 
+uint64_t ResourceLoader::_get_soft_cache_cost(const String &p_remapped_path) {
+	// Approximated by the size of the file the resource is loaded from.
+	String path = p_remapped_path;
+	if (ResourceFormatImporter::get_singleton() && ResourceFormatImporter::get_singleton()->recognize_path(path)) {
+		path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(path);
+	}
+
+	FileAccess *f = FileAccess::open(path, FileAccess::READ);
+	if (!f) {
+		return 0;
+	}
+	uint64_t cost = f->get_len();
+	memdelete(f);
+
+	return cost;
+}
+
 void ResourceLoader::_thread_load_function(void *p_userdata) {
 	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
 	load_task.loader_id = Thread::get_caller_id();
@@ -216,6 +233,14 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	}
 	load_task.resource = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, false, &load_task.error, load_task.use_sub_threads, &load_task.progress);
 
+	if (load_task.resource.is_valid() && ResourceCache::is_soft_cache_enabled()) {
+		uint64_t cost;
+		if (!ResourceCache::_soft_cache_get_cost(load_task.local_path, &cost)) {
+			cost = _get_soft_cache_cost(load_task.remapped_path);
+		}
+		ResourceCache::_soft_cache_retain(load_task.local_path, load_task.resource, cost);
+	}
+
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
 
 	thread_load_mutex->lock();
@@ -551,6 +576,10 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 				}
 				thread_load_mutex->unlock();
 
+				if (ResourceCache::is_soft_cache_enabled()) {
+					ResourceCache::_soft_cache_touch(local_path, res);
+				}
+
 				if (r_error) {
 					*r_error = OK;
 				}
@@ -1030,6 +1059,166 @@ void ResourceLoader::set_load_callback(ResourceLoadedCallback p_callback) {
 
 ResourceLoadedCallback ResourceLoader::_loaded_callback = nullptr;
 
+void ResourceLoader::_load_manifest_file_opened(const String &p_path) {
+	// Only files resources are loaded from are worth replaying, not packs opened by absolute path.
+	if (!p_path.begins_with("res://") && !p_path.begins_with("user://")) {
+		return;
+	}
+
+	MutexLock mutex_lock(load_manifest_mutex);
+	if (!load_manifest_recording || load_manifest_recorded.has(p_path)) {
+		return;
+	}
+	// Files opened by a running prefetch are not part of the load being recorded.
+	if (load_manifest_prefetch_thread_ids.has(Thread::get_caller_id())) {
+		return;
+	}
+	load_manifest_recorded.insert(p_path);
+
+	LoadManifestEntry entry;
+	entry.path = p_path;
+	entry.usec = OS::get_singleton()->get_ticks_usec() - load_manifest_begin_usec;
+	load_manifest.push_back(entry);
+}
+
+void ResourceLoader::begin_load_manifest_recording() {
+	MutexLock mutex_lock(load_manifest_mutex);
+	load_manifest.clear();
+	load_manifest_recorded.clear();
+	load_manifest_begin_usec = OS::get_singleton()->get_ticks_usec();
+	load_manifest_recording = true;
+	FileAccess::set_file_open_notify_callback(_load_manifest_file_opened);
+}
+
+Error ResourceLoader::end_load_manifest_recording(const String &p_manifest_path) {
+	Vector<LoadManifestEntry> manifest;
+	{
+		MutexLock mutex_lock(load_manifest_mutex);
+		ERR_FAIL_COND_V_MSG(!load_manifest_recording, ERR_UNCONFIGURED, "Load manifest recording was not started.");
+		FileAccess::set_file_open_notify_callback(nullptr);
+		load_manifest_recording = false;
+		manifest = load_manifest;
+		load_manifest.clear();
+		load_manifest_recorded.clear();
+	}
+
+	Error err;
+	FileAccessRef f = FileAccess::open(p_manifest_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Cannot save load manifest '" + p_manifest_path + "'.");
+
+	// One line per file, in the order it was first opened, with the time since recording began.
+	// Replaying only uses the order for now, the timing is kept for profiling loads.
+	for (int i = 0; i < manifest.size(); i++) {
+		Vector<String> line;
+		line.push_back(manifest[i].path);
+		line.push_back(itos(manifest[i].usec));
+		f->store_csv_line(line);
+	}
+
+	return OK;
+}
+
+bool ResourceLoader::is_recording_load_manifest() {
+	MutexLock mutex_lock(load_manifest_mutex);
+	return load_manifest_recording;
+}
+
+void ResourceLoader::_load_manifest_prefetch_function(void *p_userdata) {
+	Thread::ID thread_id = Thread::get_caller_id();
+	{
+		MutexLock mutex_lock(load_manifest_mutex);
+		load_manifest_prefetch_thread_ids.insert(thread_id);
+	}
+
+	while (true) {
+		String path;
+		{
+			MutexLock mutex_lock(load_manifest_mutex);
+			if (load_manifest_prefetch_next >= load_manifest_prefetch_queue.size()) {
+				load_manifest_prefetch_thread_ids.erase(thread_id);
+				break;
+			}
+			path = load_manifest_prefetch_queue[load_manifest_prefetch_next++];
+		}
+
+		// Opening goes through PackedData, so files inside a pack only hint their own byte range.
+		FileAccess *f = FileAccess::open(path, FileAccess::READ);
+		if (f) {
+			f->prefetch();
+			memdelete(f);
+		}
+	}
+}
+
+void ResourceLoader::_load_manifest_prefetch_finish(bool p_abort) {
+	MutexLock prefetch_lock(load_manifest_prefetch_mutex);
+
+	if (p_abort) {
+		MutexLock mutex_lock(load_manifest_mutex);
+		load_manifest_prefetch_next = load_manifest_prefetch_queue.size();
+	}
+
+	for (int i = 0; i < load_manifest_prefetch_threads.size(); i++) {
+		Thread::wait_to_finish(load_manifest_prefetch_threads[i]);
+		memdelete(load_manifest_prefetch_threads[i]);
+	}
+	load_manifest_prefetch_threads.clear();
+
+	MutexLock mutex_lock(load_manifest_mutex);
+	load_manifest_prefetch_queue.clear();
+	load_manifest_prefetch_next = 0;
+}
+
+Error ResourceLoader::prefetch_load_manifest(const String &p_manifest_path) {
+	MutexLock prefetch_lock(load_manifest_prefetch_mutex);
+
+	// A previous prefetch is superseded by this one.
+	_load_manifest_prefetch_finish(true);
+
+	{
+		// Reading the manifest is not part of the load being recorded either.
+		MutexLock mutex_lock(load_manifest_mutex);
+		if (load_manifest_recording) {
+			load_manifest_recorded.insert(p_manifest_path);
+		}
+	}
+
+	Error err;
+	FileAccessRef f = FileAccess::open(p_manifest_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(!f, err, "Cannot open load manifest '" + p_manifest_path + "'.");
+
+	Vector<String> queue;
+	while (!f->eof_reached()) {
+		Vector<String> line = f->get_csv_line();
+		if (line.size() == 0 || line[0] == String()) {
+			continue;
+		}
+		queue.push_back(line[0]);
+	}
+
+	if (queue.empty()) {
+		return OK;
+	}
+
+	{
+		MutexLock mutex_lock(load_manifest_mutex);
+		load_manifest_prefetch_queue = queue;
+		load_manifest_prefetch_next = 0;
+	}
+
+	// Workers pull from the queue in recorded order, so the first files needed are hinted first.
+	int thread_count = MIN((int)LOAD_MANIFEST_PREFETCH_THREADS, queue.size());
+	for (int i = 0; i < thread_count; i++) {
+		load_manifest_prefetch_threads.push_back(Thread::create(_load_manifest_prefetch_function, nullptr));
+	}
+
+	return OK;
+}
+
+void ResourceLoader::wait_for_load_manifest_prefetch() {
+	_load_manifest_prefetch_finish(false);
+}
+
 Ref<ResourceFormatLoader> ResourceLoader::_find_custom_resource_format_loader(String path) {
 	for (int i = 0; i < loader_count; ++i) {
 		if (loader[i]->get_script_instance() && loader[i]->get_script_instance()->get_script()->get_path() == path) {
@@ -1113,6 +1302,7 @@ void ResourceLoader::initialize() {
 }
 
 void ResourceLoader::finalize() {
+	_load_manifest_prefetch_finish(true);
 	memdelete(thread_load_mutex);
 	memdelete(thread_load_semaphore);
 }
@@ -1135,6 +1325,17 @@ int ResourceLoader::thread_waiting_count = 0;
 int ResourceLoader::thread_suspended_count = 0;
 int ResourceLoader::thread_load_max = 0;
 
+Mutex ResourceLoader::load_manifest_mutex;
+Mutex ResourceLoader::load_manifest_prefetch_mutex;
+bool ResourceLoader::load_manifest_recording = false;
+uint64_t ResourceLoader::load_manifest_begin_usec = 0;
+Vector<ResourceLoader::LoadManifestEntry> ResourceLoader::load_manifest;
+Set<String> ResourceLoader::load_manifest_recorded;
+Vector<String> ResourceLoader::load_manifest_prefetch_queue;
+int ResourceLoader::load_manifest_prefetch_next = 0;
+Vector<Thread *> ResourceLoader::load_manifest_prefetch_threads;
+Set<Thread::ID> ResourceLoader::load_manifest_prefetch_thread_ids;
+
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
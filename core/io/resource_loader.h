@@ -125,6 +125,7 @@ private:
 	};
 
 	static void _thread_load_function(void *p_userdata);
+	static uint64_t _get_soft_cache_cost(const String &p_remapped_path);
 	static Mutex *thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
 	static Semaphore *thread_load_semaphore;
@@ -135,6 +136,30 @@ private:
 
 	static float _dependency_get_progress(const String &p_path);
 
+	enum {
+		LOAD_MANIFEST_PREFETCH_THREADS = 4
+	};
+
+	struct LoadManifestEntry {
+		String path;
+		uint64_t usec = 0;
+	};
+
+	static Mutex load_manifest_mutex; // Recording state and the prefetch queue.
+	static Mutex load_manifest_prefetch_mutex; // Starting and stopping prefetch threads.
+	static bool load_manifest_recording;
+	static uint64_t load_manifest_begin_usec;
+	static Vector<LoadManifestEntry> load_manifest;
+	static Set<String> load_manifest_recorded;
+	static Vector<String> load_manifest_prefetch_queue;
+	static int load_manifest_prefetch_next;
+	static Vector<Thread *> load_manifest_prefetch_threads;
+	static Set<Thread::ID> load_manifest_prefetch_thread_ids;
+
+	static void _load_manifest_file_opened(const String &p_path);
+	static void _load_manifest_prefetch_function(void *p_userdata);
+	static void _load_manifest_prefetch_finish(bool p_abort);
+
 public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, const String &p_source_resource = String());
 	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
@@ -191,6 +216,12 @@ public:
 	static void clear_translation_remaps();
 
 	static void set_load_callback(ResourceLoadedCallback p_callback);
+
+	static void begin_load_manifest_recording();
+	static Error end_load_manifest_recording(const String &p_manifest_path);
+	static bool is_recording_load_manifest();
+	static Error prefetch_load_manifest(const String &p_manifest_path);
+	static void wait_for_load_manifest_prefetch();
 	static ResourceLoaderImport import;
 
 	static bool add_custom_resource_format_loader(String script_path);
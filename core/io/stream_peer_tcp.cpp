@@ -273,6 +273,13 @@ Error StreamPeerTCP::poll(NetSocket::PollType p_type, int timeout) {
 	return _sock->poll(p_type, timeout);
 }
 
+Error StreamPeerTCP::add_to_poller(Ref<NetSocketPoller> p_poller, int p_id, NetSocket::PollType p_type) {
+	ERR_FAIL_COND_V(p_poller.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(_sock.is_null() || !_sock->is_open(), ERR_UNAVAILABLE);
+
+	return p_poller->add_socket(_sock, p_id, p_type);
+}
+
 Error StreamPeerTCP::put_data(const uint8_t *p_data, int p_bytes) {
 	int total;
 	return write(p_data, p_bytes, total, true);
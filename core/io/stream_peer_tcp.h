@@ -79,6 +79,7 @@ public:
 
 	// Poll functions (wait or check for writable, readable)
 	Error poll(NetSocket::PollType p_type, int timeout = 0);
+	Error add_to_poller(Ref<NetSocketPoller> p_poller, int p_id, NetSocket::PollType p_type = NetSocket::POLL_TYPE_IN);
 
 	// Read/Write from StreamPeer
 	Error put_data(const uint8_t *p_data, int p_bytes) override;
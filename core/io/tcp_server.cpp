@@ -110,6 +110,13 @@ Ref<StreamPeerTCP> TCP_Server::take_connection() {
 	return conn;
 }
 
+Error TCP_Server::add_to_poller(Ref<NetSocketPoller> p_poller, int p_id) {
+	ERR_FAIL_COND_V(p_poller.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!_sock.is_valid() || !_sock->is_open(), ERR_UNCONFIGURED);
+
+	return p_poller->add_socket(_sock, p_id, NetSocket::POLL_TYPE_IN);
+}
+
 void TCP_Server::stop() {
 	if (_sock.is_valid()) {
 		_sock->close();
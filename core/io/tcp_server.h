@@ -53,6 +53,9 @@ public:
 	bool is_connection_available() const;
 	Ref<StreamPeerTCP> take_connection();
 
+	// Registers the listening socket, it becomes readable when a connection is available.
+	Error add_to_poller(Ref<NetSocketPoller> p_poller, int p_id);
+
 	void stop(); // Stop listening
 
 	TCP_Server();
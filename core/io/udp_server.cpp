@@ -33,13 +33,27 @@
 void UDPServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("listen", "port", "bind_address"), &UDPServer::listen, DEFVAL("*"));
 	ClassDB::bind_method(D_METHOD("poll"), &UDPServer::poll);
+	ClassDB::bind_method(D_METHOD("get_local_port"), &UDPServer::get_local_port);
 	ClassDB::bind_method(D_METHOD("is_connection_available"), &UDPServer::is_connection_available);
 	ClassDB::bind_method(D_METHOD("is_listening"), &UDPServer::is_listening);
 	ClassDB::bind_method(D_METHOD("take_connection"), &UDPServer::take_connection);
 	ClassDB::bind_method(D_METHOD("stop"), &UDPServer::stop);
 	ClassDB::bind_method(D_METHOD("set_max_pending_connections", "max_pending_connections"), &UDPServer::set_max_pending_connections);
 	ClassDB::bind_method(D_METHOD("get_max_pending_connections"), &UDPServer::get_max_pending_connections);
+	ClassDB::bind_method(D_METHOD("set_send_batching_enabled", "enabled"), &UDPServer::set_send_batching_enabled);
+	ClassDB::bind_method(D_METHOD("is_send_batching_enabled"), &UDPServer::is_send_batching_enabled);
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_pending_connections", PROPERTY_HINT_RANGE, "0,256,1"), "set_max_pending_connections", "get_max_pending_connections");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "send_batching_enabled"), "set_send_batching_enabled", "is_send_batching_enabled");
+}
+
+void UDPServer::_resize_recv_batch(int p_size) {
+	recv_buffer.resize(PACKET_BUFFER_SIZE * p_size);
+	uint8_t *buf = recv_buffer.ptrw();
+	for (int i = 0; i < p_size; i++) {
+		recv_batch[i].buffer = buf + i * PACKET_BUFFER_SIZE;
+		recv_batch[i].capacity = PACKET_BUFFER_SIZE;
+	}
+	recv_batch_size = p_size;
 }
 
 Error UDPServer::poll() {
@@ -47,45 +61,152 @@ Error UDPServer::poll() {
 	if (!_sock->is_open()) {
 		return ERR_UNCONFIGURED;
 	}
-	Error err;
-	int read;
-	IP_Address ip;
-	uint16_t port;
+	// Receiving doesn't depend on sending, so a failed send is reported after draining.
+	Error send_err = _flush_send_queue();
+
+	if (recv_batch_size == 0) {
+		_resize_recv_batch(1);
+	}
+
+	bool refill = false; // A previous call in this poll filled the whole batch.
 	while (true) {
-		err = _sock->recvfrom(recv_buffer, sizeof(recv_buffer), read, ip, port);
+		int received = 0;
+		Error err = _sock->recvfrom_batch(recv_batch, recv_batch_size, received);
 		if (err != OK) {
 			if (err == ERR_BUSY) {
 				break;
 			}
 			return FAILED;
 		}
-		Peer p;
-		p.ip = ip;
-		p.port = port;
-		List<Peer>::Element *E = peers.find(p);
-		if (!E) {
-			E = pending.find(p);
-		}
-		if (E) {
-			E->get().peer->store_packet(ip, port, recv_buffer, read);
-		} else {
-			if (pending.size() >= max_pending_connections) {
-				// Drop connection.
-				continue;
+		for (int i = 0; i < received; i++) {
+			NetSocket::Datagram &dgram = recv_batch[i];
+			Peer p;
+			p.ip = dgram.ip;
+			p.port = dgram.port;
+			List<Peer>::Element *E = peers.find(p);
+			if (!E) {
+				E = pending.find(p);
 			}
-			// It's a new peer, add it to the pending list.
-			Peer peer;
-			peer.ip = ip;
-			peer.port = port;
-			peer.peer = memnew(PacketPeerUDP);
-			peer.peer->connect_shared_socket(_sock, ip, port, this);
-			peer.peer->store_packet(ip, port, recv_buffer, read);
-			pending.push_back(peer);
+			if (E) {
+				E->get().peer->store_packet(dgram.ip, dgram.port, dgram.buffer, dgram.size);
+			} else {
+				if (pending.size() >= max_pending_connections) {
+					// Drop connection.
+					continue;
+				}
+				// It's a new peer, add it to the pending list.
+				Peer peer;
+				peer.ip = dgram.ip;
+				peer.port = dgram.port;
+				peer.peer = memnew(PacketPeerUDP);
+				peer.peer->connect_shared_socket(_sock, dgram.ip, dgram.port, this);
+				peer.peer->store_packet(dgram.ip, dgram.port, dgram.buffer, dgram.size);
+				pending.push_back(peer);
+			}
+		}
+		bool full = received == recv_batch_size;
+		if (refill && recv_batch_size < RECV_BATCH_MAX) {
+			// Draining took more than one call, take more datagrams per call from now on.
+			_resize_recv_batch(MIN(recv_batch_size * 2, (int)RECV_BATCH_MAX));
 		}
+		if (!full) {
+			break; // Drained, no need to ask again.
+		}
+		refill = true;
+	}
+	return send_err == FAILED ? FAILED : OK;
+}
+
+Error UDPServer::_flush_send_queue() {
+	if (send_queue.empty()) {
+		return OK;
+	}
+
+	Vector<NetSocket::Datagram> dgrams;
+	dgrams.resize(send_queue.size());
+	NetSocket::Datagram *dw = dgrams.ptrw();
+	uint8_t *buf = send_buffer.ptrw();
+	for (int i = 0; i < send_queue.size(); i++) {
+		const QueuedPacket &qp = send_queue[i];
+		dw[i].buffer = buf + qp.offset;
+		dw[i].size = qp.size;
+		dw[i].ip = qp.ip;
+		dw[i].port = qp.port;
+	}
+
+	int sent = 0;
+	Error err = _sock->sendto_batch(dw, dgrams.size(), sent);
+	if (err == FAILED && sent < send_queue.size()) {
+		sent++; // Drop the datagram that failed, so it doesn't block the ones after it.
+	}
+	_drop_sent(err == OK ? send_queue.size() : sent);
+	return err;
+}
+
+void UDPServer::_drop_sent(int p_count) {
+	if (p_count >= send_queue.size()) {
+		send_queue.resize(0);
+		send_buffer_used = 0;
+		return;
 	}
+	if (p_count == 0) {
+		return;
+	}
+
+	// Keep the unsent tail at the front, so it goes out first on the next flush.
+	int offset = send_queue[p_count].offset;
+	uint8_t *buf = send_buffer.ptrw();
+	movemem(buf, buf + offset, send_buffer_used - offset);
+	send_buffer_used -= offset;
+
+	int remaining = send_queue.size() - p_count;
+	QueuedPacket *qw = send_queue.ptrw();
+	for (int i = 0; i < remaining; i++) {
+		qw[i] = qw[p_count + i];
+		qw[i].offset -= offset;
+	}
+	send_queue.resize(remaining);
+}
+
+Error UDPServer::queue_packet(const IP_Address &p_ip, uint16_t p_port, const uint8_t *p_buffer, int p_size) {
+	ERR_FAIL_COND_V(!_sock.is_valid() || !_sock->is_open(), ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V(p_size < 0 || p_size > PACKET_BUFFER_SIZE, ERR_INVALID_PARAMETER);
+
+	if (send_buffer_used + p_size > SEND_QUEUE_MAX_SIZE) {
+		Error err = _flush_send_queue();
+		if (err == FAILED) {
+			return err;
+		}
+		if (send_buffer_used + p_size > SEND_QUEUE_MAX_SIZE) {
+			return ERR_BUSY; // Like a full socket buffer, the caller can try again later.
+		}
+	}
+	if (send_buffer.size() < send_buffer_used + p_size) {
+		send_buffer.resize(next_power_of_2(send_buffer_used + p_size));
+	}
+	copymem(send_buffer.ptrw() + send_buffer_used, p_buffer, p_size);
+
+	QueuedPacket qp;
+	qp.ip = p_ip;
+	qp.port = p_port;
+	qp.offset = send_buffer_used;
+	qp.size = p_size;
+	send_queue.push_back(qp);
+	send_buffer_used += p_size;
 	return OK;
 }
 
+void UDPServer::set_send_batching_enabled(bool p_enabled) {
+	if (!p_enabled && _sock.is_valid() && _sock->is_open()) {
+		_flush_send_queue();
+	}
+	send_batching = p_enabled;
+}
+
+bool UDPServer::is_send_batching_enabled() const {
+	return send_batching;
+}
+
 Error UDPServer::listen(uint16_t p_port, const IP_Address &p_bind_address) {
 	ERR_FAIL_COND_V(!_sock.is_valid(), ERR_UNAVAILABLE);
 	ERR_FAIL_COND_V(_sock->is_open(), ERR_ALREADY_IN_USE);
@@ -114,9 +235,19 @@ Error UDPServer::listen(uint16_t p_port, const IP_Address &p_bind_address) {
 	}
 	bind_address = p_bind_address;
 	bind_port = p_port;
+	if (p_port == 0) {
+		// Picked by the system.
+		uint16_t local_port = 0;
+		_sock->get_socket_address(nullptr, &local_port);
+		bind_port = local_port;
+	}
 	return OK;
 }
 
+int UDPServer::get_local_port() const {
+	return bind_port;
+}
+
 bool UDPServer::is_listening() const {
 	ERR_FAIL_COND_V(!_sock.is_valid(), false);
 
@@ -174,8 +305,16 @@ void UDPServer::remove_peer(IP_Address p_ip, int p_port) {
 
 void UDPServer::stop() {
 	if (_sock.is_valid()) {
+		if (_sock->is_open()) {
+			_flush_send_queue();
+		}
 		_sock->close();
 	}
+	send_queue.clear();
+	send_buffer.clear();
+	send_buffer_used = 0;
+	recv_buffer.clear();
+	recv_batch_size = 0;
 	bind_port = 0;
 	bind_address = IP_Address();
 	List<Peer>::Element *E = peers.front();
@@ -39,7 +39,9 @@ class UDPServer : public Reference {
 
 protected:
 	enum {
-		PACKET_BUFFER_SIZE = 65536
+		PACKET_BUFFER_SIZE = 65536,
+		RECV_BATCH_MAX = 16,
+		SEND_QUEUE_MAX_SIZE = 1 << 18,
 	};
 
 	struct Peer {
@@ -51,7 +53,21 @@ protected:
 			return (ip == p_other.ip && port == p_other.port);
 		}
 	};
-	uint8_t recv_buffer[PACKET_BUFFER_SIZE];
+	struct QueuedPacket {
+		IP_Address ip;
+		uint16_t port = 0;
+		int offset = 0;
+		int size = 0;
+	};
+
+	Vector<uint8_t> recv_buffer; // recv_batch_size slots of PACKET_BUFFER_SIZE, one until bursts need more.
+	NetSocket::Datagram recv_batch[RECV_BATCH_MAX];
+	int recv_batch_size = 0;
+
+	bool send_batching = false;
+	Vector<uint8_t> send_buffer;
+	int send_buffer_used = 0;
+	Vector<QueuedPacket> send_queue;
 
 	int bind_port = 0;
 	IP_Address bind_address;
@@ -64,16 +80,25 @@ protected:
 
 	static void _bind_methods();
 
+	void _resize_recv_batch(int p_size);
+	Error _flush_send_queue();
+	void _drop_sent(int p_count);
+
 public:
 	void remove_peer(IP_Address p_ip, int p_port);
 	Error listen(uint16_t p_port, const IP_Address &p_bind_address = IP_Address("*"));
 	Error poll();
 	bool is_listening() const;
+	int get_local_port() const;
 	bool is_connection_available() const;
 	void set_max_pending_connections(int p_max);
 	int get_max_pending_connections() const;
 	Ref<PacketPeerUDP> take_connection();
 
+	void set_send_batching_enabled(bool p_enabled);
+	bool is_send_batching_enabled() const;
+	Error queue_packet(const IP_Address &p_ip, uint16_t p_port, const uint8_t *p_buffer, int p_size); // Used by PacketPeerUDP
+
 	void stop();
 
 	UDPServer();
@@ -39,6 +39,7 @@
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = { nullptr, nullptr };
 
 FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = nullptr;
+FileAccess::FileOpenNotify FileAccess::open_notify = nullptr;
 
 bool FileAccess::backup_save = false;
 
@@ -95,6 +96,9 @@ FileAccess *FileAccess::open(const String &p_path, int p_mode_flags, Error *r_er
 			if (r_error) {
 				*r_error = OK;
 			}
+			if (open_notify) {
+				open_notify(p_path);
+			}
 			return ret;
 		}
 	}
@@ -108,6 +112,8 @@ FileAccess *FileAccess::open(const String &p_path, int p_mode_flags, Error *r_er
 	if (err != OK) {
 		memdelete(ret);
 		ret = nullptr;
+	} else if (open_notify && !(p_mode_flags & WRITE)) {
+		open_notify(p_path);
 	}
 
 	return ret;
@@ -393,6 +399,40 @@ String FileAccess::get_as_utf8_string() const {
 	return s;
 }
 
+void FileAccess::prefetch(size_t p_offset, size_t p_length) {
+	// Generic fallback: read the range once so whatever sits below (OS page cache,
+	// network cache, etc.) has it ready, then restore the position.
+	size_t len = get_len();
+	if (p_offset >= len) {
+		return;
+	}
+	size_t end = p_length ? MIN(len, p_offset + p_length) : len;
+
+	size_t pos = get_position();
+	seek(p_offset);
+
+	uint8_t buf[4096];
+	size_t remaining = end - p_offset;
+	while (remaining > 0) {
+		int chunk = MIN(remaining, sizeof(buf));
+		if (get_buffer(buf, chunk) != chunk) {
+			break;
+		}
+		remaining -= chunk;
+	}
+
+	seek(pos);
+}
+
+int FileAccess::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, int p_length) {
+	// Generic fallback through the cursor, so it is not safe to mix with other reads on this file.
+	size_t pos = get_position();
+	seek(p_offset);
+	int read = get_buffer(p_dst, p_length);
+	seek(pos);
+	return read;
+}
+
 void FileAccess::store_16(uint16_t p_dest) {
 	uint8_t a, b;
 
@@ -50,6 +50,7 @@ public:
 	};
 
 	typedef void (*FileCloseFailNotify)(const String &);
+	typedef void (*FileOpenNotify)(const String &);
 
 	typedef FileAccess *(*CreateFunc)();
 	bool endian_swap = false;
@@ -64,6 +65,7 @@ protected:
 	virtual uint64_t _get_modified_time(const String &p_file) = 0;
 
 	static FileCloseFailNotify close_fail_notify;
+	static FileOpenNotify open_notify;
 
 private:
 	static bool backup_save;
@@ -77,6 +79,7 @@ private:
 
 public:
 	static void set_file_close_fail_notify_callback(FileCloseFailNotify p_cbk) { close_fail_notify = p_cbk; }
+	static void set_file_open_notify_callback(FileOpenNotify p_cbk) { open_notify = p_cbk; } ///< called with the path of every file successfully opened for reading
 
 	virtual void _set_access_type(AccessType p_access);
 
@@ -116,6 +119,11 @@ public:
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
 	virtual String get_as_utf8_string() const;
 
+	virtual void prefetch(size_t p_offset = 0, size_t p_length = 0); ///< hint that a range (the rest of the file if length is 0) will be read soon
+
+	virtual int get_buffer_at(uint64_t p_offset, uint8_t *p_dst, int p_length); ///< get an array of bytes at a given offset, leaving the position untouched
+	virtual bool has_concurrent_reads() const { return false; } ///< true when get_buffer_at() may run from several threads at once
+
 	/**< use this for files WRITTEN in _big_ endian machines (ie, amiga/mac)
 	 * It's not about the current CPU type but file formats.
 	 * this flags get reset to false (little endian) on each open
@@ -69,6 +69,9 @@ bool Reference::reference() {
 				}
 			}
 		}
+		if (rc_val == 2 && shared_reference_notify) {
+			_shared_reference_changed();
+		}
 	}
 
 	return success;
@@ -91,6 +94,9 @@ bool Reference::unreference() {
 				}
 			}
 		}
+		if (rc_val == 1 && shared_reference_notify) {
+			_shared_reference_changed();
+		}
 	}
 
 	return die;
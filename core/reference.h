@@ -43,6 +43,12 @@ class Reference : public Object {
 protected:
 	static void _bind_methods();
 
+	// Set by subclasses that need _shared_reference_changed(), so other references skip the call.
+	bool shared_reference_notify = false;
+
+	// Called when the reference count goes from one to two or from two to one.
+	virtual void _shared_reference_changed() {}
+
 public:
 	_FORCE_INLINE_ bool is_referenced() const { return refcount_init.get() != 1; }
 	bool init_ref();
@@ -43,6 +43,7 @@
 #include "core/input/input_map.h"
 #include "core/io/config_file.h"
 #include "core/io/dtls_server.h"
+#include "core/io/file_access_async.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/marshalls.h"
@@ -314,6 +315,7 @@ void unregister_core_types() {
 		memdelete(ip);
 	}
 
+	FileAccessAsync::finalize();
 	ResourceLoader::finalize();
 
 	ClassDB::cleanup_defaults();
@@ -34,6 +34,7 @@
 #include "core/io/resource_loader.h"
 #include "core/os/file_access.h"
 #include "core/os/os.h"
+#include "core/project_settings.h"
 #include "core/script_language.h"
 #include "scene/main/node.h" //only so casting works
 
@@ -89,6 +90,9 @@ void Resource::set_path(const String &p_path, bool p_take_over) {
 
 	_change_notify("resource_path");
 	_resource_path_changed();
+
+	// Last, as dropping the soft cache entry may release the final reference.
+	ResourceCache::_soft_cache_path_changed(this);
 }
 
 String Resource::get_path() const {
@@ -399,6 +403,10 @@ void Resource::_bind_methods() {
 	BIND_VMETHOD(MethodInfo("_setup_local_to_scene"));
 }
 
+void Resource::_shared_reference_changed() {
+	ResourceCache::_soft_cache_released_changed(this);
+}
+
 Resource::Resource() :
 		remapped_list(this) {}
 
@@ -423,6 +431,15 @@ RWLock *ResourceCache::lock = nullptr;
 RWLock *ResourceCache::path_cache_lock = nullptr;
 #endif
 
+Mutex ResourceCache::soft_cache_mutex;
+bool ResourceCache::soft_cache_enabled = false;
+uint64_t ResourceCache::soft_cache_budget[SOFT_CACHE_MAX] = {};
+uint64_t ResourceCache::soft_cache_usage[SOFT_CACHE_MAX] = {};
+SelfList<ResourceCache::SoftCacheEntry>::List ResourceCache::soft_cache_released[SOFT_CACHE_MAX];
+HashMap<String, ResourceCache::SoftCacheEntry *> ResourceCache::soft_cache;
+uint64_t ResourceCache::soft_cache_hits = 0;
+uint64_t ResourceCache::soft_cache_evictions = 0;
+
 void ResourceCache::setup() {
 	lock = RWLock::create();
 #ifdef TOOLS_ENABLED
@@ -431,6 +448,8 @@ void ResourceCache::setup() {
 }
 
 void ResourceCache::clear() {
+	clear_soft_cache();
+
 	if (resources.size()) {
 		ERR_PRINT("Resources still in use at exit (run with --verbose for details).");
 		if (OS::get_singleton()->is_stdout_verbose()) {
@@ -492,6 +511,226 @@ int ResourceCache::get_cached_resource_count() {
 	return rc;
 }
 
+ResourceCache::SoftCacheCategory ResourceCache::_get_soft_cache_category(const Ref<Resource> &p_resource) {
+	const StringName &class_name = p_resource->get_class_name();
+	if (ClassDB::is_parent_class(class_name, "Texture")) {
+		return SOFT_CACHE_TEXTURES;
+	} else if (ClassDB::is_parent_class(class_name, "Mesh")) {
+		return SOFT_CACHE_MESHES;
+	} else if (ClassDB::is_parent_class(class_name, "AudioStream")) {
+		return SOFT_CACHE_AUDIO;
+	} else if (ClassDB::is_parent_class(class_name, "Script")) {
+		return SOFT_CACHE_SCRIPTS;
+	}
+	return SOFT_CACHE_OTHER;
+}
+
+void ResourceCache::_soft_cache_update(SoftCacheEntry *p_entry) {
+	// Only entries nobody else references are released; in-use ones are just tracked.
+	bool released = p_entry->resource->reference_get_count() == 1;
+	if (released == p_entry->released_list.in_list()) {
+		return;
+	}
+
+	if (released) {
+		soft_cache_released[p_entry->category].add_last(&p_entry->released_list);
+		soft_cache_usage[p_entry->category] += p_entry->cost;
+	} else {
+		soft_cache_released[p_entry->category].remove(&p_entry->released_list);
+		soft_cache_usage[p_entry->category] -= p_entry->cost;
+	}
+}
+
+void ResourceCache::_soft_cache_erase(SoftCacheEntry *p_entry, List<Ref<Resource>> *r_evicted) {
+	if (p_entry->released_list.in_list()) {
+		soft_cache_released[p_entry->category].remove(&p_entry->released_list);
+		soft_cache_usage[p_entry->category] -= p_entry->cost;
+	}
+
+	// Cleared first, so the reference changes below don't call back into the cache.
+	p_entry->resource->shared_reference_notify = false;
+	p_entry->resource->soft_cache_path = String();
+	// The resource is freed by the caller, outside of the lock.
+	r_evicted->push_back(p_entry->resource);
+	soft_cache.erase(p_entry->path);
+	memdelete(p_entry);
+}
+
+void ResourceCache::_soft_cache_trim(SoftCacheCategory p_category, List<Ref<Resource>> *r_evicted) {
+	while (soft_cache_usage[p_category] > soft_cache_budget[p_category] && soft_cache_released[p_category].first()) {
+		_soft_cache_erase(soft_cache_released[p_category].first()->self(), r_evicted);
+		soft_cache_evictions++;
+	}
+}
+
+void ResourceCache::_soft_cache_released_changed(Resource *p_resource) {
+	List<Ref<Resource>> evicted;
+
+	soft_cache_mutex.lock();
+	SoftCacheEntry **E = p_resource->soft_cache_path.empty() ? nullptr : soft_cache.getptr(p_resource->soft_cache_path);
+	if (E && (*E)->resource.ptr() == p_resource) {
+		SoftCacheCategory category = (*E)->category;
+		_soft_cache_update(*E);
+		_soft_cache_trim(category, &evicted);
+	}
+	soft_cache_mutex.unlock();
+}
+
+void ResourceCache::_soft_cache_path_changed(Resource *p_resource) {
+	List<Ref<Resource>> evicted;
+
+	soft_cache_mutex.lock();
+	SoftCacheEntry **E = p_resource->soft_cache_path.empty() ? nullptr : soft_cache.getptr(p_resource->soft_cache_path);
+	if (E && (*E)->resource.ptr() == p_resource && (*E)->path != p_resource->get_path()) {
+		SoftCacheEntry *entry = *E;
+		const String &new_path = p_resource->get_path();
+		if (new_path.empty()) {
+			// Can't be loaded from anywhere anymore.
+			_soft_cache_erase(entry, &evicted);
+		} else {
+			// Follow the rename, replacing whatever was cached for the new path.
+			SoftCacheEntry **existing = soft_cache.getptr(new_path);
+			if (existing) {
+				_soft_cache_erase(*existing, &evicted);
+			}
+			soft_cache.erase(entry->path);
+			entry->path = new_path;
+			p_resource->soft_cache_path = new_path;
+			soft_cache[new_path] = entry;
+		}
+	}
+	soft_cache_mutex.unlock();
+}
+
+bool ResourceCache::_soft_cache_get_cost(const String &p_path, uint64_t *r_cost) {
+	MutexLock mutex_lock(soft_cache_mutex);
+
+	SoftCacheEntry **E = soft_cache.getptr(p_path);
+	if (!E) {
+		return false;
+	}
+	*r_cost = (*E)->cost;
+	return true;
+}
+
+void ResourceCache::_soft_cache_retain(const String &p_path, const Ref<Resource> &p_resource, uint64_t p_cost) {
+	List<Ref<Resource>> evicted;
+
+	soft_cache_mutex.lock();
+	if (soft_cache_enabled) {
+		SoftCacheEntry **E = soft_cache.getptr(p_path);
+		if (E && (*E)->resource != p_resource) {
+			// Loaded again while the cached one was replaced, drop the stale entry.
+			_soft_cache_erase(*E, &evicted);
+			E = nullptr;
+		}
+
+		if (!E) {
+			SoftCacheEntry *entry = memnew(SoftCacheEntry);
+			entry->path = p_path;
+			entry->resource = p_resource;
+			entry->cost = p_cost;
+			entry->category = _get_soft_cache_category(p_resource);
+			entry->resource->shared_reference_notify = true;
+			entry->resource->soft_cache_path = p_path;
+			soft_cache[p_path] = entry;
+
+			_soft_cache_update(entry);
+			_soft_cache_trim(entry->category, &evicted);
+		}
+	}
+	soft_cache_mutex.unlock();
+}
+
+void ResourceCache::_soft_cache_touch(const String &p_path, const Ref<Resource> &p_resource) {
+	MutexLock mutex_lock(soft_cache_mutex);
+
+	SoftCacheEntry **E = soft_cache.getptr(p_path);
+	if (!E || (*E)->resource != p_resource) {
+		return;
+	}
+
+	// Referenced only by the cache and the caller, so it would have been loaded again without it.
+	if (p_resource->reference_get_count() == 2) {
+		soft_cache_hits++;
+	}
+}
+
+void ResourceCache::setup_soft_cache(bool p_enabled) {
+	static const char *budget_settings[SOFT_CACHE_MAX] = {
+		"memory/limits/resource_soft_cache/textures_kb",
+		"memory/limits/resource_soft_cache/meshes_kb",
+		"memory/limits/resource_soft_cache/audio_kb",
+		"memory/limits/resource_soft_cache/scripts_kb",
+		"memory/limits/resource_soft_cache/other_kb",
+	};
+
+	for (int i = 0; i < SOFT_CACHE_MAX; i++) {
+		int budget_kb = GLOBAL_DEF(budget_settings[i], 0);
+		ProjectSettings::get_singleton()->set_custom_property_info(budget_settings[i], PropertyInfo(Variant::INT, budget_settings[i], PROPERTY_HINT_RANGE, "0,65536,1,or_greater"));
+		set_soft_cache_budget(SoftCacheCategory(i), p_enabled ? uint64_t(MAX(budget_kb, 0)) * 1024 : 0);
+	}
+}
+
+void ResourceCache::set_soft_cache_budget(SoftCacheCategory p_category, uint64_t p_bytes) {
+	ERR_FAIL_INDEX(p_category, SOFT_CACHE_MAX);
+
+	soft_cache_mutex.lock();
+	soft_cache_budget[p_category] = p_bytes;
+
+	soft_cache_enabled = false;
+	for (int i = 0; i < SOFT_CACHE_MAX; i++) {
+		if (soft_cache_budget[i] > 0) {
+			soft_cache_enabled = true;
+		}
+	}
+	soft_cache_mutex.unlock();
+
+	if (soft_cache_enabled) {
+		List<Ref<Resource>> evicted;
+		MutexLock mutex_lock(soft_cache_mutex);
+		_soft_cache_trim(p_category, &evicted);
+	} else {
+		clear_soft_cache();
+	}
+}
+
+uint64_t ResourceCache::get_soft_cache_budget(SoftCacheCategory p_category) {
+	ERR_FAIL_INDEX_V(p_category, SOFT_CACHE_MAX, 0);
+	MutexLock mutex_lock(soft_cache_mutex);
+	return soft_cache_budget[p_category];
+}
+
+void ResourceCache::clear_soft_cache() {
+	List<Ref<Resource>> evicted;
+
+	soft_cache_mutex.lock();
+	while (soft_cache.size()) {
+		_soft_cache_erase(soft_cache.get(*soft_cache.next(nullptr)), &evicted);
+	}
+	soft_cache_mutex.unlock();
+}
+
+uint64_t ResourceCache::get_soft_cache_usage() {
+	MutexLock mutex_lock(soft_cache_mutex);
+
+	uint64_t usage = 0;
+	for (int i = 0; i < SOFT_CACHE_MAX; i++) {
+		usage += soft_cache_usage[i];
+	}
+	return usage;
+}
+
+uint64_t ResourceCache::get_soft_cache_hits() {
+	MutexLock mutex_lock(soft_cache_mutex);
+	return soft_cache_hits;
+}
+
+uint64_t ResourceCache::get_soft_cache_evictions() {
+	MutexLock mutex_lock(soft_cache_mutex);
+	return soft_cache_evictions;
+}
+
 void ResourceCache::dump(const char *p_file, bool p_short) {
 #ifdef DEBUG_ENABLED
 	lock->read_lock();
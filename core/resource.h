@@ -32,7 +32,9 @@
 #define RESOURCE_H
 
 #include "core/class_db.h"
+#include "core/list.h"
 #include "core/object.h"
+#include "core/os/mutex.h"
 #include "core/reference.h"
 #include "core/safe_refcount.h"
 #include "core/self_list.h"
@@ -76,9 +78,13 @@ private:
 
 	SelfList<Resource> remapped_list;
 
+	String soft_cache_path; // Key of the soft cache entry holding this resource, if any.
+
 protected:
 	void emit_changed();
 
+	virtual void _shared_reference_changed() override;
+
 	void notify_change_to_owners();
 
 	virtual void _resource_path_changed();
@@ -148,6 +154,17 @@ public:
 typedef Ref<Resource> RES;
 
 class ResourceCache {
+public:
+	enum SoftCacheCategory {
+		SOFT_CACHE_TEXTURES,
+		SOFT_CACHE_MESHES,
+		SOFT_CACHE_AUDIO,
+		SOFT_CACHE_SCRIPTS,
+		SOFT_CACHE_OTHER,
+		SOFT_CACHE_MAX
+	};
+
+private:
 	friend class Resource;
 	friend class ResourceLoader; //need the lock
 	static RWLock *lock;
@@ -156,6 +173,37 @@ class ResourceCache {
 	static HashMap<String, HashMap<String, int>> resource_path_cache; // each tscn has a set of resource paths and IDs
 	static RWLock *path_cache_lock;
 #endif // TOOLS_ENABLED
+
+	// Soft cache: keeps loaded resources alive after their last user releases them, so they
+	// don't need to be loaded again. Entries only held by the cache count towards the budget
+	// of their category and are evicted in the order they were released.
+	struct SoftCacheEntry {
+		String path;
+		Ref<Resource> resource;
+		uint64_t cost = 0;
+		SoftCacheCategory category = SOFT_CACHE_OTHER;
+		SelfList<SoftCacheEntry> released_list;
+
+		SoftCacheEntry() :
+				released_list(this) {}
+	};
+
+	static Mutex soft_cache_mutex;
+	static bool soft_cache_enabled;
+	static uint64_t soft_cache_budget[SOFT_CACHE_MAX];
+	static uint64_t soft_cache_usage[SOFT_CACHE_MAX]; // Cost of the released entries.
+	static SelfList<SoftCacheEntry>::List soft_cache_released[SOFT_CACHE_MAX]; // Least recently released first.
+	static HashMap<String, SoftCacheEntry *> soft_cache;
+	static uint64_t soft_cache_hits;
+	static uint64_t soft_cache_evictions;
+
+	static SoftCacheCategory _get_soft_cache_category(const Ref<Resource> &p_resource);
+	static void _soft_cache_update(SoftCacheEntry *p_entry);
+	static void _soft_cache_erase(SoftCacheEntry *p_entry, List<Ref<Resource>> *r_evicted);
+	static void _soft_cache_trim(SoftCacheCategory p_category, List<Ref<Resource>> *r_evicted);
+	static void _soft_cache_released_changed(Resource *p_resource);
+	static void _soft_cache_path_changed(Resource *p_resource);
+
 	friend void unregister_core_types();
 	static void clear();
 	friend void register_core_types();
@@ -168,6 +216,20 @@ public:
 	static void dump(const char *p_file = nullptr, bool p_short = false);
 	static void get_cached_resources(List<Ref<Resource>> *p_resources);
 	static int get_cached_resource_count();
+
+	static void setup_soft_cache(bool p_enabled);
+	static void set_soft_cache_budget(SoftCacheCategory p_category, uint64_t p_bytes);
+	static uint64_t get_soft_cache_budget(SoftCacheCategory p_category);
+	static bool is_soft_cache_enabled() { return soft_cache_enabled; }
+	static void clear_soft_cache();
+	static uint64_t get_soft_cache_usage();
+	static uint64_t get_soft_cache_hits();
+	static uint64_t get_soft_cache_evictions();
+
+	// Used by ResourceLoader, which only measures the cost of resources not cached yet.
+	static bool _soft_cache_get_cost(const String &p_path, uint64_t *r_cost);
+	static void _soft_cache_retain(const String &p_path, const Ref<Resource> &p_resource, uint64_t p_cost);
+	static void _soft_cache_touch(const String &p_path, const Ref<Resource> &p_resource);
 };
 
 #endif // RESOURCE_H
@@ -35,39 +35,81 @@
 #include "core/os/keyboard.h"
 #include "core/string_buffer.h"
 
-char32_t VariantParser::StreamFile::get_char() {
-	return f->get_8();
+char32_t VariantParser::Stream::_refill_readahead() {
+	readahead_pointer = 0;
+	if (readahead_enabled && readahead_buffer) {
+		current_buffer = readahead_buffer;
+		readahead_filled = _read_buffer(readahead_buffer, readahead_size);
+	} else {
+		current_buffer = &single_char;
+		readahead_filled = _read_buffer(&single_char, 1);
+	}
+	if (readahead_filled == 0) {
+		eof = true;
+		return 0;
+	}
+
+	return current_buffer[readahead_pointer++];
 }
 
-bool VariantParser::StreamFile::is_utf8() const {
-	return true;
+bool VariantParser::Stream::is_eof() const {
+	if (readahead_enabled && readahead_buffer) {
+		return eof;
+	}
+	return _is_eof();
+}
+
+uint32_t VariantParser::StreamFile::_read_buffer(char32_t *p_buffer, uint32_t p_num_chars) {
+	if (p_num_chars == 1) {
+		// Unbuffered, keep the file position in sync with the parser.
+		p_buffer[0] = f->get_8();
+		return f->eof_reached() ? 0 : 1;
+	}
+
+	int num_read = f->get_buffer(read_storage, MIN(p_num_chars, uint32_t(READAHEAD_SIZE)));
+	ERR_FAIL_COND_V(num_read < 0, 0);
+
+	for (int i = 0; i < num_read; i++) {
+		p_buffer[i] = read_storage[i];
+	}
+
+	return num_read;
 }
 
-bool VariantParser::StreamFile::is_eof() const {
+bool VariantParser::StreamFile::_is_eof() const {
 	return f->eof_reached();
 }
 
-char32_t VariantParser::StreamString::get_char() {
+bool VariantParser::StreamFile::is_utf8() const {
+	return true;
+}
+
+uint32_t VariantParser::StreamString::_read_buffer(char32_t *p_buffer, uint32_t p_num_chars) {
 	if (pos > s.length()) {
 		return 0;
 	} else if (pos == s.length()) {
 		// You need to try to read again when you have reached the end for EOF to be reported,
 		// so this works the same as files (like StreamFile does)
 		pos++;
-		return 0;
-	} else {
-		return s[pos++];
+		p_buffer[0] = 0;
+		return 1;
 	}
-}
 
-bool VariantParser::StreamString::is_utf8() const {
-	return false;
+	uint32_t num_read = MIN(p_num_chars, uint32_t(s.length() - pos));
+	memcpy(p_buffer, s.ptr() + pos, num_read * sizeof(char32_t));
+	pos += num_read;
+
+	return num_read;
 }
 
-bool VariantParser::StreamString::is_eof() const {
+bool VariantParser::StreamString::_is_eof() const {
 	return pos > s.length();
 }
 
+bool VariantParser::StreamString::is_utf8() const {
+	return false;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 const char *VariantParser::tk_name[TK_MAX] = {
@@ -90,6 +132,102 @@ const char *VariantParser::tk_name[TK_MAX] = {
 	"ERROR"
 };
 
+bool VariantParser::_parse_number(Stream *p_stream, char32_t p_first, double &r_float, int64_t &r_int) {
+	char32_t cchar = p_first;
+	StringBuffer<> num;
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+	int reading = READING_INT;
+
+	if (cchar == '-') {
+		num += '-';
+		cchar = p_stream->get_char();
+	}
+
+	char32_t c = cchar;
+	bool exp_sign = false;
+	bool exp_beg = false;
+	bool is_float = false;
+
+	while (true) {
+		switch (reading) {
+			case READING_INT: {
+				if (c >= '0' && c <= '9') {
+					//pass
+				} else if (c == '.') {
+					reading = READING_DEC;
+					is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+				if (c >= '0' && c <= '9') {
+				} else if (c == 'e') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+				if (c >= '0' && c <= '9') {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE) {
+			break;
+		}
+		num += c;
+		c = p_stream->get_char();
+	}
+
+	p_stream->saved = c;
+
+	if (is_float) {
+		r_float = num.as_double();
+	} else {
+		r_int = num.as_int();
+	}
+	return is_float;
+}
+
+char32_t VariantParser::_skip_whitespace(Stream *p_stream, int &line) {
+	while (true) {
+		char32_t c;
+		if (p_stream->saved) {
+			c = p_stream->saved;
+			p_stream->saved = 0;
+		} else {
+			c = p_stream->get_char();
+			if (p_stream->is_eof()) {
+				return 0;
+			}
+		}
+
+		if (c == '\n') {
+			line++;
+		} else if (c == 0 || c > 32) {
+			return c;
+		}
+	}
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 	bool string_name = false;
 
@@ -307,78 +445,14 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 
 				if (cchar == '-' || (cchar >= '0' && cchar <= '9')) {
 					//a number
-
-					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					char32_t c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
-					bool is_float = false;
-
-					while (true) {
-						switch (reading) {
-							case READING_INT: {
-								if (c >= '0' && c <= '9') {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-								if (c >= '0' && c <= '9') {
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-								if (c >= '0' && c <= '9') {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE) {
-							break;
-						}
-						num += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
-
+					double f;
+					int64_t i;
 					r_token.type = TK_NUMBER;
 
-					if (is_float) {
-						r_token.value = num.as_double();
+					if (_parse_number(p_stream, cchar, f, i)) {
+						r_token.value = f;
 					} else {
-						r_token.value = num.as_int();
+						r_token.value = i;
 					}
 					return OK;
 
@@ -449,20 +523,49 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	// Separators and numbers are scanned straight from the stream, which avoids building a Token
+	// (and its Variant) per element in large packed arrays. Anything else, such as comments,
+	// goes through get_token() so the result is the same.
 	bool first = true;
 	while (true) {
+		char32_t c;
 		if (!first) {
-			get_token(p_stream, token, line, r_err_str);
-			if (token.type == TK_COMMA) {
+			c = _skip_whitespace(p_stream, line);
+			if (c != ',' && c != ')' && c != 0) {
+				p_stream->saved = c;
+				get_token(p_stream, token, line, r_err_str);
+				c = token.type == TK_COMMA ? ',' : (token.type == TK_PARENTHESIS_CLOSE ? ')' : 0);
+			}
+
+			if (c == ',') {
 				//do none
-			} else if (token.type == TK_PARENTHESIS_CLOSE) {
+			} else if (c == ')') {
 				break;
 			} else {
 				r_err_str = "Expected ',' or ')' in constructor";
 				return ERR_PARSE_ERROR;
 			}
 		}
-		get_token(p_stream, token, line, r_err_str);
+
+		c = _skip_whitespace(p_stream, line);
+		if (c == '-' || (c >= '0' && c <= '9')) {
+			double f;
+			int64_t i;
+			if (_parse_number(p_stream, c, f, i)) {
+				r_construct.push_back(T(f));
+			} else {
+				r_construct.push_back(T(i));
+			}
+			first = false;
+			continue;
+		}
+
+		if (c == 0) {
+			token.type = TK_EOF;
+		} else {
+			p_stream->saved = c;
+			get_token(p_stream, token, line, r_err_str);
+		}
 
 		if (first && token.type == TK_PARENTHESIS_CLOSE) {
 			break;
@@ -879,17 +982,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<uint8_t> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				uint8_t *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedInt32Array" || id == "PackedIntArray" || id == "PoolIntArray" || id == "IntArray") {
 			Vector<int32_t> args;
 			Error err = _parse_construct<int32_t>(p_stream, args, line, r_err_str);
@@ -897,17 +990,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int32_t> arr;
-			{
-				int32_t len = args.size();
-				arr.resize(len);
-				int32_t *w = arr.ptrw();
-				for (int32_t i = 0; i < len; i++) {
-					w[i] = int32_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedInt64Array") {
 			Vector<int64_t> args;
 			Error err = _parse_construct<int64_t>(p_stream, args, line, r_err_str);
@@ -915,17 +998,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<int64_t> arr;
-			{
-				int64_t len = args.size();
-				arr.resize(len);
-				int64_t *w = arr.ptrw();
-				for (int64_t i = 0; i < len; i++) {
-					w[i] = int64_t(args[i]);
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat32Array" || id == "PackedRealArray" || id == "PoolRealArray" || id == "FloatArray") {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
@@ -933,17 +1006,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<float> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				float *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedFloat64Array") {
 			Vector<double> args;
 			Error err = _parse_construct<double>(p_stream, args, line, r_err_str);
@@ -951,17 +1014,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				return err;
 			}
 
-			Vector<double> arr;
-			{
-				int len = args.size();
-				arr.resize(len);
-				double *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = args[i];
-				}
-			}
-
-			value = arr;
+			value = args;
 		} else if (id == "PackedStringArray" || id == "PoolStringArray" || id == "StringArray") {
 			get_token(p_stream, token, line, r_err_str);
 			if (token.type != TK_PARENTHESIS_OPEN) {
@@ -997,17 +1050,7 @@ Error VariantParser::parse_value(Token &token, Variant &value, Stream *p_stream,
 				cs.push_back(token.value);
 			}
 
-			Vector<String> arr;
-			{
-				int len = cs.size();
-				arr.resize(len);
-				String *w = arr.ptrw();
-				for (int i = 0; i < len; i++) {
-					w[i] = cs[i];
-				}
-			}
-
-			value = arr;
+			value = cs;
 		} else if (id == "PackedVector2Array" || id == "PoolVector2Array" || id == "Vector2Array") {
 			Vector<float> args;
 			Error err = _parse_construct<float>(p_stream, args, line, r_err_str);
@@ -38,35 +38,79 @@
 class VariantParser {
 public:
 	struct Stream {
-		virtual char32_t get_char() = 0;
-		virtual bool is_utf8() const = 0;
-		virtual bool is_eof() const = 0;
+	private:
+		char32_t *current_buffer = nullptr;
+		char32_t single_char = 0; // Used when the stream is not read ahead.
+		uint32_t readahead_pointer = 0;
+		uint32_t readahead_filled = 0;
+		bool eof = false;
+
+		char32_t _refill_readahead();
+
+	protected:
+		// Set by streams that can read ahead, which own the storage.
+		char32_t *readahead_buffer = nullptr;
+		uint32_t readahead_size = 0;
 
+		// Reads up to p_num_chars into p_buffer, returning how many were read (0 at end of stream).
+		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars) = 0;
+		virtual bool _is_eof() const = 0;
+
+	public:
 		char32_t saved = 0;
 
+		// When disabled, characters are requested one at a time so the position of the underlying
+		// source matches what has been parsed so far. Must be set before the first read.
+		bool readahead_enabled = true;
+
+		_FORCE_INLINE_ char32_t get_char() {
+			if (readahead_pointer < readahead_filled) {
+				return current_buffer[readahead_pointer++];
+			}
+			return _refill_readahead();
+		}
+		virtual bool is_utf8() const = 0;
+		bool is_eof() const;
+
 		Stream() {}
 		virtual ~Stream() {}
 	};
 
 	struct StreamFile : public Stream {
+	private:
+		enum { READAHEAD_SIZE = 2048 };
+		char32_t readahead_storage[READAHEAD_SIZE];
+		uint8_t read_storage[READAHEAD_SIZE];
+
+	protected:
+		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars);
+		virtual bool _is_eof() const;
+
+	public:
 		FileAccess *f = nullptr;
 
-		virtual char32_t get_char();
 		virtual bool is_utf8() const;
-		virtual bool is_eof() const;
 
-		StreamFile() {}
+		StreamFile(bool p_readahead_enabled = true) {
+			readahead_enabled = p_readahead_enabled;
+			readahead_buffer = readahead_storage;
+			readahead_size = READAHEAD_SIZE;
+		}
 	};
 
 	struct StreamString : public Stream {
+	protected:
+		virtual uint32_t _read_buffer(char32_t *p_buffer, uint32_t p_num_chars);
+		virtual bool _is_eof() const;
+
+	public:
 		String s;
 		int pos = 0;
 
-		virtual char32_t get_char();
 		virtual bool is_utf8() const;
-		virtual bool is_eof() const;
 
-		StreamString() {}
+		// Not read ahead, as callers may replace `s` between parses and expect `pos` to stay meaningful.
+		StreamString() { readahead_enabled = false; }
 	};
 
 	typedef Error (*ParseResourceFunc)(void *p_self, Stream *p_stream, Ref<Resource> &r_res, int &line, String &r_err_str);
@@ -120,6 +164,9 @@ public:
 private:
 	static const char *tk_name[TK_MAX];
 
+	static bool _parse_number(Stream *p_stream, char32_t p_first, double &r_float, int64_t &r_int);
+	static char32_t _skip_whitespace(Stream *p_stream, int &line);
+
 	template <class T>
 	static Error _parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str);
 	static Error _parse_enginecfg(Stream *p_stream, Vector<String> &strings, int &line, String &r_err_str);
@@ -246,6 +246,46 @@ int FileAccessUnix::get_buffer(uint8_t *p_dst, int p_length) const {
 	return read;
 };
 
+void FileAccessUnix::prefetch(size_t p_offset, size_t p_length) {
+	ERR_FAIL_COND_MSG(!f, "File must be opened before use.");
+#ifdef POSIX_FADV_WILLNEED
+	// Let the kernel start reading the range asynchronously instead of pulling it through stdio.
+	posix_fadvise(fileno(f), p_offset, p_length, POSIX_FADV_WILLNEED);
+#else
+	FileAccess::prefetch(p_offset, p_length);
+#endif
+}
+
+int FileAccessUnix::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, int p_length) {
+	ERR_FAIL_COND_V_MSG(!f, -1, "File must be opened before use.");
+#if defined(UNIX_ENABLED)
+	// pread() bypasses the stdio buffer and cursor, so this only sees data already flushed to the file.
+	int fd = fileno(f);
+	int read = 0;
+	while (read < p_length) {
+		ssize_t r = pread(fd, p_dst + read, p_length - read, p_offset + read);
+		if (r < 0 && errno == EINTR) {
+			continue;
+		}
+		if (r <= 0) {
+			break;
+		}
+		read += r;
+	}
+	return read;
+#else
+	return FileAccess::get_buffer_at(p_offset, p_dst, p_length);
+#endif
+}
+
+bool FileAccessUnix::has_concurrent_reads() const {
+#if defined(UNIX_ENABLED)
+	return true;
+#else
+	return false;
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -71,6 +71,11 @@ public:
 	virtual uint8_t get_8() const; ///< get a byte
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
 
+	virtual void prefetch(size_t p_offset = 0, size_t p_length = 0);
+
+	virtual int get_buffer_at(uint64_t p_offset, uint8_t *p_dst, int p_length);
+	virtual bool has_concurrent_reads() const;
+
 	virtual Error get_error() const; ///< get last error
 
 	virtual void flush();
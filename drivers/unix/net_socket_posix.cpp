@@ -56,6 +56,10 @@
 
 #include <netinet/tcp.h>
 
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
+
 // BSD calls this flag IPV6_JOIN_GROUP
 #if !defined(IPV6_ADD_MEMBERSHIP) && defined(IPV6_JOIN_GROUP)
 #define IPV6_ADD_MEMBERSHIP IPV6_JOIN_GROUP
@@ -145,6 +149,94 @@ void NetSocketPosix::_set_ip_port(struct sockaddr_storage *p_addr, IP_Address &r
 	};
 }
 
+#if defined(__linux__)
+class NetSocketPollerEpoll : public NetSocketPoller {
+	int epoll_fd;
+	Vector<struct epoll_event> epoll_events;
+
+	static NetSocketPoller *_create_func() {
+		return memnew(NetSocketPollerEpoll);
+	}
+
+public:
+	static void make_default() {
+		_create = _create_func;
+	}
+
+	virtual Error add_socket(const Ref<NetSocket> &p_socket, int p_id, NetSocket::PollType p_type) {
+		ERR_FAIL_COND_V(epoll_fd < 0, ERR_UNCONFIGURED);
+		Error err = NetSocketPoller::add_socket(p_socket, p_id, p_type);
+		if (err != OK) {
+			return err;
+		}
+
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		ev.events = p_type == NetSocket::POLL_TYPE_IN ? EPOLLIN : (p_type == NetSocket::POLL_TYPE_OUT ? EPOLLOUT : EPOLLIN | EPOLLOUT);
+		ev.data.u64 = uint32_t(p_id);
+		if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, static_cast<const NetSocketPosix *>(p_socket.ptr())->_sock, &ev) != 0) {
+			NetSocketPoller::remove_socket(p_id);
+			ERR_FAIL_V_MSG(FAILED, "Unable to add socket to epoll, errno: " + itos(errno) + ".");
+		}
+		return OK;
+	}
+
+	virtual void remove_socket(int p_id) {
+		Map<int, Entry>::Element *E = sockets.find(p_id);
+		if (!E) {
+			return;
+		}
+		// Closed sockets are removed from the epoll set by the kernel already.
+		const NetSocketPosix *sock = static_cast<const NetSocketPosix *>(E->get().socket.ptr());
+		if (sock->is_open()) {
+			epoll_ctl(epoll_fd, EPOLL_CTL_DEL, sock->_sock, nullptr);
+		}
+		NetSocketPoller::remove_socket(p_id);
+	}
+
+	virtual void clear() {
+		while (sockets.front()) {
+			remove_socket(sockets.front()->key());
+		}
+	}
+
+	virtual int wait(Event *r_events, int p_max_events, int p_timeout) {
+		ERR_FAIL_COND_V(epoll_fd < 0 || p_max_events < 1, -1);
+		if (epoll_events.size() < p_max_events) {
+			epoll_events.resize(p_max_events);
+		}
+
+		int ret = epoll_wait(epoll_fd, epoll_events.ptrw(), p_max_events, p_timeout);
+		if (ret < 0) {
+			return errno == EINTR ? 0 : -1;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			const struct epoll_event &ev = epoll_events[i];
+			Event &event = r_events[i];
+			event.id = int(uint32_t(ev.data.u64));
+			event.readable = ev.events & EPOLLIN;
+			event.writable = ev.events & EPOLLOUT;
+			event.error = ev.events & (EPOLLERR | EPOLLHUP);
+		}
+		return ret;
+	}
+
+	NetSocketPollerEpoll() {
+		epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		if (epoll_fd < 0) {
+			ERR_PRINT("Unable to create epoll instance, errno: " + itos(errno) + ".");
+		}
+	}
+
+	~NetSocketPollerEpoll() {
+		if (epoll_fd >= 0) {
+			::close(epoll_fd);
+		}
+	}
+};
+#endif
+
 NetSocket *NetSocketPosix::_create_func() {
 	return memnew(NetSocketPosix);
 }
@@ -157,6 +249,9 @@ void NetSocketPosix::make_default() {
 	}
 #endif
 	_create = _create_func;
+#if defined(__linux__)
+	NetSocketPollerEpoll::make_default();
+#endif
 }
 
 void NetSocketPosix::cleanup() {
@@ -616,6 +711,98 @@ Error NetSocketPosix::sendto(const uint8_t *p_buffer, int p_len, int &r_sent, IP
 	return OK;
 }
 
+#if defined(__linux__)
+// Amount of datagrams handed to the kernel in a single recvmmsg/sendmmsg call.
+// Matches the largest receive batch of UDPServer, bigger send batches take more calls.
+#define NET_SOCKET_MMSG_MAX 16
+
+Error NetSocketPosix::recvfrom_batch(Datagram *r_datagrams, int p_count, int &r_received) {
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	r_received = 0;
+	struct mmsghdr msgs[NET_SOCKET_MMSG_MAX];
+	struct iovec iovs[NET_SOCKET_MMSG_MAX];
+	struct sockaddr_storage addrs[NET_SOCKET_MMSG_MAX];
+
+	while (r_received < p_count) {
+		int count = MIN(p_count - r_received, NET_SOCKET_MMSG_MAX);
+		memset(msgs, 0, sizeof(struct mmsghdr) * count);
+		for (int i = 0; i < count; i++) {
+			Datagram &dgram = r_datagrams[r_received + i];
+			iovs[i].iov_base = dgram.buffer;
+			iovs[i].iov_len = dgram.capacity;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+			msgs[i].msg_hdr.msg_name = &addrs[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+		}
+
+		// Don't wait for the whole batch on blocking sockets.
+		int ret = ::recvmmsg(_sock, msgs, count, MSG_WAITFORONE, nullptr);
+		if (ret < 0) {
+			if (r_received > 0) {
+				return OK; // Errors will be reported by the next call.
+			}
+			NetError err = _get_socket_error();
+			if (err == ERR_NET_WOULD_BLOCK) {
+				return ERR_BUSY;
+			}
+			return FAILED;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			Datagram &dgram = r_datagrams[r_received + i];
+			dgram.size = msgs[i].msg_len;
+			_set_ip_port(&addrs[i], dgram.ip, dgram.port);
+		}
+		r_received += ret;
+		if (ret < count) {
+			break; // Drained.
+		}
+	}
+	return OK;
+}
+
+Error NetSocketPosix::sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent) {
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	r_sent = 0;
+	struct mmsghdr msgs[NET_SOCKET_MMSG_MAX];
+	struct iovec iovs[NET_SOCKET_MMSG_MAX];
+	struct sockaddr_storage addrs[NET_SOCKET_MMSG_MAX];
+
+	while (r_sent < p_count) {
+		int count = MIN(p_count - r_sent, NET_SOCKET_MMSG_MAX);
+		memset(msgs, 0, sizeof(struct mmsghdr) * count);
+		for (int i = 0; i < count; i++) {
+			const Datagram &dgram = p_datagrams[r_sent + i];
+			iovs[i].iov_base = dgram.buffer;
+			iovs[i].iov_len = dgram.size;
+			msgs[i].msg_hdr.msg_iov = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+			if (dgram.ip.is_valid()) {
+				msgs[i].msg_hdr.msg_name = &addrs[i];
+				msgs[i].msg_hdr.msg_namelen = _set_addr_storage(&addrs[i], dgram.ip, dgram.port, _ip_type);
+			}
+		}
+
+		int ret = ::sendmmsg(_sock, msgs, count, 0);
+		if (ret < 0) {
+			NetError err = _get_socket_error();
+			if (err == ERR_NET_WOULD_BLOCK) {
+				return ERR_BUSY;
+			}
+			return FAILED;
+		}
+		r_sent += ret;
+		if (ret < count) {
+			return ERR_BUSY;
+		}
+	}
+	return OK;
+}
+#endif
+
 Error NetSocketPosix::set_broadcasting_enabled(bool p_enabled) {
 	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
 	// IPv6 has no broadcast support.
@@ -716,6 +903,28 @@ int NetSocketPosix::get_available_bytes() const {
 	return len;
 }
 
+Error NetSocketPosix::get_socket_address(IP_Address *r_ip, uint16_t *r_port) const {
+	ERR_FAIL_COND_V(!is_open(), ERR_UNCONFIGURED);
+
+	struct sockaddr_storage saddr;
+	socklen_t len = sizeof(saddr);
+	if (getsockname(_sock, (struct sockaddr *)&saddr, &len) != 0) {
+		_get_socket_error();
+		print_verbose("Error when reading local socket address.");
+		return FAILED;
+	}
+	IP_Address ip;
+	uint16_t port = 0;
+	_set_ip_port(&saddr, ip, port);
+	if (r_ip) {
+		*r_ip = ip;
+	}
+	if (r_port) {
+		*r_port = port;
+	}
+	return OK;
+}
+
 Ref<NetSocket> NetSocketPosix::accept(IP_Address &r_ip, uint16_t &r_port) {
 	Ref<NetSocket> out;
 	ERR_FAIL_COND_V(!is_open(), out);
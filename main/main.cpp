@@ -1049,6 +1049,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 					"memory/limits/multithreaded_server/rid_pool_prealloc",
 					PROPERTY_HINT_RANGE,
 					"0,500,1")); // No negative and limit to 500 due to crashes
+	// Keeping released resources alive would get in the way of reimporting them in the editor.
+	ResourceCache::setup_soft_cache(!editor && !project_manager);
+
 	GLOBAL_DEF("network/limits/debugger/max_chars_per_second", 32768);
 	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/debugger/max_chars_per_second",
 			PropertyInfo(Variant::INT,
@@ -2525,6 +2528,9 @@ void Main::cleanup() {
 
 	OS::get_singleton()->delete_main_loop();
 
+	// Resources only kept by the soft cache need the servers to free them.
+	ResourceCache::clear_soft_cache();
+
 	OS::get_singleton()->_cmdline.clear();
 	OS::get_singleton()->_execpath = "";
 	OS::get_singleton()->_local_clipboard = "";
@@ -77,6 +77,10 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(MEMORY_RESOURCE_SOFT_CACHE);
+	BIND_ENUM_CONSTANT(OBJECT_RESOURCE_SOFT_CACHE_HITS);
+	BIND_ENUM_CONSTANT(OBJECT_RESOURCE_SOFT_CACHE_EVICTIONS);
+	BIND_ENUM_CONSTANT(OBJECT_NODE_PATH_CACHE_HIT_RATE);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -121,6 +125,10 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/output_latency",
+		"memory/resource_soft_cache",
+		"object/resource_soft_cache_hits",
+		"object/resource_soft_cache_evictions",
+		"object/node_path_cache_hit_rate",
 
 	};
 
@@ -183,6 +191,16 @@ float Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case MEMORY_RESOURCE_SOFT_CACHE:
+			return ResourceCache::get_soft_cache_usage();
+		case OBJECT_RESOURCE_SOFT_CACHE_HITS:
+			return ResourceCache::get_soft_cache_hits();
+		case OBJECT_RESOURCE_SOFT_CACHE_EVICTIONS:
+			return ResourceCache::get_soft_cache_evictions();
+		case OBJECT_NODE_PATH_CACHE_HIT_RATE: {
+			uint64_t lookups = Node::node_path_cache_hits + Node::node_path_cache_misses;
+			return lookups ? Node::node_path_cache_hits * 100.0 / lookups : 0;
+		}
 
 		default: {
 		}
@@ -223,6 +241,10 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
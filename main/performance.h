@@ -92,6 +92,10 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		MEMORY_RESOURCE_SOFT_CACHE,
+		OBJECT_RESOURCE_SOFT_CACHE_HITS,
+		OBJECT_RESOURCE_SOFT_CACHE_EVICTIONS,
+		OBJECT_NODE_PATH_CACHE_HIT_RATE,
 		MONITOR_MAX
 	};
 
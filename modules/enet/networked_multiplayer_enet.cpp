@@ -47,16 +47,20 @@ void NetworkedMultiplayerENet::set_target_peer(int p_peer) {
 
 int NetworkedMultiplayerENet::get_packet_peer() const {
 	ERR_FAIL_COND_V_MSG(!active, 1, "The multiplayer instance isn't currently active.");
-	ERR_FAIL_COND_V(incoming_packets.size() == 0, 1);
+	ERR_FAIL_COND_V(incoming_packets.data_left() == 0, 1);
 
-	return incoming_packets.front()->get().from;
+	Packet packet;
+	incoming_packets.copy(&packet, 0, 1);
+	return packet.from;
 }
 
 int NetworkedMultiplayerENet::get_packet_channel() const {
 	ERR_FAIL_COND_V_MSG(!active, -1, "The multiplayer instance isn't currently active.");
-	ERR_FAIL_COND_V(incoming_packets.size() == 0, -1);
+	ERR_FAIL_COND_V(incoming_packets.data_left() == 0, -1);
 
-	return incoming_packets.front()->get().channel;
+	Packet packet;
+	incoming_packets.copy(&packet, 0, 1);
+	return packet.channel;
 }
 
 int NetworkedMultiplayerENet::get_last_packet_channel() const {
@@ -113,6 +117,10 @@ Error NetworkedMultiplayerENet::create_server(int p_port, int p_max_clients, int
 	refuse_connections = false;
 	unique_id = 1;
 	connection_status = CONNECTION_CONNECTED;
+
+	if (service_thread_enabled) {
+		_start_service_thread();
+	}
 	return OK;
 }
 
@@ -205,6 +213,9 @@ Error NetworkedMultiplayerENet::create_client(const String &p_address, int p_por
 	server = false;
 	refuse_connections = false;
 
+	if (service_thread_enabled) {
+		_start_service_thread();
+	}
 	return OK;
 }
 
@@ -213,6 +224,17 @@ void NetworkedMultiplayerENet::poll() {
 
 	_pop_current_packet();
 
+	if (service_thread) {
+		// The service thread already received these, only handle them here.
+		ServiceEvent service_event;
+		while (active && service_thread && service_events->pop(service_event)) {
+			if (!_handle_event(service_event.event, service_event.connect_id)) {
+				return;
+			}
+		}
+		return;
+	}
+
 	ENetEvent event;
 	/* Keep servicing until there are no available events left in queue. */
 	while (true) {
@@ -229,207 +251,227 @@ void NetworkedMultiplayerENet::poll() {
 			break;
 		}
 
-		switch (event.type) {
-			case ENET_EVENT_TYPE_CONNECT: {
-				// Store any relevant client information here.
+		if (!_handle_event(event, event.peer ? event.peer->connectID : 0)) {
+			return;
+		}
+	}
+}
 
-				if (server && refuse_connections) {
-					enet_peer_reset(event.peer);
-					break;
-				}
+// Returns false when the connection was closed and polling must stop.
+bool NetworkedMultiplayerENet::_handle_event(ENetEvent &p_event, uint32_t p_connect_id) {
+	switch (p_event.type) {
+		case ENET_EVENT_TYPE_CONNECT: {
+			// Store any relevant client information here.
 
-				// A client joined with an invalid ID (negative values, 0, and 1 are reserved).
-				// Probably trying to exploit us.
-				if (server && ((int)event.data < 2 || peer_map.has((int)event.data))) {
-					enet_peer_reset(event.peer);
-					ERR_CONTINUE(true);
-				}
+			if (server && refuse_connections) {
+				_peer_reset(p_event.peer, p_connect_id);
+				break;
+			}
 
-				int *new_id = memnew(int);
-				*new_id = event.data;
+			// A client joined with an invalid ID (negative values, 0, and 1 are reserved).
+			// Probably trying to exploit us.
+			if (server && ((int)p_event.data < 2 || peer_map.has((int)p_event.data))) {
+				_peer_reset(p_event.peer, p_connect_id);
+				ERR_FAIL_V(true);
+			}
 
-				if (*new_id == 0) { // Data zero is sent by server (enet won't let you configure this). Server is always 1.
-					*new_id = 1;
-				}
+			int *new_id = memnew(int);
+			*new_id = p_event.data;
 
-				event.peer->data = new_id;
+			if (*new_id == 0) { // Data zero is sent by server (enet won't let you configure this). Server is always 1.
+				*new_id = 1;
+			}
 
-				peer_map[*new_id] = event.peer;
+			p_event.peer->data = new_id;
 
-				connection_status = CONNECTION_CONNECTED; // If connecting, this means it connected to something!
+			peer_map[*new_id] = p_event.peer;
+			peer_connect_ids[p_event.peer] = p_connect_id;
 
-				emit_signal("peer_connected", *new_id);
+			connection_status = CONNECTION_CONNECTED; // If connecting, this means it connected to something!
 
-				if (server) {
-					// Do not notify other peers when server_relay is disabled.
-					if (!server_relay) {
-						break;
-					}
+			emit_signal("peer_connected", *new_id);
 
-					// Someone connected, notify all the peers available
-					for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-						if (E->key() == *new_id) {
-							continue;
-						}
-						// Send existing peers to new peer
-						ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
-						encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
-						encode_uint32(E->key(), &packet->data[4]);
-						enet_peer_send(event.peer, SYSCH_CONFIG, packet);
-						// Send the new peer to existing peers
-						packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
-						encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
-						encode_uint32(*new_id, &packet->data[4]);
-						enet_peer_send(E->get(), SYSCH_CONFIG, packet);
-					}
-				} else {
-					emit_signal("connection_succeeded");
+			if (server) {
+				// Do not notify other peers when server_relay is disabled.
+				if (!server_relay) {
+					break;
 				}
 
-			} break;
-			case ENET_EVENT_TYPE_DISCONNECT: {
-				// Reset the peer's client information.
-
-				int *id = (int *)event.peer->data;
-
-				if (!id) {
-					if (!server) {
-						emit_signal("connection_failed");
+				// Someone connected, notify all the peers available
+				for (const int *K = peer_map.next(nullptr); K; K = peer_map.next(K)) {
+					if (*K == *new_id) {
+						continue;
 					}
-					// Never fully connected.
-					break;
+					// Send existing peers to new peer
+					ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
+					encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
+					encode_uint32(*K, &packet->data[4]);
+					_peer_send(p_event.peer, SYSCH_CONFIG, packet);
+					// Send the new peer to existing peers
+					packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
+					encode_uint32(SYSMSG_ADD_PEER, &packet->data[0]);
+					encode_uint32(*new_id, &packet->data[4]);
+					_peer_send(peer_map[*K], SYSCH_CONFIG, packet);
 				}
+			} else {
+				emit_signal("connection_succeeded");
+			}
 
-				if (!server) {
-					// Client just disconnected from server.
-					emit_signal("server_disconnected");
-					close_connection();
-					return;
-				} else if (server_relay) {
-					// Server just received a client disconnect and is in relay mode, notify everyone else.
-					for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-						if (E->key() == *id) {
-							continue;
-						}
+		} break;
+		case ENET_EVENT_TYPE_DISCONNECT: {
+			// Reset the peer's client information.
 
-						ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
-						encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
-						encode_uint32(*id, &packet->data[4]);
-						enet_peer_send(E->get(), SYSCH_CONFIG, packet);
-					}
+			int *id = (int *)p_event.peer->data;
+
+			if (!id) {
+				if (!server) {
+					emit_signal("connection_failed");
 				}
+				// Never fully connected.
+				break;
+			}
 
-				emit_signal("peer_disconnected", *id);
-				peer_map.erase(*id);
-				memdelete(id);
-			} break;
-			case ENET_EVENT_TYPE_RECEIVE: {
-				if (event.channelID == SYSCH_CONFIG) {
-					// Some config message
-					ERR_CONTINUE(event.packet->dataLength < 8);
-
-					// Only server can send config messages
-					ERR_CONTINUE(server);
-
-					int msg = decode_uint32(&event.packet->data[0]);
-					int id = decode_uint32(&event.packet->data[4]);
-
-					switch (msg) {
-						case SYSMSG_ADD_PEER: {
-							peer_map[id] = nullptr;
-							emit_signal("peer_connected", id);
-
-						} break;
-						case SYSMSG_REMOVE_PEER: {
-							peer_map.erase(id);
-							emit_signal("peer_disconnected", id);
-						} break;
+			if (!server) {
+				// Client just disconnected from server.
+				emit_signal("server_disconnected");
+				close_connection();
+				return false;
+			} else if (server_relay) {
+				// Server just received a client disconnect and is in relay mode, notify everyone else.
+				for (const int *K = peer_map.next(nullptr); K; K = peer_map.next(K)) {
+					if (*K == *id) {
+						continue;
 					}
 
-					enet_packet_destroy(event.packet);
-				} else if (event.channelID < channel_count) {
-					Packet packet;
-					packet.packet = event.packet;
-
-					uint32_t *id = (uint32_t *)event.peer->data;
+					ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
+					encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
+					encode_uint32(*id, &packet->data[4]);
+					_peer_send(peer_map[*K], SYSCH_CONFIG, packet);
+				}
+			}
 
-					ERR_CONTINUE(event.packet->dataLength < 8);
+			emit_signal("peer_disconnected", *id);
+			peer_map.erase(*id);
+			peer_connect_ids.erase(p_event.peer);
+			p_event.peer->data = nullptr; // The peer may be reused for another connection.
+			memdelete(id);
+		} break;
+		case ENET_EVENT_TYPE_RECEIVE: {
+			if (p_event.channelID == SYSCH_CONFIG) {
+				// Some config message
+				ERR_FAIL_COND_V(p_event.packet->dataLength < 8, true);
+
+				// Only server can send config messages
+				ERR_FAIL_COND_V(server, true);
+
+				int msg = decode_uint32(&p_event.packet->data[0]);
+				int id = decode_uint32(&p_event.packet->data[4]);
+
+				switch (msg) {
+					case SYSMSG_ADD_PEER: {
+						peer_map[id] = nullptr;
+						emit_signal("peer_connected", id);
+
+					} break;
+					case SYSMSG_REMOVE_PEER: {
+						peer_map.erase(id);
+						emit_signal("peer_disconnected", id);
+					} break;
+				}
 
-					uint32_t source = decode_uint32(&event.packet->data[0]);
-					int target = decode_uint32(&event.packet->data[4]);
+				enet_packet_destroy(p_event.packet);
+			} else if (p_event.channelID < channel_count) {
+				Packet packet;
+				packet.packet = p_event.packet;
 
-					packet.from = source;
-					packet.channel = event.channelID;
+				uint32_t *id = (uint32_t *)p_event.peer->data;
 
-					if (server) {
-						// Someone is cheating and trying to fake the source!
-						ERR_CONTINUE(source != *id);
+				ERR_FAIL_COND_V(p_event.packet->dataLength < 8, true);
 
-						packet.from = *id;
+				uint32_t source = decode_uint32(&p_event.packet->data[0]);
+				int target = decode_uint32(&p_event.packet->data[4]);
 
-						if (target == 1) {
-							// To myself and only myself
-							incoming_packets.push_back(packet);
-						} else if (!server_relay) {
-							// No other destination is allowed when server is not relaying
-							continue;
-						} else if (target == 0) {
-							// Re-send to everyone but sender :|
+				packet.from = source;
+				packet.channel = p_event.channelID;
 
-							incoming_packets.push_back(packet);
-							// And make copies for sending
-							for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-								if (uint32_t(E->key()) == source) { // Do not resend to self
-									continue;
-								}
+				if (server) {
+					// Someone is cheating and trying to fake the source!
+					ERR_FAIL_COND_V(!id || source != *id, true);
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
+					packet.from = *id;
 
-								enet_peer_send(E->get(), event.channelID, packet2);
+					if (target == 1) {
+						// To myself and only myself
+						_push_incoming_packet(packet);
+					} else if (!server_relay) {
+						// No other destination is allowed when server is not relaying
+						break;
+					} else if (target == 0) {
+						// Re-send to everyone but sender :|
+
+						_push_incoming_packet(packet);
+						// And make copies for sending
+						for (const int *K = peer_map.next(nullptr); K; K = peer_map.next(K)) {
+							if (uint32_t(*K) == source) { // Do not resend to self
+								continue;
 							}
 
-						} else if (target < 0) {
-							// To all but one
+							ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
 
-							// And make copies for sending
-							for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-								if (uint32_t(E->key()) == source || E->key() == -target) { // Do not resend to self, also do not send to excluded
-									continue;
-								}
+							_peer_send(peer_map[*K], p_event.channelID, packet2);
+						}
 
-								ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
+					} else if (target < 0) {
+						// To all but one
 
-								enet_peer_send(E->get(), event.channelID, packet2);
+						// And make copies for sending
+						for (const int *K = peer_map.next(nullptr); K; K = peer_map.next(K)) {
+							if (uint32_t(*K) == source || *K == -target) { // Do not resend to self, also do not send to excluded
+								continue;
 							}
 
-							if (-target != 1) {
-								// Server is not excluded
-								incoming_packets.push_back(packet);
-							} else {
-								// Server is excluded, erase packet
-								enet_packet_destroy(packet.packet);
-							}
+							ENetPacket *packet2 = enet_packet_create(packet.packet->data, packet.packet->dataLength, packet.packet->flags);
+
+							_peer_send(peer_map[*K], p_event.channelID, packet2);
+						}
 
+						if (-target != 1) {
+							// Server is not excluded
+							_push_incoming_packet(packet);
 						} else {
-							// To someone else, specifically
-							ERR_CONTINUE(!peer_map.has(target));
-							enet_peer_send(peer_map[target], event.channelID, packet.packet);
+							// Server is excluded, erase packet
+							enet_packet_destroy(packet.packet);
 						}
+
 					} else {
-						incoming_packets.push_back(packet);
+						// To someone else, specifically
+						ENetPeer **target_peer = peer_map.getptr(target);
+						ERR_FAIL_COND_V(!target_peer, true);
+						_peer_send(*target_peer, p_event.channelID, packet.packet);
 					}
-
-					// Destroy packet later
 				} else {
-					ERR_CONTINUE(true);
+					_push_incoming_packet(packet);
 				}
 
-			} break;
-			case ENET_EVENT_TYPE_NONE: {
-				// Do nothing
-			} break;
-		}
+				// Destroy packet later
+			} else {
+				ERR_FAIL_V(true);
+			}
+
+		} break;
+		case ENET_EVENT_TYPE_NONE: {
+			// Do nothing
+		} break;
+	}
+
+	return true;
+}
+
+void NetworkedMultiplayerENet::_push_incoming_packet(const Packet &p_packet) {
+	if (incoming_packets.space_left() < 1) {
+		incoming_packets.resize(get_shift_from_power_of_2(incoming_packets.size()) + 1);
 	}
+	incoming_packets.write(p_packet);
 }
 
 bool NetworkedMultiplayerENet::is_server() const {
@@ -442,12 +484,14 @@ void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
 	ERR_FAIL_COND_MSG(!active, "The multiplayer instance isn't currently active.");
 
 	_pop_current_packet();
+	_stop_service_thread();
 
 	bool peers_disconnected = false;
-	for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-		if (E->get()) {
-			enet_peer_disconnect_now(E->get(), unique_id);
-			int *id = (int *)(E->get()->data);
+	for (const int *K = peer_map.next(nullptr); K; K = peer_map.next(K)) {
+		ENetPeer *peer = peer_map[*K];
+		if (peer) {
+			enet_peer_disconnect_now(peer, unique_id);
+			int *id = (int *)(peer->data);
 			memdelete(id);
 			peers_disconnected = true;
 		}
@@ -463,8 +507,12 @@ void NetworkedMultiplayerENet::close_connection(uint32_t wait_usec) {
 
 	enet_host_destroy(host);
 	active = false;
-	incoming_packets.clear();
+	Packet packet;
+	while (incoming_packets.read(&packet, 1) == 1) {
+		enet_packet_destroy(packet.packet);
+	}
 	peer_map.clear();
+	peer_connect_ids.clear();
 	unique_id = 1; // Server is 1
 	connection_status = CONNECTION_DISCONNECTED;
 }
@@ -476,20 +524,22 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 
 	if (now) {
 		int *id = (int *)peer_map[p_peer]->data;
-		enet_peer_disconnect_now(peer_map[p_peer], 0);
+		peer_map[p_peer]->data = nullptr;
+		_peer_disconnect(peer_map[p_peer], true);
+		peer_connect_ids.erase(peer_map[p_peer]);
 
 		// enet_peer_disconnect_now doesn't generate ENET_EVENT_TYPE_DISCONNECT,
 		// notify everyone else, send disconnect signal & remove from peer_map like in poll()
 		if (server_relay) {
-			for (Map<int, ENetPeer *>::Element *E = peer_map.front(); E; E = E->next()) {
-				if (E->key() == p_peer) {
+			for (const int *K = peer_map.next(nullptr); K; K = peer_map.next(K)) {
+				if (*K == p_peer) {
 					continue;
 				}
 
 				ENetPacket *packet = enet_packet_create(nullptr, 8, ENET_PACKET_FLAG_RELIABLE);
 				encode_uint32(SYSMSG_REMOVE_PEER, &packet->data[0]);
 				encode_uint32(p_peer, &packet->data[4]);
-				enet_peer_send(E->get(), SYSCH_CONFIG, packet);
+				_peer_send(peer_map[*K], SYSCH_CONFIG, packet);
 			}
 		}
 
@@ -500,21 +550,20 @@ void NetworkedMultiplayerENet::disconnect_peer(int p_peer, bool now) {
 		emit_signal("peer_disconnected", p_peer);
 		peer_map.erase(p_peer);
 	} else {
-		enet_peer_disconnect_later(peer_map[p_peer], 0);
+		_peer_disconnect(peer_map[p_peer], false);
 	}
 }
 
 int NetworkedMultiplayerENet::get_available_packet_count() const {
-	return incoming_packets.size();
+	return incoming_packets.data_left();
 }
 
 Error NetworkedMultiplayerENet::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
-	ERR_FAIL_COND_V_MSG(incoming_packets.size() == 0, ERR_UNAVAILABLE, "No incoming packets available.");
+	ERR_FAIL_COND_V_MSG(incoming_packets.data_left() == 0, ERR_UNAVAILABLE, "No incoming packets available.");
 
 	_pop_current_packet();
 
-	current_packet = incoming_packets.front()->get();
-	incoming_packets.pop_front();
+	incoming_packets.read(&current_packet, 1);
 
 	*r_buffer = (const uint8_t *)(&current_packet.packet->data[8]);
 	r_buffer_size = current_packet.packet->dataLength - 8;
@@ -552,10 +601,10 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 		channel = transfer_channel;
 	}
 
-	Map<int, ENetPeer *>::Element *E = nullptr;
+	ENetPeer **E = nullptr;
 
 	if (target_peer != 0) {
-		E = peer_map.find(ABS(target_peer));
+		E = peer_map.getptr(ABS(target_peer));
 		ERR_FAIL_COND_V_MSG(!E, ERR_INVALID_PARAMETER, vformat("Invalid target peer: %d", target_peer));
 	}
 
@@ -566,37 +615,211 @@ Error NetworkedMultiplayerENet::put_packet(const uint8_t *p_buffer, int p_buffer
 
 	if (server) {
 		if (target_peer == 0) {
-			enet_host_broadcast(host, channel, packet);
+			_host_broadcast(channel, packet);
 		} else if (target_peer < 0) {
 			// Send to all but one
 			// and make copies for sending
 
 			int exclude = -target_peer;
 
-			for (Map<int, ENetPeer *>::Element *F = peer_map.front(); F; F = F->next()) {
-				if (F->key() == exclude) { // Exclude packet
+			for (const int *K = peer_map.next(nullptr); K; K = peer_map.next(K)) {
+				if (*K == exclude) { // Exclude packet
 					continue;
 				}
 
 				ENetPacket *packet2 = enet_packet_create(packet->data, packet->dataLength, packet_flags);
 
-				enet_peer_send(F->get(), channel, packet2);
+				_peer_send(peer_map[*K], channel, packet2);
 			}
 
 			enet_packet_destroy(packet); // Original packet no longer needed
 		} else {
-			enet_peer_send(E->get(), channel, packet);
+			_peer_send(*E, channel, packet);
 		}
 	} else {
 		ERR_FAIL_COND_V(!peer_map.has(1), ERR_BUG);
-		enet_peer_send(peer_map[1], channel, packet); // Send to server for broadcast
+		_peer_send(peer_map[1], channel, packet); // Send to server for broadcast
 	}
 
-	enet_host_flush(host);
+	if (!service_thread) {
+		enet_host_flush(host); // Otherwise, the service thread sends it right away.
+	}
 
 	return OK;
 }
 
+// With the service thread enabled, it's the only one allowed to call into ENet for the
+// host. It services the host continuously, so acknowledgements and resends don't wait
+// on the main thread, and hands received events over to poll() through a ring buffer.
+// Sends and other peer operations go the other way through another ring buffer.
+
+void NetworkedMultiplayerENet::_service_thread_func(void *p_user) {
+	NetworkedMultiplayerENet *enet = (NetworkedMultiplayerENet *)p_user;
+	ServiceEvent event;
+	bool pending = false; // Event which didn't fit in the queue yet.
+
+	while (!enet->service_thread_exit.load(std::memory_order_acquire)) {
+		ServiceCommand command;
+		while (enet->service_commands->pop(command)) {
+			enet->_run_service_command(command);
+		}
+
+		if (pending) {
+			if (!enet->service_events->push(event)) {
+				// The main thread is behind, keep servicing the host meanwhile so peers don't time out.
+				enet_host_service(enet->host, nullptr, 1);
+				continue;
+			}
+			pending = false;
+		}
+
+		int ret = enet_host_service(enet->host, &event.event, 1);
+		while (ret > 0) {
+			// Only this thread may read it, and commands for the peer must match it to still apply.
+			event.connect_id = event.event.peer ? event.event.peer->connectID : 0;
+			if (!enet->service_events->push(event)) {
+				pending = true;
+				break;
+			}
+			ret = enet_host_check_events(enet->host, &event.event);
+		}
+	}
+
+	if (pending && event.event.type == ENET_EVENT_TYPE_RECEIVE) {
+		enet_packet_destroy(event.event.packet);
+	}
+}
+
+void NetworkedMultiplayerENet::_start_service_thread() {
+	service_events = memnew(ServiceQueue<ServiceEvent>);
+	service_commands = memnew(ServiceQueue<ServiceCommand>);
+	service_thread_exit.store(false);
+	service_thread = Thread::create(_service_thread_func, this);
+	if (!service_thread) {
+		// Threads not available, keep servicing on the main thread.
+		memdelete(service_events);
+		memdelete(service_commands);
+		service_events = nullptr;
+		service_commands = nullptr;
+	}
+}
+
+void NetworkedMultiplayerENet::_stop_service_thread() {
+	if (!service_thread) {
+		return;
+	}
+
+	service_thread_exit.store(true, std::memory_order_release);
+	Thread::wait_to_finish(service_thread);
+	memdelete(service_thread);
+	service_thread = nullptr;
+
+	// Now on this thread, run what the service thread didn't get to, and drop the events nobody will handle.
+	ServiceCommand command;
+	while (service_commands->pop(command)) {
+		_run_service_command(command);
+	}
+	ServiceEvent event;
+	while (service_events->pop(event)) {
+		if (event.event.type == ENET_EVENT_TYPE_RECEIVE) {
+			enet_packet_destroy(event.event.packet);
+		}
+	}
+
+	memdelete(service_events);
+	memdelete(service_commands);
+	service_events = nullptr;
+	service_commands = nullptr;
+}
+
+void NetworkedMultiplayerENet::_run_service_command(const ServiceCommand &p_command) {
+	if (p_command.peer && p_command.peer->connectID != p_command.connect_id) {
+		// The connection it was meant for is gone, don't let it reach whoever took its place.
+		if (p_command.type == ServiceCommand::SEND && p_command.packet->referenceCount == 0) {
+			enet_packet_destroy(p_command.packet);
+		}
+		return;
+	}
+
+	switch (p_command.type) {
+		case ServiceCommand::SEND: {
+			if (enet_peer_send(p_command.peer, p_command.channel, p_command.packet) < 0 && p_command.packet->referenceCount == 0) {
+				enet_packet_destroy(p_command.packet); // The peer disconnected meanwhile.
+			}
+		} break;
+		case ServiceCommand::BROADCAST: {
+			enet_host_broadcast(host, p_command.channel, p_command.packet);
+		} break;
+		case ServiceCommand::RESET: {
+			enet_peer_reset(p_command.peer);
+		} break;
+		case ServiceCommand::DISCONNECT: {
+			enet_peer_disconnect_now(p_command.peer, 0);
+		} break;
+		case ServiceCommand::DISCONNECT_LATER: {
+			enet_peer_disconnect_later(p_command.peer, 0);
+		} break;
+		case ServiceCommand::REFUSE_CONNECTIONS: {
+#ifdef GODOT_ENET
+			enet_host_refuse_new_connections(host, p_command.channel);
+#endif
+		} break;
+	}
+}
+
+void NetworkedMultiplayerENet::_push_service_command(ServiceCommand::Type p_type, ENetPeer *p_peer, uint32_t p_connect_id, ENetPacket *p_packet, int p_channel) {
+	ServiceCommand command;
+	command.type = p_type;
+	command.peer = p_peer;
+	command.connect_id = p_connect_id;
+	command.packet = p_packet;
+	command.channel = p_channel;
+	while (!service_commands->push(command)) {
+		OS::get_singleton()->delay_usec(100); // Full, wait for the service thread to catch up.
+	}
+}
+
+void NetworkedMultiplayerENet::_peer_send(ENetPeer *p_peer, int p_channel, ENetPacket *p_packet) {
+	if (service_thread) {
+		const uint32_t *connect_id = peer_connect_ids.getptr(p_peer);
+		if (!connect_id) {
+			enet_packet_destroy(p_packet); // Already disconnected.
+			return;
+		}
+		_push_service_command(ServiceCommand::SEND, p_peer, *connect_id, p_packet, p_channel);
+	} else {
+		enet_peer_send(p_peer, p_channel, p_packet);
+	}
+}
+
+void NetworkedMultiplayerENet::_host_broadcast(int p_channel, ENetPacket *p_packet) {
+	if (service_thread) {
+		_push_service_command(ServiceCommand::BROADCAST, nullptr, 0, p_packet, p_channel);
+	} else {
+		enet_host_broadcast(host, p_channel, p_packet);
+	}
+}
+
+void NetworkedMultiplayerENet::_peer_reset(ENetPeer *p_peer, uint32_t p_connect_id) {
+	if (service_thread) {
+		_push_service_command(ServiceCommand::RESET, p_peer, p_connect_id);
+	} else {
+		enet_peer_reset(p_peer);
+	}
+}
+
+void NetworkedMultiplayerENet::_peer_disconnect(ENetPeer *p_peer, bool p_now) {
+	if (service_thread) {
+		const uint32_t *connect_id = peer_connect_ids.getptr(p_peer);
+		ERR_FAIL_COND(!connect_id);
+		_push_service_command(p_now ? ServiceCommand::DISCONNECT : ServiceCommand::DISCONNECT_LATER, p_peer, *connect_id);
+	} else if (p_now) {
+		enet_peer_disconnect_now(p_peer, 0);
+	} else {
+		enet_peer_disconnect_later(p_peer, 0);
+	}
+}
+
 int NetworkedMultiplayerENet::get_max_packet_size() const {
 	return 1 << 24; // Anything is good
 }
@@ -643,7 +866,9 @@ int NetworkedMultiplayerENet::get_unique_id() const {
 void NetworkedMultiplayerENet::set_refuse_new_connections(bool p_enable) {
 	refuse_connections = p_enable;
 #ifdef GODOT_ENET
-	if (active) {
+	if (service_thread) {
+		_push_service_command(ServiceCommand::REFUSE_CONNECTIONS, nullptr, 0, nullptr, p_enable);
+	} else if (active) {
 		enet_host_refuse_new_connections(host, p_enable);
 	}
 #endif
@@ -822,6 +1047,16 @@ bool NetworkedMultiplayerENet::is_server_relay_enabled() const {
 	return server_relay;
 }
 
+void NetworkedMultiplayerENet::set_service_thread_enabled(bool p_enabled) {
+	ERR_FAIL_COND_MSG(active, "The service thread can't be toggled while the multiplayer instance is active.");
+
+	service_thread_enabled = p_enabled;
+}
+
+bool NetworkedMultiplayerENet::is_service_thread_enabled() const {
+	return service_thread_enabled;
+}
+
 void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_server", "port", "max_clients", "in_bandwidth", "out_bandwidth"), &NetworkedMultiplayerENet::create_server, DEFVAL(32), DEFVAL(0), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("create_client", "address", "port", "in_bandwidth", "out_bandwidth", "client_port"), &NetworkedMultiplayerENet::create_client, DEFVAL(0), DEFVAL(0), DEFVAL(0));
@@ -849,12 +1084,15 @@ void NetworkedMultiplayerENet::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_always_ordered"), &NetworkedMultiplayerENet::is_always_ordered);
 	ClassDB::bind_method(D_METHOD("set_server_relay_enabled", "enabled"), &NetworkedMultiplayerENet::set_server_relay_enabled);
 	ClassDB::bind_method(D_METHOD("is_server_relay_enabled"), &NetworkedMultiplayerENet::is_server_relay_enabled);
+	ClassDB::bind_method(D_METHOD("set_service_thread_enabled", "enabled"), &NetworkedMultiplayerENet::set_service_thread_enabled);
+	ClassDB::bind_method(D_METHOD("is_service_thread_enabled"), &NetworkedMultiplayerENet::is_service_thread_enabled);
 
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_mode", PROPERTY_HINT_ENUM, "None,Range Coder,FastLZ,ZLib,ZStd"), "set_compression_mode", "get_compression_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "transfer_channel"), "set_transfer_channel", "get_transfer_channel");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "channel_count"), "set_channel_count", "get_channel_count");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "always_ordered"), "set_always_ordered", "is_always_ordered");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "service_thread"), "set_service_thread_enabled", "is_service_thread_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "dtls_verify"), "set_dtls_verify_enabled", "is_dtls_verify_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_dtls"), "set_dtls_enabled", "is_dtls_enabled");
 
@@ -888,6 +1126,13 @@ NetworkedMultiplayerENet::NetworkedMultiplayerENet() {
 
 	dtls_enabled = false;
 	dtls_verify = true;
+
+	incoming_packets.resize(6);
+	service_thread_enabled = false;
+	service_thread = nullptr;
+	service_thread_exit.store(false);
+	service_events = nullptr;
+	service_commands = nullptr;
 }
 
 NetworkedMultiplayerENet::~NetworkedMultiplayerENet() {
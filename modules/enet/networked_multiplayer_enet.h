@@ -34,9 +34,14 @@
 #include "core/crypto/crypto.h"
 #include "core/io/compression.h"
 #include "core/io/networked_multiplayer_peer.h"
+#include "core/hash_map.h"
+#include "core/os/thread.h"
+#include "core/ring_buffer.h"
 
 #include <enet/enet.h>
 
+#include <atomic>
+
 class NetworkedMultiplayerENet : public NetworkedMultiplayerPeer {
 	GDCLASS(NetworkedMultiplayerENet, NetworkedMultiplayerPeer);
 
@@ -49,6 +54,39 @@ public:
 		COMPRESS_ZSTD
 	};
 
+protected:
+	// Lock-free queue with a single producer and a single consumer thread.
+	template <class T>
+	struct ServiceQueue {
+		enum {
+			SIZE = 4096 // Must be a power of 2.
+		};
+
+		T items[SIZE];
+		std::atomic<uint32_t> read_pos = { 0 };
+		std::atomic<uint32_t> write_pos = { 0 };
+
+		bool push(const T &p_item) {
+			uint32_t w = write_pos.load(std::memory_order_relaxed);
+			if (w - read_pos.load(std::memory_order_acquire) == SIZE) {
+				return false; // Full.
+			}
+			items[w & (SIZE - 1)] = p_item;
+			write_pos.store(w + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool pop(T &r_item) {
+			uint32_t r = read_pos.load(std::memory_order_relaxed);
+			if (r == write_pos.load(std::memory_order_acquire)) {
+				return false; // Empty.
+			}
+			r_item = items[r & (SIZE - 1)];
+			read_pos.store(r + 1, std::memory_order_release);
+			return true;
+		}
+	};
+
 private:
 	enum {
 		SYSMSG_ADD_PEER,
@@ -82,7 +120,12 @@ private:
 
 	ConnectionStatus connection_status;
 
-	Map<int, ENetPeer *> peer_map;
+	struct PeerHasher {
+		static _FORCE_INLINE_ uint32_t hash(const ENetPeer *p_peer) { return hash_one_uint64((uint64_t)p_peer); }
+	};
+
+	HashMap<int, ENetPeer *> peer_map;
+	HashMap<ENetPeer *, uint32_t, PeerHasher> peer_connect_ids; // Connection each peer had when poll() saw it connect.
 
 	struct Packet {
 		ENetPacket *packet;
@@ -92,12 +135,54 @@ private:
 
 	CompressionMode compression_mode;
 
-	List<Packet> incoming_packets;
+	RingBuffer<Packet> incoming_packets;
 
 	Packet current_packet;
 
 	uint32_t _gen_unique_id() const;
 	void _pop_current_packet();
+	void _push_incoming_packet(const Packet &p_packet);
+	bool _handle_event(ENetEvent &p_event, uint32_t p_connect_id);
+
+	// ENet calls the main thread asks the service thread to make, since only it may touch the host.
+	struct ServiceCommand {
+		enum Type {
+			SEND,
+			BROADCAST,
+			RESET,
+			DISCONNECT,
+			DISCONNECT_LATER,
+			REFUSE_CONNECTIONS,
+		};
+
+		Type type;
+		ENetPeer *peer;
+		uint32_t connect_id; // The service thread may have reused the peer for another connection since.
+		ENetPacket *packet;
+		int channel;
+	};
+
+	struct ServiceEvent {
+		ENetEvent event;
+		uint32_t connect_id;
+	};
+
+	bool service_thread_enabled;
+	Thread *service_thread;
+	std::atomic<bool> service_thread_exit;
+	ServiceQueue<ServiceEvent> *service_events;
+	ServiceQueue<ServiceCommand> *service_commands;
+
+	static void _service_thread_func(void *p_user);
+	void _start_service_thread();
+	void _stop_service_thread();
+	void _run_service_command(const ServiceCommand &p_command);
+	void _push_service_command(ServiceCommand::Type p_type, ENetPeer *p_peer = nullptr, uint32_t p_connect_id = 0, ENetPacket *p_packet = nullptr, int p_channel = 0);
+
+	void _peer_send(ENetPeer *p_peer, int p_channel, ENetPacket *p_packet);
+	void _host_broadcast(int p_channel, ENetPacket *p_packet);
+	void _peer_reset(ENetPeer *p_peer, uint32_t p_connect_id);
+	void _peer_disconnect(ENetPeer *p_peer, bool p_now);
 
 	Vector<uint8_t> src_compressor_mem;
 	Vector<uint8_t> dst_compressor_mem;
@@ -165,6 +250,8 @@ public:
 	bool is_always_ordered() const;
 	void set_server_relay_enabled(bool p_enabled);
 	bool is_server_relay_enabled() const;
+	void set_service_thread_enabled(bool p_enabled);
+	bool is_service_thread_enabled() const;
 
 	NetworkedMultiplayerENet();
 	~NetworkedMultiplayerENet();
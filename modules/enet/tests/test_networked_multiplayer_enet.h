@@ -0,0 +1,111 @@
+/*************************************************************************/
+/*  test_networked_multiplayer_enet.h                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NETWORKED_MULTIPLAYER_ENET_H
+#define TEST_NETWORKED_MULTIPLAYER_ENET_H
+
+#include "modules/enet/networked_multiplayer_enet.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestNetworkedMultiplayerENet {
+
+// Exposes the queue the service thread shares with the main thread.
+class TestENet : public NetworkedMultiplayerENet {
+public:
+	typedef ServiceQueue<uint32_t> Queue;
+};
+
+TEST_CASE("[ENet] Service queue refuses to overflow") {
+	TestENet::Queue *queue = memnew(TestENet::Queue);
+	uint32_t item = 0;
+
+	CHECK_MESSAGE(!queue->pop(item), "Nothing to pop from an empty queue.");
+
+	bool all_pushed = true;
+	for (uint32_t i = 0; i < TestENet::Queue::SIZE; i++) {
+		all_pushed = all_pushed && queue->push(i);
+	}
+	CHECK(all_pushed);
+	CHECK_MESSAGE(!queue->push(TestENet::Queue::SIZE), "A full queue must not overwrite unread items.");
+
+	REQUIRE(queue->pop(item));
+	CHECK(item == 0);
+	CHECK_MESSAGE(queue->push(TestENet::Queue::SIZE), "Popping frees a slot.");
+	CHECK(!queue->push(TestENet::Queue::SIZE + 1));
+
+	bool in_order = true;
+	for (uint32_t i = 1; i <= TestENet::Queue::SIZE; i++) {
+		in_order = in_order && queue->pop(item) && item == i;
+	}
+	CHECK_MESSAGE(in_order, "Items are popped in the order they were pushed, including the one past the wrap.");
+	CHECK(!queue->pop(item));
+
+	memdelete(queue);
+}
+
+TEST_CASE("[ENet] Service queue positions wrap around") {
+	TestENet::Queue *queue = memnew(TestENet::Queue);
+	uint32_t item = 0;
+
+	// Start right before the positions overflow, so they wrap while the queue holds items.
+	const uint32_t start = UINT32_MAX - TestENet::Queue::SIZE / 2;
+	queue->read_pos.store(start);
+	queue->write_pos.store(start);
+
+	bool all_pushed = true;
+	for (uint32_t i = 0; i < TestENet::Queue::SIZE; i++) {
+		all_pushed = all_pushed && queue->push(i);
+	}
+	CHECK(all_pushed);
+	CHECK(queue->write_pos.load() < queue->read_pos.load());
+	CHECK_MESSAGE(!queue->push(TestENet::Queue::SIZE), "The queue is still seen as full after the write position wrapped.");
+
+	bool in_order = true;
+	for (uint32_t i = 0; i < TestENet::Queue::SIZE; i++) {
+		in_order = in_order && queue->pop(item) && item == i;
+	}
+	CHECK(in_order);
+	CHECK_MESSAGE(!queue->pop(item), "The queue is seen as empty after both positions wrapped.");
+
+	// Keep going well past a few more laps of the buffer.
+	bool kept_order = true;
+	for (uint32_t i = 0; i < TestENet::Queue::SIZE * 3; i++) {
+		kept_order = kept_order && queue->push(i) && queue->push(i + 1);
+		kept_order = kept_order && queue->pop(item) && item == i && queue->pop(item) && item == i + 1;
+	}
+	CHECK(kept_order);
+
+	memdelete(queue);
+}
+
+} // namespace TestNetworkedMultiplayerENet
+
+#endif // TEST_NETWORKED_MULTIPLAYER_ENET_H
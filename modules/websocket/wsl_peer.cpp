@@ -246,7 +246,12 @@ Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 	msg.msg_length = p_buffer_size;
 
 	wslay_event_queue_msg(_data->ctx, &msg);
-	if (wslay_event_send(_data->ctx) < 0) {
+	bool failed = wslay_event_send(_data->ctx) < 0;
+	if (_data->is_server && (failed || wslay_event_want_write(_data->ctx))) {
+		// Make sure the server polls us, to flush or to report the disconnection.
+		((WSLServer *)_data->obj)->_flag_peer_poll(_data->id);
+	}
+	if (failed) {
 		close_now();
 		return FAILED;
 	}
@@ -299,6 +304,9 @@ void WSLPeer::close(int p_code, String p_reason) {
 		wslay_event_queue_close(_data->ctx, p_code, (uint8_t *)cs.ptr(), cs.size());
 		wslay_event_send(_data->ctx);
 		_data->closing = true;
+		if (_data->is_server) {
+			((WSLServer *)_data->obj)->_flag_peer_poll(_data->id);
+		}
 	}
 
 	_in_buffer.clear();
@@ -322,6 +330,14 @@ void WSLPeer::set_no_delay(bool p_enabled) {
 	_data->tcp->set_no_delay(p_enabled);
 }
 
+bool WSLPeer::needs_poll() const {
+	if (!_data) {
+		return false;
+	}
+	// SSL connections might buffer decrypted data the socket no longer reports as readable.
+	return _data->destroy || _data->conn.ptr() != _data->tcp.ptr() || wslay_event_want_write(_data->ctx);
+}
+
 void WSLPeer::invalidate() {
 	if (_data) {
 		_data->valid = false;
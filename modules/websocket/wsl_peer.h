@@ -113,6 +113,7 @@ public:
 	void make_context(PeerData *p_data, unsigned int p_in_buf_size, unsigned int p_in_pkt_size, unsigned int p_out_buf_size, unsigned int p_out_pkt_size);
 	Error parse_message(const wslay_event_on_msg_recv_arg *arg);
 	void invalidate();
+	bool needs_poll() const;
 
 	WSLPeer();
 	~WSLPeer();
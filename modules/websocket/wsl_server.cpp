@@ -176,23 +176,52 @@ Error WSLServer::listen(int p_port, const Vector<String> p_protocols, bool gd_mp
 	for (int i = 0; i < p_protocols.size(); i++) {
 		pw[i] = p_protocols[i].strip_edges();
 	}
-	return _server->listen(p_port, bind_ip);
+	Error err = _server->listen(p_port, bind_ip);
+	if (err != OK) {
+		return err;
+	}
+	// Peer IDs are never 0, use it for the listening socket.
+	return _server->add_to_poller(_poller, 0);
+}
+
+void WSLServer::_flag_peer_poll(int p_id) {
+	_poll_ids.insert(p_id);
 }
 
 void WSLServer::poll() {
-	List<int> remove_ids;
-	for (Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.front(); E; E = E->next()) {
-		Ref<WSLPeer> peer = (WSLPeer *)E->get().ptr();
+	bool accept = false;
+	if (_poll_events.size() <= _poller->get_socket_count()) {
+		_poll_events.resize(_poller->get_socket_count() + 1);
+	}
+	NetSocketPoller::Event *events = _poll_events.ptrw();
+	int count = _poller->wait(events, _poll_events.size(), 0);
+	for (int i = 0; i < count; i++) {
+		if (events[i].id == 0) {
+			accept = true;
+		} else {
+			_poll_ids.insert(events[i].id);
+		}
+	}
+
+	Set<int> poll_ids;
+	SWAP(poll_ids, _poll_ids);
+	for (Set<int>::Element *E = poll_ids.front(); E; E = E->next()) {
+		const int id = E->get();
+		Map<int, Ref<WebSocketPeer>>::Element *P = _peer_map.find(id);
+		if (!P) {
+			continue;
+		}
+		Ref<WSLPeer> peer = (WSLPeer *)P->get().ptr();
 		peer->poll();
 		if (!peer->is_connected_to_host()) {
-			_on_disconnect(E->key(), peer->close_code != -1);
-			remove_ids.push_back(E->key());
+			_poller->remove_socket(id);
+			_poll_ids.erase(id);
+			_on_disconnect(id, peer->close_code != -1);
+			_peer_map.erase(id);
+		} else if (peer->needs_poll() || !_poller->has_socket(id)) {
+			_poll_ids.insert(id);
 		}
 	}
-	for (List<int>::Element *E = remove_ids.front(); E; E = E->next()) {
-		_peer_map.erase(E->get());
-	}
-	remove_ids.clear();
 
 	List<Ref<PendingPeer>> remove_peers;
 	for (List<Ref<PendingPeer>>::Element *E = _pending.front(); E; E = E->next()) {
@@ -219,6 +248,11 @@ void WSLServer::poll() {
 		ws_peer->set_no_delay(true);
 
 		_peer_map[id] = ws_peer;
+		if (data->tcp->add_to_poller(_poller, id) != OK) {
+			// Could not watch the socket, fall back to polling it every frame.
+			WARN_PRINT("Unable to watch WebSocket peer " + itos(id) + " for readiness, polling it each frame instead.");
+		}
+		_poll_ids.insert(id);
 		remove_peers.push_back(ppeer);
 		_on_connect(id, ppeer->protocol);
 	}
@@ -227,7 +261,7 @@ void WSLServer::poll() {
 	}
 	remove_peers.clear();
 
-	if (!_server->is_listening()) {
+	if (!accept || !_server->is_listening()) {
 		return;
 	}
 
@@ -262,6 +296,8 @@ int WSLServer::get_max_packet_size() const {
 }
 
 void WSLServer::stop() {
+	_poller->clear();
+	_poll_ids.clear();
 	_server->stop();
 	for (Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.front(); E; E = E->next()) {
 		Ref<WSLPeer> peer = (WSLPeer *)E->get().ptr();
@@ -315,6 +351,7 @@ WSLServer::WSLServer() {
 	_out_buf_size = DEF_BUF_SHIFT;
 	_out_pkt_size = DEF_PKT_SHIFT;
 	_server.instance();
+	_poller = Ref<NetSocketPoller>(NetSocketPoller::create());
 }
 
 WSLServer::~WSLServer() {
@@ -78,6 +78,11 @@ private:
 	Ref<TCP_Server> _server;
 	Vector<String> _protocols;
 
+	// Peers are only polled when their socket is ready, or when flagged.
+	Ref<NetSocketPoller> _poller;
+	Vector<NetSocketPoller::Event> _poll_events;
+	Set<int> _poll_ids;
+
 public:
 	Error set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer, int p_out_packets);
 	Error listen(int p_port, const Vector<String> p_protocols = Vector<String>(), bool gd_mp_api = false);
@@ -91,6 +96,8 @@ public:
 	void disconnect_peer(int p_peer_id, int p_code = 1000, String p_reason = "");
 	virtual void poll();
 
+	void _flag_peer_poll(int p_id);
+
 	WSLServer();
 	~WSLServer();
 };
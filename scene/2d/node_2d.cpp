@@ -284,6 +284,12 @@ Point2 Node2D::get_global_position() const {
 	return get_global_transform().get_origin();
 }
 
+bool Node2D::get_network_interest_position(Vector3 &r_position) const {
+	Point2 pos = get_global_position();
+	r_position = Vector3(pos.x, pos.y, 0);
+	return true;
+}
+
 void Node2D::set_global_position(const Point2 &p_pos) {
 	Transform2D inv;
 	CanvasItem *pi = get_parent_item();
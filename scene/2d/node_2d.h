@@ -98,6 +98,8 @@ public:
 	float get_global_rotation_degrees() const;
 	Size2 get_global_scale() const;
 
+	virtual bool get_network_interest_position(Vector3 &r_position) const override;
+
 	void set_transform(const Transform2D &p_transform);
 	void set_global_transform(const Transform2D &p_transform);
 	void set_global_position(const Point2 &p_pos);
@@ -40,7 +40,7 @@
 
  possible algorithms:
 
- Algorithm 1: (current)
+ Algorithm 1: (no longer current)
 
  definition of invalidation: global is invalid
 
@@ -66,21 +66,32 @@
 
 --
 
-future: no idea
+ Algorithm 3: (current)
+
+ definition of invalidation: local changed since the last flush
+
+ 1) Local and global transforms live in the SceneTree's TransformStore3D, in
+    arrays ordered by depth. Setting a LOCAL only flags it there.
+ 2) Flushing transform notifications recomputes every flagged subtree in one
+    pass, parents first, and notifies the nodes that asked for it.
+ 3) Reading a GLOBAL before that computes it from the nearest flagged parent.
 
  */
 
 Node3DGizmo::Node3DGizmo() {
 }
 
-void Node3D::_notify_dirty() {
+bool Node3D::_is_transform_notify_enabled() const {
 #ifdef TOOLS_ENABLED
-	if ((data.gizmo.is_valid() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
+	return data.gizmo.is_valid() || data.notify_transform;
 #else
-	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
-
+	return data.notify_transform;
 #endif
-		get_tree()->xform_change_list.add(&xform_change);
+}
+
+void Node3D::_update_transform_notify() {
+	if (data.transform_id != TransformStore3D::INVALID_ID) {
+		get_tree()->transform_store_3d.set_notify(data.transform_id, _is_transform_notify_enabled());
 	}
 }
 
@@ -90,34 +101,12 @@ void Node3D::_update_local_transform() const {
 	data.dirty &= ~DIRTY_LOCAL;
 }
 
-void Node3D::_propagate_transform_changed(Node3D *p_origin) {
-	if (!is_inside_tree()) {
-		return;
-	}
-
-	/*
-	if (data.dirty&DIRTY_GLOBAL)
-		return; //already dirty
-	*/
-
-	data.children_lock++;
-
-	for (List<Node3D *>::Element *E = data.children.front(); E; E = E->next()) {
-		if (E->get()->data.toplevel_active) {
-			continue; //don't propagate to a toplevel
-		}
-		E->get()->_propagate_transform_changed(p_origin);
-	}
-#ifdef TOOLS_ENABLED
-	if ((data.gizmo.is_valid() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
-#else
-	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
-#endif
-		get_tree()->xform_change_list.add(&xform_change);
+// Hands the new local transform to the transform store, which updates the
+// subtree and sends the notifications on the next flush.
+void Node3D::_transform_changed() {
+	if (data.transform_id != TransformStore3D::INVALID_ID) {
+		get_tree()->transform_store_3d.set_local(data.transform_id, get_transform(), !data.ignore_notification);
 	}
-	data.dirty |= DIRTY_GLOBAL;
-
-	data.children_lock--;
 }
 
 void Node3D::_notification(int p_what) {
@@ -131,35 +120,49 @@ void Node3D::_notification(int p_what) {
 			}
 
 			if (data.parent) {
-				data.C = data.parent->data.children.push_back(this);
+				data.child_index = data.parent->data.children.size();
+				data.parent->data.children.push_back(this);
 			} else {
-				data.C = nullptr;
+				data.child_index = -1;
 			}
 
 			if (data.toplevel && !Engine::get_singleton()->is_editor_hint()) {
 				if (data.parent) {
 					data.local_transform = data.parent->get_global_transform() * get_transform();
-					data.dirty = DIRTY_VECTORS; //global is always dirty upon entering a scene
+					data.dirty = DIRTY_VECTORS;
 				}
 				data.toplevel_active = true;
 			}
 
-			data.dirty |= DIRTY_GLOBAL; //global is always dirty upon entering a scene
-			_notify_dirty();
+			// New entries count as moved, so the global is computed and notified on the next flush.
+			TransformStore3D &store = get_tree()->transform_store_3d;
+			bool has_parent = data.parent && !data.toplevel_active;
+			data.transform_id = store.create(has_parent ? data.parent->data.transform_id : TransformStore3D::INVALID_ID, get_instance_id());
+			store.set_local(data.transform_id, get_transform());
+			store.set_disable_scale(data.transform_id, data.disable_scale);
+			_update_transform_notify();
 
 			notification(NOTIFICATION_ENTER_WORLD);
 
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
 			notification(NOTIFICATION_EXIT_WORLD, true);
-			if (xform_change.in_list()) {
-				get_tree()->xform_change_list.remove(&xform_change);
+			if (data.transform_id != TransformStore3D::INVALID_ID) {
+				// Children exit first, so the entry has none left.
+				get_tree()->transform_store_3d.free(data.transform_id);
+				data.transform_id = TransformStore3D::INVALID_ID;
 			}
-			if (data.C) {
-				data.parent->data.children.erase(data.C);
+			if (data.child_index >= 0) {
+				Vector<Node3D *> &siblings = data.parent->data.children;
+				int last = siblings.size() - 1;
+				if (data.child_index != last) {
+					siblings.write[data.child_index] = siblings[last];
+					siblings[data.child_index]->data.child_index = data.child_index;
+				}
+				siblings.resize(last);
 			}
 			data.parent = nullptr;
-			data.C = nullptr;
+			data.child_index = -1;
 			data.toplevel_active = false;
 		} break;
 		case NOTIFICATION_ENTER_WORLD: {
@@ -230,7 +233,7 @@ void Node3D::set_transform(const Transform &p_transform) {
 	_change_notify("rotation");
 	_change_notify("rotation_degrees");
 	_change_notify("scale");
-	_propagate_transform_changed(this);
+	_transform_changed();
 	if (data.notify_local_transform) {
 		notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
 	}
@@ -256,25 +259,21 @@ Transform Node3D::get_transform() const {
 Transform Node3D::get_global_transform() const {
 	ERR_FAIL_COND_V(!is_inside_tree(), Transform());
 
-	if (data.dirty & DIRTY_GLOBAL) {
-		if (data.dirty & DIRTY_LOCAL) {
-			_update_local_transform();
-		}
-
-		if (data.parent && !data.toplevel_active) {
-			data.global_transform = data.parent->get_global_transform() * data.local_transform;
-		} else {
-			data.global_transform = data.local_transform;
-		}
-
+	if (data.transform_id == TransformStore3D::INVALID_ID) {
+		// Inside the tree, but not notified yet, e.g. read by a parent entering first.
+		Transform global = get_transform();
 		if (data.disable_scale) {
-			data.global_transform.basis.orthonormalize();
+			global.basis.orthonormalize();
 		}
-
-		data.dirty &= ~DIRTY_GLOBAL;
+		return global;
 	}
 
-	return data.global_transform;
+	return get_tree()->transform_store_3d.get_global(data.transform_id);
+}
+
+bool Node3D::get_network_interest_position(Vector3 &r_position) const {
+	r_position = get_global_transform().origin;
+	return true;
 }
 
 #ifdef TOOLS_ENABLED
@@ -308,7 +307,7 @@ Transform Node3D::get_relative_transform(const Node *p_parent) const {
 void Node3D::set_translation(const Vector3 &p_translation) {
 	data.local_transform.origin = p_translation;
 	_change_notify("transform");
-	_propagate_transform_changed(this);
+	_transform_changed();
 	if (data.notify_local_transform) {
 		notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
 	}
@@ -323,7 +322,7 @@ void Node3D::set_rotation(const Vector3 &p_euler_rad) {
 	data.rotation = p_euler_rad;
 	data.dirty |= DIRTY_LOCAL;
 	_change_notify("transform");
-	_propagate_transform_changed(this);
+	_transform_changed();
 	if (data.notify_local_transform) {
 		notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
 	}
@@ -342,7 +341,7 @@ void Node3D::set_scale(const Vector3 &p_scale) {
 	data.scale = p_scale;
 	data.dirty |= DIRTY_LOCAL;
 	_change_notify("transform");
-	_propagate_transform_changed(this);
+	_transform_changed();
 	if (data.notify_local_transform) {
 		notification(NOTIFICATION_LOCAL_TRANSFORM_CHANGED);
 	}
@@ -407,6 +406,7 @@ void Node3D::set_gizmo(const Ref<Node3DGizmo> &p_gizmo) {
 		data.gizmo->free();
 	}
 	data.gizmo = p_gizmo;
+	_update_transform_notify();
 	if (data.gizmo.is_valid() && is_inside_world()) {
 		data.gizmo->create();
 		if (is_visible_in_tree()) {
@@ -449,6 +449,7 @@ void Node3D::set_disable_gizmo(bool p_enabled) {
 	data.gizmo_disabled = p_enabled;
 	if (!p_enabled && data.gizmo.is_valid()) {
 		data.gizmo = Ref<Node3DGizmo>();
+		_update_transform_notify();
 	}
 }
 
@@ -456,6 +457,9 @@ void Node3D::set_disable_gizmo(bool p_enabled) {
 
 void Node3D::set_disable_scale(bool p_enabled) {
 	data.disable_scale = p_enabled;
+	if (data.transform_id != TransformStore3D::INVALID_ID) {
+		get_tree()->transform_store_3d.set_disable_scale(data.transform_id, p_enabled);
+	}
 }
 
 bool Node3D::is_scale_disabled() const {
@@ -467,6 +471,8 @@ void Node3D::set_as_toplevel(bool p_enabled) {
 		return;
 	}
 	if (is_inside_tree() && !Engine::get_singleton()->is_editor_hint()) {
+		ERR_FAIL_COND_MSG(get_tree()->is_processing_thread_groups(), "Can't change top level while process thread groups are being processed. Consider using call_deferred(\"set_as_toplevel\", enabled) instead.");
+
 		if (p_enabled) {
 			set_transform(get_global_transform());
 		} else if (data.parent) {
@@ -475,6 +481,8 @@ void Node3D::set_as_toplevel(bool p_enabled) {
 
 		data.toplevel = p_enabled;
 		data.toplevel_active = p_enabled;
+		bool has_parent = data.parent && !p_enabled;
+		get_tree()->transform_store_3d.set_parent(data.transform_id, has_parent ? data.parent->data.transform_id : TransformStore3D::INVALID_ID);
 
 	} else {
 		data.toplevel = p_enabled;
@@ -502,8 +510,8 @@ void Node3D::_propagate_visibility_changed() {
 	}
 #endif
 
-	for (List<Node3D *>::Element *E = data.children.front(); E; E = E->next()) {
-		Node3D *c = E->get();
+	for (int i = 0; i < data.children.size(); i++) {
+		Node3D *c = data.children[i];
 		if (!c || !c->data.visible) {
 			continue;
 		}
@@ -676,6 +684,7 @@ Vector3 Node3D::to_global(Vector3 p_local) const {
 
 void Node3D::set_notify_transform(bool p_enable) {
 	data.notify_transform = p_enable;
+	_update_transform_notify();
 }
 
 bool Node3D::is_transform_notification_enabled() const {
@@ -692,10 +701,11 @@ bool Node3D::is_local_transform_notification_enabled() const {
 
 void Node3D::force_update_transform() {
 	ERR_FAIL_COND(!is_inside_tree());
-	if (!xform_change.in_list()) {
+	TransformStore3D &store = get_tree()->transform_store_3d;
+	if (!_is_transform_notify_enabled() || !store.is_global_stale(data.transform_id)) {
 		return; //nothing to update
 	}
-	get_tree()->xform_change_list.remove(&xform_change);
+	store.skip_notify(data.transform_id);
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
@@ -782,8 +792,7 @@ void Node3D::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("visibility_changed"));
 }
 
-Node3D::Node3D() :
-		xform_change(this) {
+Node3D::Node3D() {
 	data.dirty = DIRTY_NONE;
 	data.children_lock = 0;
 
@@ -803,7 +812,8 @@ Node3D::Node3D() :
 	data.notify_local_transform = false;
 	data.notify_transform = false;
 	data.parent = nullptr;
-	data.C = nullptr;
+	data.child_index = -1;
+	data.transform_id = TransformStore3D::INVALID_ID;
 }
 
 Node3D::~Node3D() {
@@ -55,19 +55,17 @@ class Node3D : public Node {
 	enum TransformDirty {
 		DIRTY_NONE = 0,
 		DIRTY_VECTORS = 1,
-		DIRTY_LOCAL = 2,
-		DIRTY_GLOBAL = 4
+		DIRTY_LOCAL = 2
 	};
 
-	mutable SelfList<Node> xform_change;
-
 	struct Data {
-		mutable Transform global_transform;
 		mutable Transform local_transform;
 		mutable Vector3 rotation;
 		mutable Vector3 scale;
 
 		mutable int dirty;
+		// Entry in SceneTree::transform_store_3d, which keeps the global transform.
+		TransformStore3D::ID transform_id;
 
 		Viewport *viewport;
 
@@ -77,8 +75,8 @@ class Node3D : public Node {
 
 		int children_lock;
 		Node3D *parent;
-		List<Node3D *> children;
-		List<Node3D *>::Element *C;
+		Vector<Node3D *> children; // Unordered.
+		int child_index; // Position in the parent's children.
 
 		bool ignore_notification;
 		bool notify_local_transform;
@@ -96,8 +94,9 @@ class Node3D : public Node {
 	} data;
 
 	void _update_gizmo();
-	void _notify_dirty();
-	void _propagate_transform_changed(Node3D *p_origin);
+	bool _is_transform_notify_enabled() const;
+	void _update_transform_notify();
+	void _transform_changed();
 
 	void _propagate_visibility_changed();
 
@@ -139,6 +138,8 @@ public:
 	Transform get_transform() const;
 	Transform get_global_transform() const;
 
+	virtual bool get_network_interest_position(Vector3 &r_position) const override;
+
 #ifdef TOOLS_ENABLED
 	virtual Transform get_global_gizmo_transform() const;
 	virtual Transform get_local_gizmo_transform() const;
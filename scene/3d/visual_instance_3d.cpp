@@ -63,7 +63,12 @@ void VisualInstance3D::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 			Transform gt = get_global_transform();
-			RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			SceneTree *tree = get_tree();
+			if (tree && tree->xform_change_flushing) {
+				tree->_queue_instance_transform(instance, gt);
+			} else {
+				RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			}
 		} break;
 		case NOTIFICATION_EXIT_WORLD: {
 			RenderingServer::get_singleton()->instance_set_scenario(instance, RID());
@@ -0,0 +1,209 @@
+/*************************************************************************/
+/*  http_connection_pool.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "http_connection_pool.h"
+
+#include "core/os/os.h"
+
+Ref<HTTPClient> HTTPConnectionPool::_create_client() {
+	Ref<HTTPClient> client;
+	client.instance();
+	return client;
+}
+
+bool HTTPConnectionPool::_is_client_connected(Ref<HTTPClient> p_client) {
+	p_client->poll();
+	return p_client->get_status() == HTTPClient::STATUS_CONNECTED;
+}
+
+void HTTPConnectionPool::_close_client(Ref<HTTPClient> p_client) {
+	p_client->close();
+}
+
+uint64_t HTTPConnectionPool::_get_ticks_msec() const {
+	return OS::get_singleton()->get_ticks_msec();
+}
+
+String HTTPConnectionPool::make_key(bool p_ssl, const String &p_host, int p_port, bool p_validate_ssl) {
+	return (p_ssl ? "https://" : "http://") + p_host + ":" + itos(p_port) + (p_validate_ssl ? "" : "/unvalidated");
+}
+
+bool HTTPConnectionPool::is_keep_alive(const Vector<String> &p_response_headers) {
+	for (int i = 0; i < p_response_headers.size(); i++) {
+		const String &header = p_response_headers[i];
+		int colon = header.find(":");
+		if (colon == -1 || header.substr(0, colon).strip_edges().to_lower() != "connection") {
+			continue;
+		}
+		// A list of options, like "keep-alive, close".
+		Vector<String> options = header.substr(colon + 1, header.length()).split(",");
+		for (int j = 0; j < options.size(); j++) {
+			if (options[j].strip_edges().to_lower() == "close") {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool HTTPConnectionPool::can_retry(HTTPClient::Method p_method) {
+	switch (p_method) {
+		case HTTPClient::METHOD_GET:
+		case HTTPClient::METHOD_HEAD:
+		case HTTPClient::METHOD_OPTIONS:
+		case HTTPClient::METHOD_TRACE:
+			return true;
+		default:
+			return false;
+	}
+}
+
+Error HTTPConnectionPool::acquire(const String &p_key, Ref<HTTPClient> &r_client, bool &r_reused, Semaphore *p_waiter) {
+	MutexLock lock(mutex);
+
+	r_reused = false;
+	Host *host = hosts.getptr(p_key);
+	if (!host) {
+		hosts.set(p_key, Host());
+		host = hosts.getptr(p_key);
+	}
+
+	const uint64_t now = _get_ticks_msec();
+	while (host->idle.front()) {
+		IdleClient idle = host->idle.front()->get();
+		host->idle.pop_front();
+		if (now - idle.idle_since > keep_alive_msec || !_is_client_connected(idle.client)) {
+			_close_client(idle.client);
+			continue;
+		}
+		r_client = idle.client;
+		r_reused = true;
+		break;
+	}
+
+	if (!r_reused) {
+		if (max_connections_per_host > 0 && host->active >= max_connections_per_host) {
+			if (p_waiter && !host->waiting.find(p_waiter)) {
+				host->waiting.push_back(p_waiter);
+			}
+			return ERR_BUSY;
+		}
+		r_client = _create_client();
+	}
+	host->active++;
+
+	return OK;
+}
+
+void HTTPConnectionPool::release(const String &p_key, const Ref<HTTPClient> &p_client, bool p_keep_alive) {
+	MutexLock lock(mutex);
+
+	Host *host = hosts.getptr(p_key);
+	ERR_FAIL_COND(!host);
+	host->active--;
+
+	// Let them all try again, the ones that don't get the connection wait again.
+	for (List<Semaphore *>::Element *E = host->waiting.front(); E; E = E->next()) {
+		E->get()->post();
+	}
+	host->waiting.clear();
+
+	if (!p_keep_alive || !_is_client_connected(p_client)) {
+		_close_client(p_client);
+		return;
+	}
+
+	IdleClient idle;
+	idle.client = p_client;
+	idle.idle_since = _get_ticks_msec();
+	host->idle.push_front(idle);
+	// No more idle connections than could be active at once.
+	while (max_connections_per_host > 0 && host->idle.size() > max_connections_per_host) {
+		_close_client(host->idle.back()->get().client);
+		host->idle.pop_back();
+	}
+}
+
+Ref<HTTPClient> HTTPConnectionPool::renew(const Ref<HTTPClient> &p_client) {
+	MutexLock lock(mutex);
+
+	_close_client(p_client);
+	return _create_client();
+}
+
+void HTTPConnectionPool::cancel_wait(const String &p_key, Semaphore *p_waiter) {
+	MutexLock lock(mutex);
+
+	Host *host = hosts.getptr(p_key);
+	if (host) {
+		host->waiting.erase(p_waiter);
+	}
+}
+
+void HTTPConnectionPool::clear() {
+	MutexLock lock(mutex);
+
+	for (const String *key = hosts.next(nullptr); key; key = hosts.next(key)) {
+		List<IdleClient> &idle = hosts.get(*key).idle;
+		for (List<IdleClient>::Element *E = idle.front(); E; E = E->next()) {
+			_close_client(E->get().client);
+		}
+	}
+	hosts.clear();
+}
+
+int HTTPConnectionPool::get_active_count(const String &p_key) {
+	MutexLock lock(mutex);
+
+	const Host *host = hosts.getptr(p_key);
+	return host ? host->active : 0;
+}
+
+int HTTPConnectionPool::get_idle_count(const String &p_key) {
+	MutexLock lock(mutex);
+
+	const Host *host = hosts.getptr(p_key);
+	return host ? host->idle.size() : 0;
+}
+
+void HTTPConnectionPool::set_max_connections_per_host(int p_max) {
+	ERR_FAIL_COND(p_max < 0);
+	MutexLock lock(mutex);
+	max_connections_per_host = p_max;
+}
+
+void HTTPConnectionPool::set_keep_alive_msec(uint64_t p_msec) {
+	MutexLock lock(mutex);
+	keep_alive_msec = p_msec;
+}
+
+HTTPConnectionPool::~HTTPConnectionPool() {
+	clear();
+}
@@ -0,0 +1,101 @@
+/*************************************************************************/
+/*  http_connection_pool.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef HTTP_CONNECTION_POOL_H
+#define HTTP_CONNECTION_POOL_H
+
+#include "core/hash_map.h"
+#include "core/io/http_client.h"
+#include "core/list.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+
+// Keep-alive HTTP connections shared by HTTPRequests, grouped by a key naming
+// the scheme, host and port. Each key allows a limited number of active
+// connections; released ones stay idle for reuse until they expire. Requests
+// over the limit get ERR_BUSY, and threaded ones can leave a semaphore to be
+// posted when a connection is released.
+class HTTPConnectionPool {
+	struct IdleClient {
+		Ref<HTTPClient> client;
+		uint64_t idle_since = 0;
+	};
+
+	struct Host {
+		List<IdleClient> idle; // Most recently used first.
+		int active = 0;
+		List<Semaphore *> waiting;
+	};
+
+	Mutex mutex;
+	HashMap<String, Host> hosts;
+	int max_connections_per_host = 6;
+	uint64_t keep_alive_msec = 15000;
+
+protected:
+	// Overridden by tests, so they don't need a server.
+	virtual Ref<HTTPClient> _create_client();
+	virtual bool _is_client_connected(Ref<HTTPClient> p_client);
+	virtual void _close_client(Ref<HTTPClient> p_client);
+	virtual uint64_t _get_ticks_msec() const;
+
+public:
+	static String make_key(bool p_ssl, const String &p_host, int p_port, bool p_validate_ssl);
+	// False if the headers of a response ask to close the connection.
+	static bool is_keep_alive(const Vector<String> &p_response_headers);
+	// True for methods that may be sent again on a new connection when a reused
+	// one fails, because the server may have processed them already.
+	static bool can_retry(HTTPClient::Method p_method);
+
+	// Sets r_client to an idle connection, or a new client if there is none.
+	// Returns ERR_BUSY if all the connections allowed for p_key are in use,
+	// remembering p_waiter if given.
+	Error acquire(const String &p_key, Ref<HTTPClient> &r_client, bool &r_reused, Semaphore *p_waiter = nullptr);
+	// Returns an acquired connection, keeping it idle if p_keep_alive and still connected.
+	void release(const String &p_key, const Ref<HTTPClient> &p_client, bool p_keep_alive);
+	// Closes an acquired connection and returns a new client in the same slot.
+	Ref<HTTPClient> renew(const Ref<HTTPClient> &p_client);
+	void cancel_wait(const String &p_key, Semaphore *p_waiter);
+	void clear();
+
+	int get_active_count(const String &p_key);
+	int get_idle_count(const String &p_key);
+
+	// Zero means no limit.
+	void set_max_connections_per_host(int p_max);
+	int get_max_connections_per_host() const { return max_connections_per_host; }
+
+	void set_keep_alive_msec(uint64_t p_msec);
+	uint64_t get_keep_alive_msec() const { return keep_alive_msec; }
+
+	virtual ~HTTPConnectionPool();
+};
+
+#endif // HTTP_CONNECTION_POOL_H
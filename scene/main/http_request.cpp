@@ -30,13 +30,86 @@
 
 #include "http_request.h"
 
+#include "core/project_settings.h"
+
+HTTPConnectionPool *HTTPRequest::connection_pool = nullptr;
+
 void HTTPRequest::_redirect_request(const String &p_new_url) {
 }
 
 Error HTTPRequest::_request() {
+	Error err = _acquire_client();
+	waiting_for_connection = err == ERR_BUSY;
+	if (err != OK) {
+		return err;
+	}
+	if (reused_connection) {
+		return OK; // Already connected, the request is sent on the next update.
+	}
 	return client->connect_to_host(url, port, use_ssl, validate_ssl);
 }
 
+Error HTTPRequest::_acquire_client() {
+	reused_connection = false;
+	if (use_connection_pool) {
+		ERR_FAIL_COND_V(!connection_pool, ERR_UNCONFIGURED);
+		pool_key = HTTPConnectionPool::make_key(use_ssl, url, port, validate_ssl);
+		Ref<HTTPClient> pooled;
+		Error err = connection_pool->acquire(pool_key, pooled, reused_connection, use_threads ? &thread_semaphore : nullptr);
+		if (err != OK) {
+			return err;
+		}
+		MutexLock lock(client_mutex);
+		client = pooled;
+		has_connection_slot = true;
+	}
+
+	client->set_blocking_mode(use_threads);
+	client->set_read_chunk_size(download_chunk_size);
+	return OK;
+}
+
+void HTTPRequest::_release_client() {
+	if (!has_connection_slot) {
+		client->close();
+		return;
+	}
+	has_connection_slot = false;
+
+	connection_pool->release(pool_key, client, !got_response || HTTPConnectionPool::is_keep_alive(response_headers));
+	MutexLock lock(client_mutex);
+	client.instance();
+}
+
+bool HTTPRequest::_retry_with_new_connection() {
+	// Servers may close idle keep-alive connections at any time, retry once on a new one.
+	// Only requests without side effects, as the server may have processed the first attempt.
+	if (!reused_connection || got_response || !HTTPConnectionPool::can_retry(method)) {
+		return false;
+	}
+
+	{
+		MutexLock lock(client_mutex);
+		client = connection_pool->renew(client);
+		client->set_blocking_mode(use_threads);
+		client->set_read_chunk_size(download_chunk_size);
+	}
+	reused_connection = false;
+	request_sent = false;
+	return client->connect_to_host(url, port, use_ssl, validate_ssl) == OK;
+}
+
+void HTTPRequest::_emit_body_chunk(const PackedByteArray &p_chunk, uint32_t p_generation) {
+	if (p_generation != body_chunk_generation) {
+		return; // Its request was cancelled, which already dropped it from pending_body_chunks.
+	}
+	atomic_decrement(&pending_body_chunks);
+	thread_semaphore.post();
+	if (requesting) {
+		emit_signal("body_chunk_received", p_chunk);
+	}
+}
+
 Error HTTPRequest::_parse_url(const String &p_url) {
 	url = p_url;
 	use_ssl = false;
@@ -109,12 +182,14 @@ Error HTTPRequest::request(const String &p_url, const Vector<String> &p_custom_h
 	if (use_threads) {
 		thread_done = false;
 		thread_request_quit = false;
-		client->set_blocking_mode(true);
+		pending_body_chunks = 0;
+		while (thread_semaphore.try_wait()) {
+			// Drop wake-ups left over from previous requests.
+		}
 		thread = Thread::create(_thread_func, this);
 	} else {
-		client->set_blocking_mode(false);
 		err = _request();
-		if (err != OK) {
+		if (err != OK && err != ERR_BUSY) {
 			call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PackedStringArray(), PackedByteArray());
 			return ERR_CANT_CONNECT;
 		}
@@ -130,10 +205,17 @@ void HTTPRequest::_thread_func(void *p_userdata) {
 
 	Error err = hr->_request();
 
-	if (err != OK) {
+	if (err != OK && err != ERR_BUSY) {
 		hr->call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PackedStringArray(), PackedByteArray());
 	} else {
 		while (!hr->thread_request_quit) {
+			if (hr->pending_body_chunks >= MAX_PENDING_BODY_CHUNKS || hr->waiting_for_connection) {
+				// Let the main thread catch up before reading more of the body, or wait for a connection to be released.
+				hr->thread_semaphore.wait();
+				if (hr->thread_request_quit || hr->pending_body_chunks >= MAX_PENDING_BODY_CHUNKS) {
+					continue;
+				}
+			}
 			bool exit = hr->_update_connection();
 			if (exit) {
 				break;
@@ -156,6 +238,7 @@ void HTTPRequest::cancel_request() {
 		set_process_internal(false);
 	} else {
 		thread_request_quit = true;
+		thread_semaphore.post();
 		Thread::wait_to_finish(thread);
 		memdelete(thread);
 		thread = nullptr;
@@ -165,7 +248,14 @@ void HTTPRequest::cancel_request() {
 		memdelete(file);
 		file = nullptr;
 	}
-	client->close();
+	_release_client();
+	if (waiting_for_connection) {
+		connection_pool->cancel_wait(pool_key, &thread_semaphore);
+	}
+	waiting_for_connection = false;
+	reused_connection = false;
+	pending_body_chunks = 0;
+	body_chunk_generation++;
 	body.resize(0);
 	got_response = false;
 	response_code = -1;
@@ -209,7 +299,7 @@ bool HTTPRequest::_handle_response(bool *ret_value) {
 
 		if (new_request != "") {
 			// Process redirect
-			client->close();
+			_release_client();
 			int new_redirs = redirections + 1; // Because _request() will clear it
 			Error err;
 			if (new_request.begins_with("http")) {
@@ -220,7 +310,7 @@ bool HTTPRequest::_handle_response(bool *ret_value) {
 			}
 
 			err = _request();
-			if (err == OK) {
+			if (err == OK || err == ERR_BUSY) {
 				request_sent = false;
 				got_response = false;
 				body_len = -1;
@@ -237,8 +327,22 @@ bool HTTPRequest::_handle_response(bool *ret_value) {
 }
 
 bool HTTPRequest::_update_connection() {
+	if (waiting_for_connection) {
+		// All the connections to this host were busy, try again.
+		Error err = _request();
+		if (err == ERR_BUSY) {
+			return false;
+		} else if (err != OK) {
+			call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PackedStringArray(), PackedByteArray());
+			return true;
+		}
+	}
+
 	switch (client->get_status()) {
 		case HTTPClient::STATUS_DISCONNECTED: {
+			if (_retry_with_new_connection()) {
+				return false;
+			}
 			call_deferred("_request_done", RESULT_CANT_CONNECT, 0, PackedStringArray(), PackedByteArray());
 			return true; // End it, since it's doing something
 		} break;
@@ -290,6 +394,9 @@ bool HTTPRequest::_update_connection() {
 
 				Error err = client->request(method, request_string, headers, request_data);
 				if (err != OK) {
+					if (_retry_with_new_connection()) {
+						return false;
+					}
 					call_deferred("_request_done", RESULT_CONNECTION_ERROR, 0, PackedStringArray(), PackedByteArray());
 					return true;
 				}
@@ -347,6 +454,18 @@ bool HTTPRequest::_update_connection() {
 					call_deferred("_request_done", RESULT_DOWNLOAD_FILE_WRITE_ERROR, response_code, response_headers, PackedByteArray());
 					return true;
 				}
+			} else if (body_streaming) {
+				if (chunk.size() > 0) {
+					if (use_threads) {
+						atomic_increment(&pending_body_chunks);
+						call_deferred("_emit_body_chunk", chunk, body_chunk_generation);
+					} else {
+						emit_signal("body_chunk_received", chunk);
+						if (!requesting) {
+							return true; // Cancelled from the signal.
+						}
+					}
+				}
 			} else {
 				body.append_array(chunk);
 			}
@@ -370,6 +489,9 @@ bool HTTPRequest::_update_connection() {
 
 		} break; // Request resulted in body: break which must be read
 		case HTTPClient::STATUS_CONNECTION_ERROR: {
+			if (_retry_with_new_connection()) {
+				return false;
+			}
 			call_deferred("_request_done", RESULT_CONNECTION_ERROR, 0, PackedStringArray(), PackedByteArray());
 			return true;
 		} break;
@@ -438,14 +560,34 @@ String HTTPRequest::get_download_file() const {
 void HTTPRequest::set_download_chunk_size(int p_chunk_size) {
 	ERR_FAIL_COND(get_http_client_status() != HTTPClient::STATUS_DISCONNECTED);
 
+	download_chunk_size = p_chunk_size;
 	client->set_read_chunk_size(p_chunk_size);
 }
 
 int HTTPRequest::get_download_chunk_size() const {
-	return client->get_read_chunk_size();
+	return download_chunk_size;
+}
+
+void HTTPRequest::set_use_connection_pool(bool p_use) {
+	ERR_FAIL_COND(requesting);
+	use_connection_pool = p_use;
+}
+
+bool HTTPRequest::is_using_connection_pool() const {
+	return use_connection_pool;
+}
+
+void HTTPRequest::set_body_streaming(bool p_enabled) {
+	ERR_FAIL_COND(requesting);
+	body_streaming = p_enabled;
+}
+
+bool HTTPRequest::is_body_streaming() const {
+	return body_streaming;
 }
 
 HTTPClient::Status HTTPRequest::get_http_client_status() const {
+	MutexLock lock(client_mutex);
 	return client->get_status();
 }
 
@@ -488,6 +630,12 @@ void HTTPRequest::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_use_threads", "enable"), &HTTPRequest::set_use_threads);
 	ClassDB::bind_method(D_METHOD("is_using_threads"), &HTTPRequest::is_using_threads);
 
+	ClassDB::bind_method(D_METHOD("set_use_connection_pool", "enable"), &HTTPRequest::set_use_connection_pool);
+	ClassDB::bind_method(D_METHOD("is_using_connection_pool"), &HTTPRequest::is_using_connection_pool);
+
+	ClassDB::bind_method(D_METHOD("set_body_streaming", "enabled"), &HTTPRequest::set_body_streaming);
+	ClassDB::bind_method(D_METHOD("is_body_streaming"), &HTTPRequest::is_body_streaming);
+
 	ClassDB::bind_method(D_METHOD("set_body_size_limit", "bytes"), &HTTPRequest::set_body_size_limit);
 	ClassDB::bind_method(D_METHOD("get_body_size_limit"), &HTTPRequest::get_body_size_limit);
 
@@ -502,6 +650,7 @@ void HTTPRequest::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("_redirect_request"), &HTTPRequest::_redirect_request);
 	ClassDB::bind_method(D_METHOD("_request_done"), &HTTPRequest::_request_done);
+	ClassDB::bind_method(D_METHOD("_emit_body_chunk"), &HTTPRequest::_emit_body_chunk);
 
 	ClassDB::bind_method(D_METHOD("set_timeout", "timeout"), &HTTPRequest::set_timeout);
 	ClassDB::bind_method(D_METHOD("get_timeout"), &HTTPRequest::get_timeout);
@@ -512,10 +661,13 @@ void HTTPRequest::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "download_file", PROPERTY_HINT_FILE), "set_download_file", "get_download_file");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "download_chunk_size", PROPERTY_HINT_RANGE, "256,16777216"), "set_download_chunk_size", "get_download_chunk_size");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "is_using_threads");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_connection_pool"), "set_use_connection_pool", "is_using_connection_pool");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "body_streaming"), "set_body_streaming", "is_body_streaming");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "body_size_limit", PROPERTY_HINT_RANGE, "-1,2000000000"), "set_body_size_limit", "get_body_size_limit");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_redirects", PROPERTY_HINT_RANGE, "-1,64"), "set_max_redirects", "get_max_redirects");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "timeout", PROPERTY_HINT_RANGE, "0,86400"), "set_timeout", "get_timeout");
 
+	ADD_SIGNAL(MethodInfo("body_chunk_received", PropertyInfo(Variant::PACKED_BYTE_ARRAY, "chunk")));
 	ADD_SIGNAL(MethodInfo("request_completed", PropertyInfo(Variant::INT, "result"), PropertyInfo(Variant::INT, "response_code"), PropertyInfo(Variant::PACKED_STRING_ARRAY, "headers"), PropertyInfo(Variant::PACKED_BYTE_ARRAY, "body")));
 
 	BIND_ENUM_CONSTANT(RESULT_SUCCESS);
@@ -534,6 +686,20 @@ void HTTPRequest::_bind_methods() {
 	BIND_ENUM_CONSTANT(RESULT_TIMEOUT);
 }
 
+void HTTPRequest::init_connection_pool() {
+	connection_pool = memnew(HTTPConnectionPool);
+	connection_pool->set_max_connections_per_host(GLOBAL_DEF("network/limits/http/max_connections_per_host", 6));
+	ProjectSettings::get_singleton()->set_custom_property_info("network/limits/http/max_connections_per_host", PropertyInfo(Variant::INT, "network/limits/http/max_connections_per_host", PROPERTY_HINT_RANGE, "0,64"));
+	connection_pool->set_keep_alive_msec(uint64_t(int(GLOBAL_DEF("network/limits/http/keep_alive_timeout_seconds", 15))) * 1000);
+}
+
+void HTTPRequest::finish_connection_pool() {
+	if (connection_pool) {
+		memdelete(connection_pool);
+		connection_pool = nullptr;
+	}
+}
+
 HTTPRequest::HTTPRequest() {
 	thread = nullptr;
 
@@ -548,7 +714,15 @@ HTTPRequest::HTTPRequest() {
 	request_sent = false;
 	requesting = false;
 	client.instance();
+	download_chunk_size = client->get_read_chunk_size();
 	use_threads = false;
+	use_connection_pool = true;
+	has_connection_slot = false;
+	waiting_for_connection = false;
+	reused_connection = false;
+	body_streaming = false;
+	pending_body_chunks = 0;
+	body_chunk_generation = 0;
 	thread_done = false;
 	downloaded = 0;
 	body_size_limit = -1;
@@ -33,8 +33,11 @@
 
 #include "core/io/http_client.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "node.h"
+#include "scene/main/http_connection_pool.h"
 #include "scene/main/timer.h"
 
 class HTTPRequest : public Node {
@@ -59,6 +62,12 @@ public:
 	};
 
 private:
+	enum {
+		MAX_PENDING_BODY_CHUNKS = 8, // Threaded streaming stops reading when this many chunks wait to be emitted.
+	};
+
+	static HTTPConnectionPool *connection_pool; // Shared by all HTTPRequests.
+
 	bool requesting;
 
 	String request_string;
@@ -72,9 +81,21 @@ private:
 
 	bool request_sent;
 	Ref<HTTPClient> client;
+	mutable Mutex client_mutex; // The request thread swaps the client when taking one from the pool.
 	PackedByteArray body;
 	volatile bool use_threads;
 
+	bool use_connection_pool;
+	String pool_key;
+	bool has_connection_slot;
+	bool waiting_for_connection;
+	bool reused_connection;
+	int download_chunk_size;
+
+	bool body_streaming;
+	volatile uint32_t pending_body_chunks;
+	uint32_t body_chunk_generation; // Chunks deferred by a cancelled request are ignored.
+
 	bool got_response;
 	int response_code;
 	Vector<String> response_headers;
@@ -101,9 +122,14 @@ private:
 
 	Error _parse_url(const String &p_url);
 	Error _request();
+	Error _acquire_client();
+	void _release_client();
+	bool _retry_with_new_connection();
+	void _emit_body_chunk(const PackedByteArray &p_chunk, uint32_t p_generation);
 
 	volatile bool thread_done;
 	volatile bool thread_request_quit;
+	Semaphore thread_semaphore; // Posted when the request thread may be able to continue.
 
 	Thread *thread;
 
@@ -122,6 +148,12 @@ public:
 	void set_use_threads(bool p_use);
 	bool is_using_threads() const;
 
+	void set_use_connection_pool(bool p_use);
+	bool is_using_connection_pool() const;
+
+	void set_body_streaming(bool p_enabled);
+	bool is_body_streaming() const;
+
 	void set_download_file(const String &p_file);
 	String get_download_file() const;
 
@@ -144,6 +176,9 @@ public:
 	int get_downloaded_bytes() const;
 	int get_body_size() const;
 
+	static void init_connection_pool();
+	static void finish_connection_pool();
+
 	HTTPRequest();
 	~HTTPRequest();
 };
@@ -32,9 +32,11 @@
 
 #include "core/core_string_names.h"
 #include "core/io/resource_loader.h"
+#include "core/local_vector.h"
 #include "core/message_queue.h"
 #include "core/print_string.h"
 #include "instance_placeholder.h"
+#include "node_path_cache.h"
 #include "scene/debugger/scene_debugger.h"
 #include "scene/resources/packed_scene.h"
 #include "scene/scene_string_names.h"
@@ -49,6 +51,8 @@
 VARIANT_ENUM_CAST(Node::PauseMode);
 
 int Node::orphan_node_count = 0;
+uint64_t Node::node_path_cache_hits = 0;
+uint64_t Node::node_path_cache_misses = 0;
 
 void Node::_notification(int p_notification) {
 	switch (p_notification) {
@@ -79,6 +83,15 @@ void Node::_notification(int p_notification) {
 				data.pause_owner = this;
 			}
 
+			if (data.process_thread_group == -1) {
+				data.process_thread_group_resolved = data.parent ? data.parent->data.process_thread_group_resolved : 0;
+			} else {
+				data.process_thread_group_resolved = data.process_thread_group;
+			}
+			if (data.process_thread_group > 0) {
+				get_tree()->process_thread_group_nodes++;
+			}
+
 			if (data.input) {
 				add_to_group("_vp_input" + itos(get_viewport()->get_instance_id()));
 			}
@@ -111,16 +124,23 @@ void Node::_notification(int p_notification) {
 			}
 
 			data.pause_owner = nullptr;
+			if (data.process_thread_group > 0) {
+				get_tree()->process_thread_group_nodes--;
+			}
+			data.process_thread_group_resolved = 0;
 			if (data.path_cache) {
 				memdelete(data.path_cache);
 				data.path_cache = nullptr;
 			}
+			_clear_node_path_cache();
+			data.network_path_id = 0;
 		} break;
 		case NOTIFICATION_PATH_CHANGED: {
 			if (data.path_cache) {
 				memdelete(data.path_cache);
 				data.path_cache = nullptr;
 			}
+			data.network_path_id = 0;
 		} break;
 		case NOTIFICATION_READY: {
 			if (get_script_instance()) {
@@ -208,7 +228,7 @@ void Node::_propagate_enter_tree() {
 	data.inside_tree = true;
 
 	for (Map<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next()) {
-		E->get().group = data.tree->add_to_group(E->key(), this);
+		E->get().group = data.tree->add_to_group(E->key(), this, &E->get().index);
 	}
 
 	notification(NOTIFICATION_ENTER_TREE);
@@ -274,7 +294,7 @@ void Node::_propagate_exit_tree() {
 	// exit groups
 
 	for (Map<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next()) {
-		data.tree->remove_from_group(E->key(), this);
+		data.tree->remove_from_group(E->key(), this, &E->get().index);
 		E->get().group = nullptr;
 	}
 
@@ -295,6 +315,7 @@ void Node::move_child(Node *p_child, int p_pos) {
 	ERR_FAIL_INDEX_MSG(p_pos, data.children.size() + 1, "Invalid new child position: " + itos(p_pos) + ".");
 	ERR_FAIL_COND_MSG(p_child->data.parent != this, "Child is not a child of this node.");
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, move_child() failed. Consider using call_deferred(\"move_child\") instead (or \"popup\" if this is from a popup).");
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_thread_groups(), "Can't move children while process thread groups are being processed. Consider using call_deferred(\"move_child\") instead.");
 
 	// Specifying one place beyond the end
 	// means the same as moving to the last position
@@ -302,37 +323,48 @@ void Node::move_child(Node *p_child, int p_pos) {
 		p_pos--;
 	}
 
-	if (p_child->data.pos == p_pos) {
+	int from_pos = p_child->data.pos;
+	if (from_pos < 0 || from_pos >= data.children.size() || data.children[from_pos] != p_child) {
+		from_pos = p_child->get_index(); // Stale, renumber first.
+	}
+	if (from_pos == p_pos) {
 		return; //do nothing
 	}
 
-	int motion_from = MIN(p_pos, p_child->data.pos);
-	int motion_to = MAX(p_pos, p_child->data.pos);
-
-	data.children.remove(p_child->data.pos);
+	data.children.remove(from_pos);
 	data.children.insert(p_pos, p_child);
 
 	if (data.tree) {
 		data.tree->tree_changed();
 	}
 
-	data.blocked++;
-	//new pos first
-	for (int i = motion_from; i <= motion_to; i++) {
-		data.children[i]->data.pos = i;
+	// Like in remove_child(), the siblings in between are renumbered and notified
+	// lazily, so moving many children around doesn't cost a pass over the range each.
+	int motion_from = MIN(p_pos, from_pos);
+	if (data.children_pos_dirty < 0 || motion_from < data.children_pos_dirty) {
+		data.children_pos_dirty = motion_from;
 	}
-	// notification second
+
+	data.blocked++;
+	p_child->data.pos = p_pos;
 	move_child_notify(p_child);
-	for (int i = motion_from; i <= motion_to; i++) {
-		data.children[i]->notification(NOTIFICATION_MOVED_IN_PARENT);
-	}
-	for (const Map<StringName, GroupData>::Element *E = p_child->data.grouped.front(); E; E = E->next()) {
+	p_child->notification(NOTIFICATION_MOVED_IN_PARENT);
+	// Groups are kept in tree order as nodes are added, and the whole subtree moved
+	// relative to the rest, so every group with a node in it must be sorted again.
+	p_child->_propagate_groups_changed();
+
+	data.blocked--;
+}
+
+void Node::_propagate_groups_changed() {
+	for (const Map<StringName, GroupData>::Element *E = data.grouped.front(); E; E = E->next()) {
 		if (E->get().group) {
 			E->get().group->changed = true;
 		}
 	}
-
-	data.blocked--;
+	for (int i = 0; i < data.children.size(); i++) {
+		data.children[i]->_propagate_groups_changed();
+	}
 }
 
 void Node::raise() {
@@ -401,11 +433,20 @@ void Node::set_pause_mode(PauseMode p_mode) {
 	}
 
 	bool prev_inherits = data.pause_mode == PAUSE_MODE_INHERIT;
+	bool prev_can_process = is_inside_tree() && can_process();
 	data.pause_mode = p_mode;
 	if (!is_inside_tree()) {
 		return; //pointless
 	}
-	if ((data.pause_mode == PAUSE_MODE_INHERIT) == prev_inherits) {
+
+	// While the tree is paused, the nodes that stop or resume processing are told so,
+	// like when the tree itself is paused (timers reschedule on it, for instance).
+	int pause_notification = 0;
+	if (can_process() != prev_can_process) {
+		pause_notification = prev_can_process ? NOTIFICATION_PAUSED : NOTIFICATION_UNPAUSED;
+	}
+
+	if ((data.pause_mode == PAUSE_MODE_INHERIT) == prev_inherits && !pause_notification) {
 		return; ///nothing changed
 	}
 
@@ -419,20 +460,23 @@ void Node::set_pause_mode(PauseMode p_mode) {
 		owner = this;
 	}
 
-	_propagate_pause_owner(owner);
+	_propagate_pause_owner(owner, pause_notification);
 }
 
 Node::PauseMode Node::get_pause_mode() const {
 	return data.pause_mode;
 }
 
-void Node::_propagate_pause_owner(Node *p_owner) {
+void Node::_propagate_pause_owner(Node *p_owner, int p_notification) {
 	if (this != p_owner && data.pause_mode != PAUSE_MODE_INHERIT) {
 		return;
 	}
 	data.pause_owner = p_owner;
+	if (p_notification) {
+		notification(p_notification);
+	}
 	for (int i = 0; i < data.children.size(); i++) {
-		data.children[i]->_propagate_pause_owner(p_owner);
+		data.children[i]->_propagate_pause_owner(p_owner, p_notification);
 	}
 }
 
@@ -466,7 +510,7 @@ uint16_t Node::rpc_config(const StringName &p_method, MultiplayerAPI::RPCMode p_
 		nd.name = p_method;
 		nd.mode = p_mode;
 		data.rpc_methods.push_back(nd);
-		return ((uint16_t)data.rpc_properties.size() - 1) | (1 << 15);
+		return ((uint16_t)data.rpc_methods.size() - 1) | (1 << 15);
 	} else {
 		int c_mid = (~(1 << 15)) & mid;
 		data.rpc_methods.write[c_mid].mode = p_mode;
@@ -474,6 +518,39 @@ uint16_t Node::rpc_config(const StringName &p_method, MultiplayerAPI::RPCMode p_
 	}
 }
 
+void Node::rpc_config_signature(const StringName &p_method, const Vector<MultiplayerAPI::RPCArgument> &p_signature) {
+	if (p_signature.empty()) {
+		data.rpc_signatures.erase(p_method);
+		return;
+	}
+	for (int i = 0; i < p_signature.size(); i++) {
+		const MultiplayerAPI::RPCArgument &arg = p_signature[i];
+		ERR_FAIL_COND_MSG(arg.bits < 0 || arg.bits > 32, "RPC argument bits must be between 0 and 32.");
+		ERR_FAIL_COND_MSG(arg.bits > 0 && arg.type != Variant::INT && arg.min >= arg.max, "Quantized RPC arguments need a min lower than max.");
+	}
+	data.rpc_signatures[p_method] = p_signature;
+}
+
+void Node::_rpc_config_signature_bind(const StringName &p_method, const Array &p_signature) {
+	Vector<MultiplayerAPI::RPCArgument> signature;
+	signature.resize(p_signature.size());
+	for (int i = 0; i < p_signature.size(); i++) {
+		MultiplayerAPI::RPCArgument &arg = signature.write[i];
+		if (p_signature[i].get_type() == Variant::DICTIONARY) {
+			Dictionary d = p_signature[i];
+			arg.type = Variant::Type(int(d.get("type", Variant::NIL)));
+			arg.min = d.get("min", 0.0);
+			arg.max = d.get("max", 0.0);
+			arg.bits = d.get("bits", 0);
+		} else {
+			ERR_FAIL_COND_MSG(p_signature[i].get_type() != Variant::INT, "RPC signature entries must be a type or a Dictionary.");
+			arg.type = Variant::Type(int(p_signature[i]));
+		}
+		ERR_FAIL_INDEX_MSG(arg.type, Variant::VARIANT_MAX, "Invalid RPC argument type.");
+	}
+	rpc_config_signature(p_method, signature);
+}
+
 uint16_t Node::rset_config(const StringName &p_property, MultiplayerAPI::RPCMode p_mode) {
 	uint16_t pid = get_node_rset_property_id(p_property);
 	if (pid == UINT16_MAX) {
@@ -735,6 +812,11 @@ MultiplayerAPI::RPCMode Node::get_node_rpc_mode(const StringName &p_method) cons
 	return get_node_rpc_mode_by_id(get_node_rpc_method_id(p_method));
 }
 
+const Vector<MultiplayerAPI::RPCArgument> *Node::get_node_rpc_signature(const StringName &p_method) const {
+	const Map<StringName, Vector<MultiplayerAPI::RPCArgument>>::Element *E = data.rpc_signatures.find(p_method);
+	return E ? &E->get() : nullptr;
+}
+
 uint16_t Node::get_node_rset_property_id(const StringName &p_property) const {
 	for (int i = 0; i < data.rpc_properties.size(); i++) {
 		if (data.rpc_properties[i].name == p_property) {
@@ -789,9 +871,37 @@ String Node::get_rpc_md5() const {
 			rpc_list += String(rpc[i].name);
 		}
 	}
+	// Typed arguments are decoded with the receiver's signature, so both sides must agree on it.
+	// StringName order depends on the process, so sort by name first.
+	Vector<String> signatures;
+	for (const Map<StringName, Vector<MultiplayerAPI::RPCArgument>>::Element *E = data.rpc_signatures.front(); E; E = E->next()) {
+		String signature = String(E->key()) + "(";
+		for (int i = 0; i < E->get().size(); i++) {
+			const MultiplayerAPI::RPCArgument &arg = E->get()[i];
+			signature += vformat("%d:%s:%s:%d,", arg.type, rtos(arg.min), rtos(arg.max), arg.bits);
+		}
+		signatures.push_back(signature + ")");
+	}
+	signatures.sort();
+	for (int i = 0; i < signatures.size(); i++) {
+		rpc_list += signatures[i];
+	}
 	return rpc_list.md5_text();
 }
 
+int Node::get_network_path_id(ObjectID p_multiplayer, uint32_t p_epoch) const {
+	if (data.network_path_api != p_multiplayer || data.network_path_epoch != p_epoch) {
+		return 0;
+	}
+	return data.network_path_id;
+}
+
+void Node::set_network_path_id(ObjectID p_multiplayer, uint32_t p_epoch, int p_id) const {
+	data.network_path_api = p_multiplayer;
+	data.network_path_epoch = p_epoch;
+	data.network_path_id = p_id;
+}
+
 bool Node::can_process_notification(int p_what) const {
 	switch (p_what) {
 		case NOTIFICATION_PHYSICS_PROCESS:
@@ -920,6 +1030,47 @@ int Node::get_process_priority() const {
 	return data.process_priority;
 }
 
+void Node::set_process_thread_group(int p_group) {
+	ERR_FAIL_COND_MSG(p_group < -1, "Invalid process thread group, use -1 to inherit it from the parent and 0 for the main thread.");
+	if (data.process_thread_group == p_group) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_thread_groups(), "Can't change process thread groups while they are being processed. Consider using call_deferred(\"set_process_thread_group\", group) instead.");
+
+	if (data.tree) {
+		if (data.process_thread_group > 0) {
+			data.tree->process_thread_group_nodes--;
+		}
+		if (p_group > 0) {
+			data.tree->process_thread_group_nodes++;
+		}
+	}
+
+	data.process_thread_group = p_group;
+	if (!is_inside_tree()) {
+		return;
+	}
+
+	int group = p_group;
+	if (group == -1) {
+		group = data.parent ? data.parent->data.process_thread_group_resolved : 0;
+	}
+	_propagate_process_thread_group(group);
+}
+
+int Node::get_process_thread_group() const {
+	return data.process_thread_group;
+}
+
+void Node::_propagate_process_thread_group(int p_group) {
+	data.process_thread_group_resolved = p_group;
+	for (int i = 0; i < data.children.size(); i++) {
+		if (data.children[i]->data.process_thread_group == -1) {
+			data.children[i]->_propagate_process_thread_group(p_group);
+		}
+	}
+}
+
 void Node::set_process_input(bool p_enable) {
 	if (p_enable == data.input) {
 		return;
@@ -986,7 +1137,12 @@ StringName Node::get_name() const {
 }
 
 void Node::_set_name_nocheck(const StringName &p_name) {
+	StringName old_name = data.name;
 	data.name = p_name;
+
+	if (data.parent) {
+		data.parent->_child_renamed(this, old_name);
+	}
 }
 
 String Node::invalid_character = ". : @ / \"";
@@ -1007,10 +1163,12 @@ void Node::set_name(const String &p_name) {
 	_validate_node_name(name);
 
 	ERR_FAIL_COND(name == "");
+	StringName old_name = data.name;
 	data.name = name;
 
 	if (data.parent) {
 		data.parent->_validate_child_name(this);
+		data.parent->_child_renamed(this, old_name);
 	}
 
 	propagate_notification(NOTIFICATION_PATH_CHANGED);
@@ -1063,18 +1221,7 @@ void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
 			unique = false;
 		} else {
 			//check if exists
-			Node **children = data.children.ptrw();
-			int cc = data.children.size();
-
-			for (int i = 0; i < cc; i++) {
-				if (children[i] == p_child) {
-					continue;
-				}
-				if (children[i]->data.name == p_child->data.name) {
-					unique = false;
-					break;
-				}
-			}
+			unique = !_has_child_named(p_child->data.name, p_child);
 		}
 
 		if (!unique) {
@@ -1130,25 +1277,9 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 		}
 	}
 
-	//quickly test if proposed name exists
-	int cc = data.children.size(); //children count
-	const Node *const *children_ptr = data.children.ptr();
-
-	{
-		bool exists = false;
-
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) { //exclude self in renaming if its already a child
-				continue;
-			}
-			if (children_ptr[i]->data.name == name) {
-				exists = true;
-			}
-		}
-
-		if (!exists) {
-			return; //if it does not exist, it does not need validation
-		}
+	//quickly test if proposed name exists, excluding self in renaming if its already a child
+	if (!_has_child_named(name, p_child)) {
+		return; //if it does not exist, it does not need validation
 	}
 
 	// Extract trailing number
@@ -1173,41 +1304,45 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 		nums = "";
 	}
 
-	for (;;) {
-		StringName attempt = name_string + nums;
-		bool exists = false;
+	// The name itself is taken, as checked above.
+	if (nums.length() == 0) {
+		// Name was undecorated so skip to 2 for a more natural result
+		nums = "2";
+		name_string += nnsep; // Add separator because nums.length() > 0 was false
+	} else {
+		nums = increase_numeric_string(nums);
+	}
 
-		for (int i = 0; i < cc; i++) {
-			if (children_ptr[i] == p_child) {
-				continue;
-			}
-			if (children_ptr[i]->data.name == attempt) {
-				exists = true;
-			}
+	// Continue after the last number handed out for this base name, instead of trying
+	// every taken one again, which made adding many nodes of the same name quadratic.
+	if (data.child_serial_suffixes) {
+		const String *last = data.child_serial_suffixes->getptr(name_string);
+		if (last && last->to_int() >= nums.to_int()) {
+			nums = increase_numeric_string(*last);
 		}
+	}
 
-		if (!exists) {
-			name = attempt;
-			return;
-		} else {
-			if (nums.length() == 0) {
-				// Name was undecorated so skip to 2 for a more natural result
-				nums = "2";
-				name_string += nnsep; // Add separator because nums.length() > 0 was false
-			} else {
-				nums = increase_numeric_string(nums);
-			}
-		}
+	while (_has_child_named(name_string + nums, p_child)) {
+		nums = increase_numeric_string(nums);
+	}
+
+	if (!data.child_serial_suffixes) {
+		data.child_serial_suffixes = memnew((HashMap<String, String>));
 	}
+	data.child_serial_suffixes->set(name_string, nums);
+	name = name_string + nums;
 }
 
 void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 	//add a child node quickly, without name validation
 
+	// Siblings past children_pos_dirty keep their stale positions until an index is
+	// needed, the new child is already correct.
 	p_child->data.name = p_name;
 	p_child->data.pos = data.children.size();
 	data.children.push_back(p_child);
 	p_child->data.parent = this;
+	_child_name_index_add(p_child);
 	p_child->notification(NOTIFICATION_PARENTED);
 
 	if (data.tree) {
@@ -1225,6 +1360,7 @@ void Node::add_child(Node *p_child, bool p_legible_unique_name) {
 	ERR_FAIL_COND_MSG(p_child == this, "Can't add child '" + p_child->get_name() + "' to itself."); // adding to itself!
 	ERR_FAIL_COND_MSG(p_child->data.parent, "Can't add child '" + p_child->get_name() + "' to '" + get_name() + "', already has a parent '" + p_child->data.parent->get_name() + "'."); //Fail if node has a parent
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, add_node() failed. Consider using call_deferred(\"add_child\", child) instead.");
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_thread_groups(), "Can't add children to the scene tree while process thread groups are being processed. Consider using call_deferred(\"add_child\", child) instead.");
 
 	/* Validate name */
 	_validate_child_name(p_child, p_legible_unique_name);
@@ -1269,6 +1405,7 @@ void Node::_propagate_validate_owner() {
 void Node::remove_child(Node *p_child) {
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, remove_node() failed. Consider using call_deferred(\"remove_child\", child) instead.");
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_thread_groups(), "Can't remove children from the scene tree while process thread groups are being processed. Consider using call_deferred(\"remove_child\", child) instead.");
 
 	int child_count = data.children.size();
 	Node **children = data.children.ptrw();
@@ -1280,6 +1417,17 @@ void Node::remove_child(Node *p_child) {
 		}
 	}
 
+	if (idx == -1 && data.children_pos_dirty >= 0) {
+		// Positions past the first pending removal are stale, and children only
+		// shift down after it, so look from there first.
+		for (int i = data.children_pos_dirty; i < child_count; i++) {
+			if (children[i] == p_child) {
+				idx = i;
+				break;
+			}
+		}
+	}
+
 	if (idx == -1) { //maybe removed while unparenting or something and index was not updated, so just in case the above fails, try this.
 		for (int i = 0; i < child_count; i++) {
 			if (children[i] == p_child) {
@@ -1301,14 +1449,24 @@ void Node::remove_child(Node *p_child) {
 	p_child->notification(NOTIFICATION_UNPARENTED);
 
 	data.children.remove(idx);
+	_child_name_index_remove(p_child, p_child->data.name);
+	if (data.children.empty() && data.child_serial_suffixes) {
+		// Numbering can start over.
+		memdelete(data.child_serial_suffixes);
+		data.child_serial_suffixes = nullptr;
+	}
 
-	//update pointer and size
-	child_count = data.children.size();
-	children = data.children.ptrw();
+	if (data.tree) {
+		// The child could have been looked up (and cached) from the notifications above,
+		// after exiting the tree bumped the version.
+		data.tree->tree_version++;
+	}
 
-	for (int i = idx; i < child_count; i++) {
-		children[i]->data.pos = i;
-		children[i]->notification(NOTIFICATION_MOVED_IN_PARENT);
+	// Later siblings keep their relative order, so renumbering them (and sending
+	// NOTIFICATION_MOVED_IN_PARENT) is deferred until an index is needed again.
+	// This keeps removing many children from a large parent linear overall.
+	if (idx < data.children.size() && (data.children_pos_dirty < 0 || idx < data.children_pos_dirty)) {
+		data.children_pos_dirty = idx;
 	}
 
 	p_child->data.parent = nullptr;
@@ -1336,6 +1494,14 @@ Node *Node::get_child(int p_index) const {
 }
 
 Node *Node::_get_child_by_name(const StringName &p_name) const {
+	if (data.child_name_index || (_can_build_child_name_index() && _build_child_name_index())) {
+		Node *const *child = data.child_name_index->getptr(p_name);
+		if (child && (*child)->data.name == p_name) {
+			return *child;
+		}
+		return nullptr;
+	}
+
 	int cc = data.children.size();
 	Node *const *cd = data.children.ptr();
 
@@ -1348,13 +1514,121 @@ Node *Node::_get_child_by_name(const StringName &p_name) const {
 	return nullptr;
 }
 
-Node *Node::get_node_or_null(const NodePath &p_path) const {
-	if (p_path.is_empty()) {
-		return nullptr;
+bool Node::_has_child_named(const StringName &p_name, const Node *p_exclude) const {
+	if (data.child_name_index || (_can_build_child_name_index() && _build_child_name_index())) {
+		Node *const *child = data.child_name_index->getptr(p_name);
+		return child && *child != p_exclude && (*child)->data.name == p_name;
 	}
 
-	ERR_FAIL_COND_V_MSG(!data.inside_tree && p_path.is_absolute(), nullptr, "Can't use get_node() with absolute paths from outside the active scene tree.");
+	int cc = data.children.size();
+	Node *const *cd = data.children.ptr();
 
+	for (int i = 0; i < cc; i++) {
+		if (cd[i] != p_exclude && cd[i]->data.name == p_name) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Node::_can_build_child_name_index() const {
+	// Lookups may run concurrently while process thread groups are processed, so
+	// the index is only built from the main thread.
+	return data.children.size() >= CHILD_NAME_INDEX_THRESHOLD && !(data.tree && data.tree->is_processing_thread_groups());
+}
+
+bool Node::_build_child_name_index() const {
+	ERR_FAIL_COND_V(data.child_name_index, true);
+
+	HashMap<StringName, Node *> *index = memnew((HashMap<StringName, Node *>));
+	int cc = data.children.size();
+	Node *const *cd = data.children.ptr();
+
+	for (int i = 0; i < cc; i++) {
+		if (index->has(cd[i]->data.name)) {
+			// Duplicate names can only come from unchecked additions, keep scanning linearly.
+			memdelete(index);
+			return false;
+		}
+		index->set(cd[i]->data.name, cd[i]);
+	}
+
+	data.child_name_index = index;
+	return true;
+}
+
+void Node::_child_name_index_add(Node *p_child) {
+	if (!data.child_name_index) {
+		return;
+	}
+
+	if (data.child_name_index->has(p_child->data.name)) {
+		memdelete(data.child_name_index);
+		data.child_name_index = nullptr;
+		return;
+	}
+
+	data.child_name_index->set(p_child->data.name, p_child);
+}
+
+void Node::_child_name_index_remove(Node *p_child, const StringName &p_name) {
+	if (!data.child_name_index) {
+		return;
+	}
+
+	if (data.children.size() < CHILD_NAME_INDEX_THRESHOLD / 2) {
+		memdelete(data.child_name_index);
+		data.child_name_index = nullptr;
+		return;
+	}
+
+	Node **child = data.child_name_index->getptr(p_name);
+	if (child && *child == p_child) {
+		data.child_name_index->erase(p_name);
+	}
+}
+
+void Node::_child_renamed(Node *p_child, const StringName &p_old_name) {
+	if (!data.child_name_index) {
+		return;
+	}
+
+	Node **child = data.child_name_index->getptr(p_old_name);
+	if (child && *child == p_child) {
+		data.child_name_index->erase(p_old_name);
+	}
+	_child_name_index_add(p_child);
+}
+
+void Node::_update_children_pos() const {
+	if (data.children_pos_dirty < 0) {
+		return;
+	}
+
+	int from = data.children_pos_dirty;
+	data.children_pos_dirty = -1;
+
+	int cc = data.children.size();
+	Node *const *cd = data.children.ptr();
+
+	// Children moved with move_child() already hold their index, and the ones past
+	// the moved range never changed, so only the others are notified.
+	LocalVector<Node *> moved;
+	//new pos first
+	for (int i = from; i < cc; i++) {
+		if (cd[i]->data.pos != i) {
+			cd[i]->data.pos = i;
+			moved.push_back(cd[i]);
+		}
+	}
+	// notification second
+	for (uint32_t i = 0; i < moved.size(); i++) {
+		moved[i]->notification(NOTIFICATION_MOVED_IN_PARENT);
+	}
+}
+
+Node *Node::_resolve_node_path(const NodePath &p_path) const {
 	Node *current = nullptr;
 	Node *root = nullptr;
 
@@ -1388,16 +1662,7 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 			}
 
 		} else {
-			next = nullptr;
-
-			for (int j = 0; j < current->data.children.size(); j++) {
-				Node *child = current->data.children[j];
-
-				if (child->data.name == name) {
-					next = child;
-					break;
-				}
-			}
+			next = current->_get_child_by_name(name);
 			if (next == nullptr) {
 				return nullptr;
 			};
@@ -1408,6 +1673,50 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 	return current;
 }
 
+void Node::_clear_node_path_cache() const {
+	if (data.node_path_cache) {
+		memdelete(data.node_path_cache);
+		data.node_path_cache = nullptr;
+	}
+}
+
+Node *Node::get_node_or_null(const NodePath &p_path) const {
+	if (p_path.is_empty()) {
+		return nullptr;
+	}
+
+	ERR_FAIL_COND_V_MSG(!data.inside_tree && p_path.is_absolute(), nullptr, "Can't use get_node() with absolute paths from outside the active scene tree.");
+
+	// Adding, removing, moving or renaming nodes bumps the tree version, after which cached entries are checked again.
+	// The cache is not used while process thread groups run, as several threads may resolve paths from the same node.
+	bool use_cache = data.inside_tree && !data.tree->is_processing_thread_groups();
+	if (use_cache) {
+		Node *cached = nullptr;
+		if (data.node_path_cache && data.node_path_cache->lookup(this, p_path, data.tree->tree_version, cached)) {
+			node_path_cache_hits++;
+			return cached;
+		}
+		node_path_cache_misses++;
+	}
+
+	Node *current = _resolve_node_path(p_path);
+
+	if (use_cache) {
+		if (!data.node_path_cache) {
+			data.node_path_cache = memnew(NodePathCache);
+		}
+		data.node_path_cache->store(p_path, current, data.tree->tree_version);
+	}
+
+#ifdef DEBUG_ENABLED
+	if (current && data.tree && data.tree->is_processing_thread_groups() && current->data.process_thread_group_resolved != data.process_thread_group_resolved) {
+		ERR_PRINT_ONCE("Node '" + String(current->get_name()) + "' was accessed from another process thread group while groups are being processed, this is not thread safe. Use call_deferred() to reach nodes in other groups.");
+	}
+#endif
+
+	return current;
+}
+
 Node *Node::get_node(const NodePath &p_path) const {
 	Node *node = get_node_or_null(p_path);
 	ERR_FAIL_COND_V_MSG(!node, nullptr, "Node not found: " + p_path + ".");
@@ -1496,7 +1805,7 @@ bool Node::is_greater_than(const Node *p_node) const {
 	int idx = data.depth - 1;
 	while (n) {
 		ERR_FAIL_INDEX_V(idx, data.depth, false);
-		this_stack[idx--] = n->data.pos;
+		this_stack[idx--] = n->get_index();
 		n = n->data.parent;
 	}
 	ERR_FAIL_COND_V(idx != -1, false);
@@ -1504,7 +1813,7 @@ bool Node::is_greater_than(const Node *p_node) const {
 	idx = p_node->data.depth - 1;
 	while (n) {
 		ERR_FAIL_INDEX_V(idx, p_node->data.depth, false);
-		that_stack[idx--] = n->data.pos;
+		that_stack[idx--] = n->get_index();
 
 		n = n->data.parent;
 	}
@@ -1702,18 +2011,18 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 	if (data.grouped.has(p_identifier)) {
 		return;
 	}
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_thread_groups(), "Can't change groups while process thread groups are being processed (this includes set_process() and similar). Consider using call_deferred() instead.");
 
-	GroupData gd;
+	// Inserted first, the tree keeps a pointer to the index stored in it.
+	GroupData &gd = data.grouped[p_identifier];
 
 	if (data.tree) {
-		gd.group = data.tree->add_to_group(p_identifier, this);
+		gd.group = data.tree->add_to_group(p_identifier, this, &gd.index);
 	} else {
 		gd.group = nullptr;
 	}
 
 	gd.persistent = p_persistent;
-
-	data.grouped[p_identifier] = gd;
 }
 
 void Node::remove_from_group(const StringName &p_identifier) {
@@ -1722,9 +2031,10 @@ void Node::remove_from_group(const StringName &p_identifier) {
 	Map<StringName, GroupData>::Element *E = data.grouped.find(p_identifier);
 
 	ERR_FAIL_COND(!E);
+	ERR_FAIL_COND_MSG(data.tree && data.tree->is_processing_thread_groups(), "Can't change groups while process thread groups are being processed (this includes set_process() and similar). Consider using call_deferred() instead.");
 
 	if (data.tree) {
-		data.tree->remove_from_group(E->key(), this);
+		data.tree->remove_from_group(E->key(), this, &E->get().index);
 	}
 
 	data.grouped.erase(E);
@@ -1856,7 +2166,17 @@ void Node::_propagate_replace_owner(Node *p_owner, Node *p_by_owner) {
 	data.blocked--;
 }
 
+// Positions are renumbered lazily after removals and moves. If this node's may be
+// stale, its siblings are renumbered first, which sends NOTIFICATION_MOVED_IN_PARENT
+// to the ones whose index changed.
 int Node::get_index() const {
+	if (data.parent && data.parent->data.children_pos_dirty >= 0 && data.pos >= data.parent->data.children_pos_dirty) {
+		if (data.tree && data.tree->is_processing_thread_groups()) {
+			// Renumbering notifies siblings, which other threads may be processing, so only look it up.
+			return data.parent->data.children.find(const_cast<Node *>(this), data.parent->data.children_pos_dirty);
+		}
+		data.parent->_update_children_pos();
+	}
 	return data.pos;
 }
 
@@ -2387,7 +2707,7 @@ void Node::replace_by(Node *p_node, bool p_keep_data) {
 	}
 
 	Node *parent = data.parent;
-	int pos_in_parent = data.pos;
+	int pos_in_parent = get_index();
 
 	if (data.parent) {
 		parent->remove_child(this);
@@ -2609,10 +2929,16 @@ void Node::print_stray_nodes() {
 }
 
 void Node::queue_delete() {
+	// SceneTree::queue_delete() locks, so this is also safe from process thread groups.
 	if (is_inside_tree()) {
 		get_tree()->queue_delete(this);
-	} else {
+	} else if (SceneTree::get_singleton()) {
 		SceneTree::get_singleton()->queue_delete(this);
+	} else {
+		// No SceneTree runs the main loop, so free it when the message queue is flushed.
+		ERR_FAIL_COND_MSG(!MessageQueue::get_singleton(), "Can't queue nodes for deletion without a SceneTree or a MessageQueue.");
+		_is_queued_for_deletion = true;
+		MessageQueue::get_singleton()->push_call(this, CoreStringNames::get_singleton()->_free);
 	}
 }
 
@@ -2760,6 +3086,8 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process", "enable"), &Node::set_process);
 	ClassDB::bind_method(D_METHOD("set_process_priority", "priority"), &Node::set_process_priority);
 	ClassDB::bind_method(D_METHOD("get_process_priority"), &Node::get_process_priority);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group", "group"), &Node::set_process_thread_group);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
 	ClassDB::bind_method(D_METHOD("is_processing"), &Node::is_processing);
 	ClassDB::bind_method(D_METHOD("set_process_input", "enable"), &Node::set_process_input);
 	ClassDB::bind_method(D_METHOD("is_processing_input"), &Node::is_processing_input);
@@ -2805,6 +3133,7 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_custom_multiplayer", "api"), &Node::set_custom_multiplayer);
 	ClassDB::bind_method(D_METHOD("rpc_config", "method", "mode"), &Node::rpc_config);
 	ClassDB::bind_method(D_METHOD("rset_config", "property", "mode"), &Node::rset_config);
+	ClassDB::bind_method(D_METHOD("rpc_config_signature", "method", "signature"), &Node::_rpc_config_signature_bind);
 
 	ClassDB::bind_method(D_METHOD("_set_editor_description", "editor_description"), &Node::set_editor_description);
 	ClassDB::bind_method(D_METHOD("_get_editor_description"), &Node::get_editor_description);
@@ -2898,6 +3227,7 @@ void Node::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "multiplayer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerAPI", 0), "", "get_multiplayer");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "custom_multiplayer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerAPI", 0), "set_custom_multiplayer", "get_custom_multiplayer");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_RANGE, "-1,1024,1,or_greater"), "set_process_thread_group", "get_process_thread_group");
 
 	BIND_VMETHOD(MethodInfo("_process", PropertyInfo(Variant::FLOAT, "delta")));
 	BIND_VMETHOD(MethodInfo("_physics_process", PropertyInfo(Variant::FLOAT, "delta")));
@@ -2926,6 +3256,9 @@ String Node::_get_name_num_separator() {
 
 Node::Node() {
 	data.pos = -1;
+	data.children_pos_dirty = -1;
+	data.child_name_index = nullptr;
+	data.child_serial_suffixes = nullptr;
 	data.depth = -1;
 	data.blocked = 0;
 	data.parent = nullptr;
@@ -2933,6 +3266,8 @@ Node::Node() {
 	data.physics_process = false;
 	data.idle_process = false;
 	data.process_priority = 0;
+	data.process_thread_group = -1;
+	data.process_thread_group_resolved = 0;
 	data.physics_process_internal = false;
 	data.idle_process_internal = false;
 	data.inside_tree = false;
@@ -2947,6 +3282,9 @@ Node::Node() {
 	data.pause_owner = nullptr;
 	data.network_master = 1; //server by default
 	data.path_cache = nullptr;
+	data.node_path_cache = nullptr;
+	data.network_path_epoch = 0;
+	data.network_path_id = 0;
 	data.parent_owned = false;
 	data.in_constructor = true;
 	data.viewport = nullptr;
@@ -2962,6 +3300,14 @@ Node::~Node() {
 	data.owned.clear();
 	data.children.clear();
 
+	if (data.child_name_index) {
+		memdelete(data.child_name_index);
+	}
+	if (data.child_serial_suffixes) {
+		memdelete(data.child_serial_suffixes);
+	}
+	_clear_node_path_cache();
+
 	ERR_FAIL_COND(data.parent);
 	ERR_FAIL_COND(data.children.size());
 
@@ -40,6 +40,7 @@
 #include "core/typed_array.h"
 #include "scene/main/scene_tree.h"
 
+class NodePathCache;
 class Viewport;
 class SceneState;
 class Node : public Object {
@@ -74,12 +75,19 @@ public:
 	};
 
 	static int orphan_node_count;
+	static uint64_t node_path_cache_hits;
+	static uint64_t node_path_cache_misses;
 
 private:
 	struct GroupData {
 		bool persistent;
 		SceneTree::Group *group;
-		GroupData() { persistent = false; }
+		int index; // Position in group->nodes, maintained by SceneTree.
+		GroupData() {
+			persistent = false;
+			group = nullptr;
+			index = -1;
+		}
 	};
 
 	struct NetData {
@@ -98,6 +106,9 @@ private:
 		Node *owner;
 		Vector<Node *> children; // list of children
 		int pos;
+		mutable int children_pos_dirty; // first child whose pos may be stale after removals or moves, -1 if none
+		mutable HashMap<StringName, Node *> *child_name_index; // built lazily for nodes with many children
+		mutable HashMap<String, String> *child_serial_suffixes; // last number given to a child per base name
 		int depth;
 		int blocked; // safeguard that throws an error when attempting to modify the tree in a harmful way while being traversed.
 		StringName name;
@@ -121,12 +132,15 @@ private:
 		int network_master;
 		Vector<NetData> rpc_methods;
 		Vector<NetData> rpc_properties;
+		Map<StringName, Vector<MultiplayerAPI::RPCArgument>> rpc_signatures;
 
 		// variables used to properly sort the node when processing, ignored otherwise
 		//should move all the stuff below to bits
 		bool physics_process;
 		bool idle_process;
 		int process_priority;
+		int process_thread_group; // -1 inherits, 0 is the main thread.
+		int process_thread_group_resolved;
 
 		bool physics_process_internal;
 		bool idle_process_internal;
@@ -143,6 +157,14 @@ private:
 
 		mutable NodePath *path_cache;
 
+		// Results of get_node() while inside the tree, valid as long as the tree version matches.
+		mutable NodePathCache *node_path_cache;
+
+		// ID this node's path was given by a MultiplayerAPI, dropped along with path_cache.
+		mutable ObjectID network_path_api;
+		mutable uint32_t network_path_epoch;
+		mutable int network_path_id;
+
 	} data;
 
 	enum NameCasing {
@@ -156,7 +178,21 @@ private:
 	void _print_tree_pretty(const String &prefix, const bool last);
 	void _print_tree(const Node *p_node);
 
+	enum {
+		CHILD_NAME_INDEX_THRESHOLD = 64
+	};
+
+	Node *_resolve_node_path(const NodePath &p_path) const;
+	void _clear_node_path_cache() const;
+
 	Node *_get_child_by_name(const StringName &p_name) const;
+	bool _has_child_named(const StringName &p_name, const Node *p_exclude) const;
+	bool _can_build_child_name_index() const;
+	bool _build_child_name_index() const;
+	void _child_name_index_add(Node *p_child);
+	void _child_name_index_remove(Node *p_child, const StringName &p_name);
+	void _child_renamed(Node *p_child, const StringName &p_old_name);
+	void _update_children_pos() const;
 
 	void _replace_connections_target(Node *p_new_target);
 
@@ -171,7 +207,9 @@ private:
 	void _propagate_after_exit_tree();
 	void _propagate_validate_owner();
 	void _print_stray_nodes();
-	void _propagate_pause_owner(Node *p_owner);
+	void _propagate_pause_owner(Node *p_owner, int p_notification = 0);
+	void _propagate_process_thread_group(int p_group);
+	void _propagate_groups_changed();
 	Array _get_node_and_resource(const NodePath &p_path);
 
 	void _duplicate_signals(const Node *p_original, Node *p_copy) const;
@@ -185,6 +223,7 @@ private:
 	Variant _rpc_unreliable_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant _rpc_id_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant _rpc_unreliable_id_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	void _rpc_config_signature_bind(const StringName &p_method, const Array &p_signature);
 
 	friend class SceneTree;
 
@@ -357,6 +396,10 @@ public:
 	void set_process_priority(int p_priority);
 	int get_process_priority() const;
 
+	void set_process_thread_group(int p_group);
+	int get_process_thread_group() const;
+	_FORCE_INLINE_ int get_process_thread_group_resolved() const { return data.process_thread_group_resolved; }
+
 	void set_process_input(bool p_enable);
 	bool is_processing_input() const;
 
@@ -432,6 +475,7 @@ public:
 
 	uint16_t rpc_config(const StringName &p_method, MultiplayerAPI::RPCMode p_mode); // config a local method for RPC
 	uint16_t rset_config(const StringName &p_property, MultiplayerAPI::RPCMode p_mode); // config a local property for RPC
+	void rpc_config_signature(const StringName &p_method, const Vector<MultiplayerAPI::RPCArgument> &p_signature); // declare the argument types of a RPC method
 
 	void rpc(const StringName &p_method, VARIANT_ARG_LIST); //rpc call, honors RPCMode
 	void rpc_unreliable(const StringName &p_method, VARIANT_ARG_LIST); //rpc call, honors RPCMode
@@ -450,11 +494,15 @@ public:
 	Ref<MultiplayerAPI> get_custom_multiplayer() const;
 	void set_custom_multiplayer(Ref<MultiplayerAPI> p_multiplayer);
 
+	virtual bool get_network_interest_position(Vector3 &r_position) const { return false; } // position used by MultiplayerAPI interest management, if any
+
 	/// Returns the rpc method ID, otherwise UINT32_MAX
 	uint16_t get_node_rpc_method_id(const StringName &p_method) const;
 	StringName get_node_rpc_method(const uint16_t p_rpc_method_id) const;
 	MultiplayerAPI::RPCMode get_node_rpc_mode_by_id(const uint16_t p_rpc_method_id) const;
 	MultiplayerAPI::RPCMode get_node_rpc_mode(const StringName &p_method) const;
+	/// Returns the declared argument types of the rpc method, otherwise nullptr
+	const Vector<MultiplayerAPI::RPCArgument> *get_node_rpc_signature(const StringName &p_method) const;
 
 	/// Returns the rpc property ID, otherwise UINT32_MAX
 	uint16_t get_node_rset_property_id(const StringName &p_property) const;
@@ -466,6 +514,11 @@ public:
 	/// same across the peers.
 	String get_rpc_md5() const;
 
+	/// Used by MultiplayerAPI to remember the path ID it gave this node, so sending
+	/// does not need to compute the relative path again. Returns 0 when not cached.
+	int get_network_path_id(ObjectID p_multiplayer, uint32_t p_epoch) const;
+	void set_network_path_id(ObjectID p_multiplayer, uint32_t p_epoch, int p_id) const;
+
 	Node();
 	~Node();
 };
@@ -0,0 +1,120 @@
+/*************************************************************************/
+/*  node_path_cache.cpp                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "node_path_cache.h"
+
+#include "scene/main/node.h"
+#include "scene/scene_string_names.h"
+
+bool NodePathCache::_leads_to(const Node *p_from, const NodePath &p_path, const Node *p_target) {
+	int name_count = p_path.get_name_count();
+	if (name_count == 0) {
+		return false;
+	}
+
+	// Walk up from the target, matching the path backwards. Names are unique among
+	// siblings, so if they all match, resolving the path again gives the same node.
+	const Node *first = nullptr;
+	const Node *node = p_target;
+	for (int i = name_count - 1; i >= 0; i--) {
+		if (!node) {
+			return false;
+		}
+		const StringName &name = p_path.get_name(i);
+		if (name == SceneStringNames::get_singleton()->dot || name == SceneStringNames::get_singleton()->doubledot) {
+			return false; // Rare enough to just be resolved again.
+		}
+		if (node->get_name() != name) {
+			return false;
+		}
+		first = node;
+		node = node->get_parent();
+	}
+
+	if (!p_path.is_absolute()) {
+		return node == p_from;
+	}
+
+	// The first name is the root's, which must also be p_from's.
+	if (node) {
+		return false;
+	}
+	const Node *root = p_from;
+	while (root->get_parent()) {
+		root = root->get_parent();
+	}
+	return root == first;
+}
+
+bool NodePathCache::lookup(const Node *p_from, const NodePath &p_path, uint64_t p_version, Node *&r_node) {
+	Entry *entry = entries.getptr(p_path);
+	if (!entry) {
+		return false;
+	}
+
+	if (entry->target.is_null()) {
+		if (entry->version != p_version) {
+			return false;
+		}
+		r_node = nullptr;
+		return true;
+	}
+
+	Node *node = Object::cast_to<Node>(ObjectDB::get_instance(entry->target));
+	if (!node) {
+		return false;
+	}
+	if (entry->version != p_version) {
+		if (!_leads_to(p_from, p_path, node)) {
+			return false;
+		}
+		entry->version = p_version;
+	}
+
+	r_node = node;
+	return true;
+}
+
+void NodePathCache::store(const NodePath &p_path, const Node *p_node, uint64_t p_version) {
+	if (entries.size() >= MAX_ENTRIES && !entries.has(p_path)) {
+		entries.clear();
+	}
+
+	Entry entry;
+	if (p_node) {
+		entry.target = p_node->get_instance_id();
+	}
+	entry.version = p_version;
+	entries.set(p_path, entry);
+}
+
+void NodePathCache::clear() {
+	entries.clear();
+}
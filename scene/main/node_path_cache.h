@@ -0,0 +1,70 @@
+/*************************************************************************/
+/*  node_path_cache.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef NODE_PATH_CACHE_H
+#define NODE_PATH_CACHE_H
+
+#include "core/hash_map.h"
+#include "core/node_path.h"
+#include "core/object_id.h"
+
+class Node;
+
+// Remembers the nodes get_node() resolved paths to from one node. Entries hold
+// the target's ObjectID, so a freed node is never returned, and the tree
+// version they were last known to be right at. Once the tree changed, an
+// entry is kept if the target still sits at the end of the path, which only
+// takes walking up from it, so unrelated changes elsewhere in the tree don't
+// throw the cache away. Paths that resolved to nothing can't be checked that
+// way and are only trusted at the version they were stored at.
+class NodePathCache {
+	struct Entry {
+		ObjectID target; // Null if the path resolved to nothing.
+		uint64_t version = 0;
+	};
+
+	HashMap<NodePath, Entry> entries;
+
+	static bool _leads_to(const Node *p_from, const NodePath &p_path, const Node *p_target);
+
+public:
+	enum {
+		MAX_ENTRIES = 64
+	};
+
+	// Returns true if p_path is cached for p_from at p_version, setting r_node.
+	bool lookup(const Node *p_from, const NodePath &p_path, uint64_t p_version, Node *&r_node);
+	void store(const NodePath &p_path, const Node *p_node, uint64_t p_version);
+
+	_FORCE_INLINE_ int size() const { return entries.size(); }
+	void clear();
+};
+
+#endif // NODE_PATH_CACHE_H
@@ -0,0 +1,161 @@
+/*************************************************************************/
+/*  node_pool.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "node_pool.h"
+
+#include "scene/scene_string_names.h"
+
+Node *NodePool::_instance() const {
+	ERR_FAIL_COND_V_MSG(scene.is_null(), nullptr, "NodePool has no scene to instance.");
+	return scene->instance();
+}
+
+void NodePool::set_scene(const Ref<PackedScene> &p_scene) {
+	if (scene == p_scene) {
+		return;
+	}
+	clear();
+	scene = p_scene;
+}
+
+Ref<PackedScene> NodePool::get_scene() const {
+	return scene;
+}
+
+void NodePool::set_max_size(int p_max_size) {
+	ERR_FAIL_COND(p_max_size < 0);
+	max_size = p_max_size;
+
+	while (max_size > 0 && available.size() > max_size) {
+		memdelete(available[available.size() - 1]);
+		available.resize(available.size() - 1);
+	}
+}
+
+int NodePool::get_max_size() const {
+	return max_size;
+}
+
+void NodePool::prewarm(int p_count) {
+	if (max_size > 0) {
+		p_count = MIN(p_count, max_size);
+	}
+
+	while (available.size() < p_count) {
+		Node *node = _instance();
+		ERR_FAIL_COND(!node);
+		available.push_back(node);
+	}
+}
+
+Node *NodePool::acquire() {
+	if (available.size()) {
+		Node *node = available[available.size() - 1];
+		available.resize(available.size() - 1);
+		hit_count++;
+		return node;
+	}
+
+	miss_count++;
+	return _instance();
+}
+
+void NodePool::release(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_node->is_queued_for_deletion(), "Can't release a node queued for deletion to a pool.");
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(available.find(p_node) != -1, "Node '" + String(p_node->get_name()) + "' is already in the pool.");
+#endif
+
+	if (p_node->get_parent()) {
+		p_node->get_parent()->remove_child(p_node);
+		ERR_FAIL_COND_MSG(p_node->get_parent(), "Could not detach the node from its parent, consider using call_deferred(\"release\", node) instead.");
+	}
+
+	if (p_node->has_method(SceneStringNames::get_singleton()->_pool_reset)) {
+		p_node->call(SceneStringNames::get_singleton()->_pool_reset);
+	}
+
+	if (max_size > 0 && available.size() >= max_size) {
+		// Nodes often release themselves from their own callbacks, so they can't be freed right away.
+		p_node->queue_delete();
+		return;
+	}
+
+	available.push_back(p_node);
+}
+
+void NodePool::clear() {
+	for (int i = 0; i < available.size(); i++) {
+		memdelete(available[i]);
+	}
+	available.clear();
+}
+
+int NodePool::get_available_count() const {
+	return available.size();
+}
+
+uint64_t NodePool::get_hit_count() const {
+	return hit_count;
+}
+
+uint64_t NodePool::get_miss_count() const {
+	return miss_count;
+}
+
+void NodePool::reset_stats() {
+	hit_count = 0;
+	miss_count = 0;
+}
+
+void NodePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_scene", "scene"), &NodePool::set_scene);
+	ClassDB::bind_method(D_METHOD("get_scene"), &NodePool::get_scene);
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &NodePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &NodePool::get_max_size);
+
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &NodePool::prewarm);
+	ClassDB::bind_method(D_METHOD("acquire"), &NodePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &NodePool::release);
+	ClassDB::bind_method(D_METHOD("clear"), &NodePool::clear);
+
+	ClassDB::bind_method(D_METHOD("get_available_count"), &NodePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("get_hit_count"), &NodePool::get_hit_count);
+	ClassDB::bind_method(D_METHOD("get_miss_count"), &NodePool::get_miss_count);
+	ClassDB::bind_method(D_METHOD("reset_stats"), &NodePool::reset_stats);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene"), "set_scene", "get_scene");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,65536,1,or_greater"), "set_max_size", "get_max_size");
+}
+
+NodePool::~NodePool() {
+	clear();
+}
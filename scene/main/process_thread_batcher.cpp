@@ -0,0 +1,134 @@
+/*************************************************************************/
+/*  process_thread_batcher.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "process_thread_batcher.h"
+
+#include "core/error_macros.h"
+#include "core/os/os.h"
+#include "core/safe_refcount.h"
+
+void ProcessThreadBatcher::_thread_func(void *p_userdata) {
+	ProcessThreadBatcher *batcher = (ProcessThreadBatcher *)p_userdata;
+
+	while (true) {
+		batcher->threads_start.wait();
+		if (batcher->threads_exit) {
+			break;
+		}
+		batcher->_process_batches();
+		batcher->threads_done.post();
+	}
+}
+
+void ProcessThreadBatcher::_process_batches() {
+	while (true) {
+		uint32_t index = atomic_increment(&next) - 1;
+		if (index >= pending.size()) {
+			break;
+		}
+
+		const Batch &batch = batches[pending[index]];
+		for (uint32_t i = 0; i < batch.nodes.size(); i++) {
+			process_func(batch.nodes[i], process_userdata);
+		}
+	}
+}
+
+void ProcessThreadBatcher::add(int p_group, Node *p_node) {
+	ERR_FAIL_COND_MSG(running, "Can't add nodes to process thread batches while they run.");
+
+	uint32_t *index = batch_map.getptr(p_group);
+	if (!index) {
+		batch_map.set(p_group, batches.size());
+		batches.push_back(Batch());
+		index = batch_map.getptr(p_group);
+	}
+	if (batches[*index].nodes.size() == 0) {
+		pending.push_back(*index);
+	}
+	batches[*index].nodes.push_back(p_node);
+}
+
+void ProcessThreadBatcher::run(ProcessFunc p_func, void *p_userdata) {
+	ERR_FAIL_COND(running);
+	if (pending.size() == 0) {
+		return;
+	}
+
+#ifndef NO_THREADS
+	if (threads.empty()) {
+		int count = thread_count >= 0 ? thread_count : MAX(1, OS::get_singleton()->get_processor_count() - 1);
+		threads.resize(count);
+		for (int i = 0; i < count; i++) {
+			threads.write[i] = Thread::create(_thread_func, this);
+		}
+	}
+#endif
+
+	process_func = p_func;
+	process_userdata = p_userdata;
+	next = 0;
+	running = true;
+
+	for (int i = 0; i < threads.size(); i++) {
+		threads_start.post();
+	}
+
+	_process_batches();
+
+	for (int i = 0; i < threads.size(); i++) {
+		threads_done.wait();
+	}
+
+	running = false;
+
+	for (uint32_t i = 0; i < pending.size(); i++) {
+		batches[pending[i]].nodes.clear();
+	}
+	pending.clear();
+}
+
+void ProcessThreadBatcher::set_thread_count(int p_count) {
+	ERR_FAIL_COND_MSG(threads.size(), "Process threads were already started.");
+	thread_count = p_count;
+}
+
+ProcessThreadBatcher::~ProcessThreadBatcher() {
+	if (threads.size()) {
+		threads_exit = true;
+		for (int i = 0; i < threads.size(); i++) {
+			threads_start.post();
+		}
+		for (int i = 0; i < threads.size(); i++) {
+			Thread::wait_to_finish(threads[i]);
+			memdelete(threads[i]);
+		}
+	}
+}
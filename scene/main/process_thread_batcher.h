@@ -0,0 +1,91 @@
+/*************************************************************************/
+/*  process_thread_batcher.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef PROCESS_THREAD_BATCHER_H
+#define PROCESS_THREAD_BATCHER_H
+
+#include "core/hash_map.h"
+#include "core/local_vector.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+
+class Node;
+
+// Collects nodes into one batch per process thread group, then processes the
+// batches in parallel on a persistent pool of worker threads, with the calling
+// thread taking batches too. Within a batch, nodes keep the order they were
+// added in.
+class ProcessThreadBatcher {
+public:
+	typedef void (*ProcessFunc)(Node *p_node, void *p_userdata);
+
+private:
+	struct Batch {
+		LocalVector<Node *> nodes;
+	};
+
+	HashMap<int, uint32_t> batch_map;
+	LocalVector<Batch> batches;
+	LocalVector<uint32_t> pending; // Batches with nodes this run.
+	volatile uint32_t next = 0;
+
+	ProcessFunc process_func = nullptr;
+	void *process_userdata = nullptr;
+	bool running = false;
+
+	int thread_count = -1; // Worker threads, -1 uses one less than the processor count.
+	bool threads_exit = false;
+	Vector<Thread *> threads;
+	Semaphore threads_start;
+	Semaphore threads_done;
+
+	static void _thread_func(void *p_userdata);
+	void _process_batches();
+
+public:
+	void add(int p_group, Node *p_node);
+
+	_FORCE_INLINE_ uint32_t get_pending_batch_count() const { return pending.size(); }
+	_FORCE_INLINE_ const LocalVector<Node *> &get_pending_batch(uint32_t p_index) const { return batches[pending[p_index]].nodes; }
+
+	// Calls p_func for every node added since the last run and returns once all
+	// batches are done, leaving none pending.
+	void run(ProcessFunc p_func, void *p_userdata);
+	_FORCE_INLINE_ bool is_running() const { return running; }
+
+	// Only takes effect before the first run, which starts the threads.
+	void set_thread_count(int p_count);
+	_FORCE_INLINE_ int get_started_thread_count() const { return threads.size(); }
+
+	ProcessThreadBatcher() {}
+	~ProcessThreadBatcher();
+};
+
+#endif // PROCESS_THREAD_BATCHER_H
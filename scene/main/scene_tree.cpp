@@ -40,8 +40,10 @@
 #include "core/os/os.h"
 #include "core/print_string.h"
 #include "core/project_settings.h"
+#include "core/thread_work_pool.h"
 #include "node.h"
 #include "scene/debugger/scene_debugger.h"
+#include "scene/main/timer.h"
 #include "scene/resources/dynamic_font.h"
 #include "scene/resources/material.h"
 #include "scene/resources/mesh.h"
@@ -66,14 +68,27 @@ void SceneTreeTimer::_bind_methods() {
 
 void SceneTreeTimer::set_time_left(float p_time) {
 	time_left = p_time;
+	if (wheel_entry.is_scheduled()) {
+		TimerWheel *wheel = wheel_entry.get_wheel();
+		wheel->schedule(&wheel_entry, wheel->get_time() + p_time);
+	}
 }
 
 float SceneTreeTimer::get_time_left() const {
+	if (wheel_entry.is_scheduled()) {
+		return wheel_entry.deadline - wheel_entry.get_wheel()->get_time();
+	}
 	return time_left;
 }
 
 void SceneTreeTimer::set_pause_mode_process(bool p_pause_mode_process) {
+	if (process_pause == p_pause_mode_process) {
+		return;
+	}
 	process_pause = p_pause_mode_process;
+	if (wheel_entry.is_scheduled() && SceneTree::get_singleton()) {
+		SceneTree::get_singleton()->_update_timer_wheel(this);
+	}
 }
 
 bool SceneTreeTimer::is_pause_mode_process() {
@@ -93,6 +108,7 @@ void SceneTreeTimer::release_connections() {
 SceneTreeTimer::SceneTreeTimer() {
 	time_left = 0;
 	process_pause = true;
+	wheel_entry.owner = get_instance_id();
 }
 
 void SceneTree::tree_changed() {
@@ -101,6 +117,7 @@ void SceneTree::tree_changed() {
 }
 
 void SceneTree::node_added(Node *p_node) {
+	tree_version++; // Paths that did not resolve before may do so now.
 	emit_signal(node_added_name, p_node);
 }
 
@@ -118,37 +135,116 @@ void SceneTree::node_renamed(Node *p_node) {
 	emit_signal(node_renamed_name, p_node);
 }
 
-SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_node) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
-		E = group_map.insert(p_group, Group());
+struct _GroupNodeSlot {
+	Node *node;
+	int *index;
+};
+
+template <class C>
+struct _GroupNodeSlotSort {
+	_FORCE_INLINE_ bool operator()(const _GroupNodeSlot &p_a, const _GroupNodeSlot &p_b) const {
+		return C()(p_a.node, p_b.node);
 	}
+};
 
-	ERR_FAIL_COND_V_MSG(E->get().nodes.find(p_node) != -1, &E->get(), "Already in group: " + p_group + ".");
-	E->get().nodes.push_back(p_node);
-	//E->get().last_tree_version=0;
-	E->get().changed = true;
-	return &E->get();
+static _FORCE_INLINE_ bool _group_node_less(bool p_use_priority, const Node *p_a, const Node *p_b) {
+	if (p_use_priority) {
+		return Node::ComparatorWithPriority()(p_a, p_b);
+	}
+	return Node::Comparator()(p_a, p_b);
 }
 
-void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	ERR_FAIL_COND(!E);
+SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_node, int *p_index) {
+	Group *g = group_map.getptr(p_group);
+	if (!g) {
+		g = &group_map.set(p_group, Group())->value();
+	}
+
+	ERR_FAIL_COND_V_MSG(*p_index != -1, g, "Already in group: " + p_group + ".");
 
-	E->get().nodes.erase(p_node);
-	if (E->get().nodes.empty()) {
-		group_map.erase(E);
+	// Keep the group in order as nodes come in, rather than sorting it again on the next call.
+	int pos = g->nodes.size();
+	if (!g->changed && pos > 0 && _group_node_less(g->priority_order, p_node, g->nodes[pos - 1])) {
+		if (g->removed) {
+			_compact_group(*g);
+		}
+
+		int low = 0;
+		int high = g->nodes.size();
+		while (low < high) {
+			int mid = (low + high) / 2;
+			if (_group_node_less(g->priority_order, p_node, g->nodes[mid])) {
+				high = mid;
+			} else {
+				low = mid + 1;
+			}
+		}
+		pos = low;
+	}
+
+	g->nodes.insert(pos, p_node);
+	g->node_indices.insert(pos, p_index);
+	for (uint32_t i = pos; i < g->node_indices.size(); i++) {
+		if (g->node_indices[i]) {
+			*g->node_indices[i] = i;
+		}
+	}
+	//g->last_tree_version=0;
+	return g;
+}
+
+void SceneTree::remove_from_group(const StringName &p_group, Node *p_node, int *p_index) {
+	Group *g = group_map.getptr(p_group);
+	ERR_FAIL_COND(!g);
+
+	int idx = *p_index;
+	ERR_FAIL_INDEX(idx, g->nodes.size());
+	ERR_FAIL_COND(g->nodes[idx] != p_node);
+	*p_index = -1;
+
+	if (idx < g->nodes.size() - 1) {
+		// Leave a hole instead of shifting the rest of the group, it is compacted before the next use.
+		g->nodes.set(idx, nullptr);
+		g->node_indices[idx] = nullptr;
+		g->removed++;
+	} else {
+		// Trailing holes are dropped right away, so the last slot always holds a node.
+		int size = idx;
+		while (size > 0 && !g->nodes[size - 1]) {
+			size--;
+			g->removed--;
+		}
+		g->nodes.resize(size);
+		g->node_indices.resize(size);
+	}
+
+	if (g->nodes.size() == g->removed) {
+		group_map.erase(p_group);
 	}
 }
 
 void SceneTree::make_group_changed(const StringName &p_group) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (E) {
-		E->get().changed = true;
+	Group *g = group_map.getptr(p_group);
+	if (g) {
+		g->changed = true;
 	}
 }
 
 void SceneTree::flush_transform_notifications() {
+	xform_change_flushing++;
+
+	if (transform_store_3d.has_pending_changes()) {
+		LocalVector<ObjectID> moved;
+		transform_store_3d.update(moved, transform_store_3d_pool);
+		for (uint32_t i = 0; i < moved.size(); i++) {
+			// Earlier notifications may have freed it or taken it out of the tree.
+			Node *node = Object::cast_to<Node>(ObjectDB::get_instance(moved[i]));
+			if (node && node->is_inside_tree()) {
+				node->notification(NOTIFICATION_TRANSFORM_CHANGED);
+			}
+		}
+	}
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -157,6 +253,15 @@ void SceneTree::flush_transform_notifications() {
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+	xform_change_flushing--;
+
+	if (xform_change_flushing == 0 && xform_change_instances.size()) {
+		RS::get_singleton()->instances_set_transforms(xform_change_instances, xform_change_instance_transforms);
+		// Fresh arrays, so the ones just sent are not copied on the next write.
+		xform_change_instances = Vector<RID>();
+		xform_change_instance_transforms = Vector<Transform>();
+	}
 }
 
 void SceneTree::_flush_ugc() {
@@ -179,33 +284,98 @@ void SceneTree::_flush_ugc() {
 	ugc_locked = false;
 }
 
+void SceneTree::_compact_group(Group &g) {
+	Node **nodes = g.nodes.ptrw();
+	int node_count = g.nodes.size();
+
+	int to = 0;
+	for (int i = 0; i < node_count; i++) {
+		if (!nodes[i]) {
+			continue;
+		}
+		nodes[to] = nodes[i];
+		g.node_indices[to] = g.node_indices[i];
+		*g.node_indices[to] = to;
+		to++;
+	}
+
+	g.nodes.resize(to);
+	g.node_indices.resize(to);
+	g.removed = 0;
+}
+
 void SceneTree::_update_group_order(Group &g, bool p_use_priority) {
-	if (!g.changed) {
+	if (g.removed) {
+		_compact_group(g);
+	}
+	if (!g.changed && g.priority_order == p_use_priority) {
 		return;
 	}
 	if (g.nodes.empty()) {
 		return;
 	}
 
-	Node **nodes = g.nodes.ptrw();
 	int node_count = g.nodes.size();
+	LocalVector<_GroupNodeSlot> slots;
+	slots.resize(node_count);
+	for (int i = 0; i < node_count; i++) {
+		slots[i].node = g.nodes[i];
+		slots[i].index = g.node_indices[i];
+	}
 
 	if (p_use_priority) {
-		SortArray<Node *, Node::ComparatorWithPriority> node_sort;
-		node_sort.sort(nodes, node_count);
+		SortArray<_GroupNodeSlot, _GroupNodeSlotSort<Node::ComparatorWithPriority>> node_sort;
+		node_sort.sort(slots.ptr(), node_count);
 	} else {
-		SortArray<Node *, Node::Comparator> node_sort;
-		node_sort.sort(nodes, node_count);
+		SortArray<_GroupNodeSlot, _GroupNodeSlotSort<Node::Comparator>> node_sort;
+		node_sort.sort(slots.ptr(), node_count);
+	}
+
+	Node **nodes = g.nodes.ptrw();
+	for (int i = 0; i < node_count; i++) {
+		nodes[i] = slots[i].node;
+		g.node_indices[i] = slots[i].index;
+		*slots[i].index = i;
 	}
 	g.changed = false;
+	g.priority_order = p_use_priority;
+}
+
+void SceneTree::GroupMethodCall::call(Node *p_node) {
+	Callable::CallError ce;
+	MethodBind *bind = nullptr;
+
+	if (!p_node->get_script_instance()) {
+		const StringName &class_name = p_node->get_class_name();
+		if (class_name != method_class) {
+			method_class = class_name;
+			method = ClassDB::get_method(class_name, function);
+		}
+		bind = method;
+	}
+
+	if (bind) {
+		bind->call(p_node, args, argcount, ce);
+	} else {
+		// Scripted nodes, and methods that are not bound (such as "free"), take the regular path.
+		p_node->call(function, args, argcount, ce);
+	}
+
+#ifdef DEBUG_ENABLED
+	// Groups may mix nodes with and without the method, those without it are skipped silently.
+	if (ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD) {
+		ERR_PRINT("Error calling method from 'call_group': " + Variant::get_call_error_text(p_node, function, args, argcount, ce));
+	}
+#endif
 }
 
 void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, VARIANT_ARG_DECLARE) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	ERR_FAIL_COND_MSG(process_thread_batcher.is_running(), "Can't call groups while process thread groups are being processed. Consider using call_deferred() instead.");
+	Group *G = group_map.getptr(p_group);
+	if (!G) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *G;
 	if (g.nodes.empty()) {
 		return;
 	}
@@ -238,9 +408,20 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 	_update_group_order(g);
 
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
+	VARIANT_ARGPTRS;
+	GroupMethodCall group_call;
+	group_call.function = p_function;
+	group_call.args = argptr;
+	for (int i = 0; i < VARIANT_ARG_MAX; i++) {
+		if (argptr[i]->get_type() == Variant::NIL) {
+			break;
+		}
+		group_call.argcount++;
+	}
+
 	call_lock++;
 
 	if (p_call_flags & GROUP_CALL_REVERSE) {
@@ -250,7 +431,7 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 			}
 
 			if (p_call_flags & GROUP_CALL_REALTIME) {
-				nodes[i]->call(p_function, VARIANT_ARG_PASS);
+				group_call.call(nodes[i]);
 			} else {
 				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
 			}
@@ -263,7 +444,7 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 			}
 
 			if (p_call_flags & GROUP_CALL_REALTIME) {
-				nodes[i]->call(p_function, VARIANT_ARG_PASS);
+				group_call.call(nodes[i]);
 			} else {
 				MessageQueue::get_singleton()->push_call(nodes[i], p_function, VARIANT_ARG_PASS);
 			}
@@ -277,11 +458,12 @@ void SceneTree::call_group_flags(uint32_t p_call_flags, const StringName &p_grou
 }
 
 void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_group, int p_notification) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	ERR_FAIL_COND_MSG(process_thread_batcher.is_running(), "Can't call groups while process thread groups are being processed. Consider using call_deferred() instead.");
+	Group *G = group_map.getptr(p_group);
+	if (!G) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *G;
 	if (g.nodes.empty()) {
 		return;
 	}
@@ -289,7 +471,7 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 	_update_group_order(g);
 
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
 	call_lock++;
@@ -328,11 +510,12 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 }
 
 void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group, const String &p_name, const Variant &p_value) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	ERR_FAIL_COND_MSG(process_thread_batcher.is_running(), "Can't call groups while process thread groups are being processed. Consider using call_deferred() instead.");
+	Group *G = group_map.getptr(p_group);
+	if (!G) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *G;
 	if (g.nodes.empty()) {
 		return;
 	}
@@ -340,7 +523,7 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 	_update_group_order(g);
 
 	Vector<Node *> nodes_copy = g.nodes;
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 	int node_count = nodes_copy.size();
 
 	call_lock++;
@@ -408,6 +591,7 @@ bool SceneTree::iteration(float p_time) {
 
 	emit_signal("physics_frame");
 
+	_process_timers(TIMER_WHEEL_NODE_PHYSICS, p_time);
 	_notify_group_pause("physics_process_internal", Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 	_notify_group_pause("physics_process", Node::NOTIFICATION_PHYSICS_PROCESS);
 	_flush_ugc();
@@ -443,6 +627,7 @@ bool SceneTree::idle(float p_time) {
 
 	flush_transform_notifications();
 
+	_process_timers(TIMER_WHEEL_NODE_IDLE, p_time);
 	_notify_group_pause("idle_process_internal", Node::NOTIFICATION_INTERNAL_PROCESS);
 	_notify_group_pause("idle_process", Node::NOTIFICATION_PROCESS);
 
@@ -457,29 +642,9 @@ bool SceneTree::idle(float p_time) {
 
 	//go through timers
 
-	List<Ref<SceneTreeTimer>>::Element *L = timers.back(); //last element
-
-	for (List<Ref<SceneTreeTimer>>::Element *E = timers.front(); E;) {
-		List<Ref<SceneTreeTimer>>::Element *N = E->next();
-		if (pause && !E->get()->is_pause_mode_process()) {
-			if (E == L) {
-				break; //break on last, so if new timers were added during list traversal, ignore them.
-			}
-			E = N;
-			continue;
-		}
-		float time_left = E->get()->get_time_left();
-		time_left -= p_time;
-		E->get()->set_time_left(time_left);
-
-		if (time_left < 0) {
-			E->get()->emit_signal("timeout");
-			timers.erase(E);
-		}
-		if (E == L) {
-			break; //break on last, so if new timers were added during list traversal, ignore them.
-		}
-		E = N;
+	_process_timers(TIMER_WHEEL_TREE, p_time);
+	if (!pause) {
+		_process_timers(TIMER_WHEEL_TREE_PAUSABLE, p_time);
 	}
 
 	flush_transform_notifications(); //additional transforms after timers update
@@ -535,10 +700,46 @@ void SceneTree::finish() {
 	// cleanup timers
 	for (List<Ref<SceneTreeTimer>>::Element *E = timers.front(); E; E = E->next()) {
 		E->get()->release_connections();
+		E->get()->tree_element = nullptr;
+	}
+	for (int i = 0; i < TIMER_WHEEL_MAX; i++) {
+		timer_wheels[i].clear();
 	}
 	timers.clear();
 }
 
+void SceneTree::_process_timers(TimerWheelType p_type, float p_time) {
+	TimerWheel &wheel = timer_wheels[p_type];
+
+	LocalVector<ObjectID> expired;
+	wheel.advance(p_time, expired);
+
+	for (uint32_t i = 0; i < expired.size(); i++) {
+		Object *obj = ObjectDB::get_instance(expired[i]);
+
+		if (p_type == TIMER_WHEEL_NODE_IDLE || p_type == TIMER_WHEEL_NODE_PHYSICS) {
+			Timer *timer = Object::cast_to<Timer>(obj);
+			if (timer) {
+				timer->_timeout();
+			}
+			continue;
+		}
+
+		Ref<SceneTreeTimer> stt = Object::cast_to<SceneTreeTimer>(obj);
+		if (stt.is_null() || !stt->wheel_entry.expired) {
+			continue; // Rescheduled by a previous timeout.
+		}
+		stt->wheel_entry.expired = false;
+		stt->time_left = stt->wheel_entry.deadline - wheel.get_time();
+
+		stt->emit_signal("timeout");
+		if (stt->tree_element) {
+			timers.erase(stt->tree_element);
+			stt->tree_element = nullptr;
+		}
+	}
+}
+
 void SceneTree::quit(int p_exit_code) {
 	if (p_exit_code >= 0) {
 		// Override the exit code if a positive argument is given (the default is `-1`).
@@ -782,23 +983,29 @@ bool SceneTree::is_paused() const {
 }
 
 void SceneTree::_notify_group_pause(const StringName &p_group, int p_notification) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *G = group_map.getptr(p_group);
+	if (!G) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *G;
 	if (g.nodes.empty()) {
 		return;
 	}
 
-	_update_group_order(g, p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	// Only _process() and _physics_process() can run in thread groups. Internal processing
+	// (animation, particles, server calls) was never meant to be thread safe, so it stays
+	// on the main thread, but it is still ordered by priority.
+	bool user_process = p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS;
+	_update_group_order(g, user_process || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
 
 	//copy, so copy on write happens in case something is removed from process while being called
 	//performance is not lost because only if something is added/removed the vector is copied.
 	Vector<Node *> nodes_copy = g.nodes;
 
 	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
+
+	bool use_thread_groups = process_thread_group_nodes > 0 && user_process;
 
 	call_lock++;
 
@@ -808,6 +1015,12 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 			continue;
 		}
 
+		if (use_thread_groups && n->get_process_thread_group_resolved() > 0) {
+			//checked again when its batch runs, main thread nodes processed before may change it
+			process_thread_batcher.add(n->get_process_thread_group_resolved(), n);
+			continue;
+		}
+
 		if (!n->can_process()) {
 			continue;
 		}
@@ -819,12 +1032,52 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 		//ERR_FAIL_COND(node_count != g.nodes.size());
 	}
 
+	if (use_thread_groups) {
+		_run_process_thread_batches(p_notification);
+	}
+
 	call_lock--;
 	if (call_lock == 0) {
 		call_skip.clear();
 	}
 }
 
+void SceneTree::_process_thread_node(Node *p_node, void *p_userdata) {
+	SceneTree *st = (SceneTree *)p_userdata;
+	// The tree can't change while batches run, so these are safe to read concurrently.
+	if (st->call_skip.has(p_node)) {
+		return;
+	}
+	if (!p_node->can_process()) {
+		return;
+	}
+	if (!p_node->can_process_notification(st->process_thread_notification)) {
+		return;
+	}
+
+	p_node->notification(st->process_thread_notification);
+}
+
+void SceneTree::_run_process_thread_batches(int p_notification) {
+	// Child indices are renumbered lazily, which can't happen once the batches run
+	// (see Node::get_index()), so settle them for the nodes about to be processed.
+	for (uint32_t i = 0; i < process_thread_batcher.get_pending_batch_count(); i++) {
+		const LocalVector<Node *> &batch = process_thread_batcher.get_pending_batch(i);
+		for (uint32_t j = 0; j < batch.size(); j++) {
+			if (call_skip.has(batch[j])) {
+				continue; // May have been freed meanwhile.
+			}
+			Node *parent = batch[j]->data.parent;
+			if (parent) {
+				parent->_update_children_pos();
+			}
+		}
+	}
+
+	process_thread_notification = p_notification;
+	process_thread_batcher.run(_process_thread_node, this);
+}
+
 /*
 void SceneMainLoop::_update_listener_2d() {
 
@@ -838,11 +1091,11 @@ void SceneMainLoop::_update_listener_2d() {
 */
 
 void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p_method, const Ref<InputEvent> &p_input, Viewport *p_viewport) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *G = group_map.getptr(p_group);
+	if (!G) {
 		return;
 	}
-	Group &g = E->get();
+	Group &g = *G;
 	if (g.nodes.empty()) {
 		return;
 	}
@@ -854,7 +1107,7 @@ void SceneTree::_call_input_pause(const StringName &p_group, const StringName &p
 	Vector<Node *> nodes_copy = g.nodes;
 
 	int node_count = nodes_copy.size();
-	Node **nodes = nodes_copy.ptrw();
+	Node *const *nodes = nodes_copy.ptr();
 
 	Variant arg = p_input;
 	const Variant *v[1] = { &arg };
@@ -940,20 +1193,20 @@ int64_t SceneTree::get_frame() const {
 
 Array SceneTree::_get_nodes_in_group(const StringName &p_group) {
 	Array ret;
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *g = group_map.getptr(p_group);
+	if (!g) {
 		return ret;
 	}
 
-	_update_group_order(E->get()); //update order just in case
-	int nc = E->get().nodes.size();
+	_update_group_order(*g); //update order just in case
+	int nc = g->nodes.size();
 	if (nc == 0) {
 		return ret;
 	}
 
 	ret.resize(nc);
 
-	Node **ptr = E->get().nodes.ptrw();
+	Node *const *ptr = g->nodes.ptr();
 	for (int i = 0; i < nc; i++) {
 		ret[i] = ptr[i];
 	}
@@ -966,17 +1219,17 @@ bool SceneTree::has_group(const StringName &p_identifier) const {
 }
 
 void SceneTree::get_nodes_in_group(const StringName &p_group, List<Node *> *p_list) {
-	Map<StringName, Group>::Element *E = group_map.find(p_group);
-	if (!E) {
+	Group *g = group_map.getptr(p_group);
+	if (!g) {
 		return;
 	}
 
-	_update_group_order(E->get()); //update order just in case
-	int nc = E->get().nodes.size();
+	_update_group_order(*g); //update order just in case
+	int nc = g->nodes.size();
 	if (nc == 0) {
 		return;
 	}
-	Node **ptr = E->get().nodes.ptrw();
+	Node *const *ptr = g->nodes.ptr();
 	for (int i = 0; i < nc; i++) {
 		p_list->push_back(ptr[i]);
 	}
@@ -1084,10 +1337,21 @@ Ref<SceneTreeTimer> SceneTree::create_timer(float p_delay_sec, bool p_process_pa
 	stt.instance();
 	stt->set_pause_mode_process(p_process_pause);
 	stt->set_time_left(p_delay_sec);
-	timers.push_back(stt);
+	stt->tree_element = timers.push_back(stt);
+
+	TimerWheel &wheel = timer_wheels[p_process_pause ? TIMER_WHEEL_TREE : TIMER_WHEEL_TREE_PAUSABLE];
+	wheel.schedule(&stt->wheel_entry, wheel.get_time() + p_delay_sec);
 	return stt;
 }
 
+void SceneTree::_update_timer_wheel(SceneTreeTimer *p_timer) {
+	// Only the wheel of pausable timers stops while paused, so the timer moves over with the time it had left.
+	TimerWheel *wheel = p_timer->wheel_entry.get_wheel();
+	if (wheel) {
+		wheel->move_to(&p_timer->wheel_entry, &timer_wheels[p_timer->process_pause ? TIMER_WHEEL_TREE : TIMER_WHEEL_TREE_PAUSABLE]);
+	}
+}
+
 void SceneTree::_network_peer_connected(int p_id) {
 	emit_signal("network_peer_connected", p_id);
 }
@@ -1339,6 +1603,9 @@ SceneTree::SceneTree() {
 	accept_quit = true;
 	quit_on_go_back = true;
 	initialized = false;
+	process_thread_group_nodes = 0;
+	xform_change_flushing = 0;
+	process_thread_notification = 0;
 #ifdef DEBUG_ENABLED
 	debug_collisions_hint = false;
 	debug_navigation_hint = false;
@@ -1348,6 +1615,12 @@ SceneTree::SceneTree() {
 	debug_navigation_color = GLOBAL_DEF("debug/shapes/navigation/geometry_color", Color(0.1, 1.0, 0.7, 0.4));
 	debug_navigation_disabled_color = GLOBAL_DEF("debug/shapes/navigation/disabled_geometry_color", Color(1.0, 0.7, 0.1, 0.4));
 	collision_debug_contacts = GLOBAL_DEF("debug/shapes/collision/max_contacts_displayed", 10000);
+
+	transform_store_3d_pool = nullptr;
+	if (GLOBAL_DEF("rendering/threads/parallel_transform_update", false)) {
+		transform_store_3d_pool = memnew(ThreadWorkPool);
+		transform_store_3d_pool->init();
+	}
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/shapes/collision/max_contacts_displayed", PropertyInfo(Variant::INT, "debug/shapes/collision/max_contacts_displayed", PROPERTY_HINT_RANGE, "0,20000,1")); // No negative
 
 	tree_version = 1;
@@ -1441,6 +1714,11 @@ SceneTree::~SceneTree() {
 		memdelete(root);
 	}
 
+	if (transform_store_3d_pool) {
+		transform_store_3d_pool->finish();
+		memdelete(transform_store_3d_pool);
+	}
+
 	if (singleton == this) {
 		singleton = nullptr;
 	}
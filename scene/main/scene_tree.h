@@ -31,10 +31,15 @@
 #ifndef SCENE_MAIN_LOOP_H
 #define SCENE_MAIN_LOOP_H
 
+#include "core/hash_map.h"
 #include "core/io/multiplayer_api.h"
+#include "core/local_vector.h"
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
 #include "core/self_list.h"
+#include "scene/main/process_thread_batcher.h"
+#include "scene/main/timer_wheel.h"
+#include "scene/main/transform_store_3d.h"
 #include "scene/resources/mesh.h"
 #include "scene/resources/world_2d.h"
 #include "scene/resources/world_3d.h"
@@ -47,6 +52,7 @@ class Window;
 class Material;
 class Mesh;
 class SceneDebugger;
+class ThreadWorkPool;
 
 class SceneTreeTimer : public Reference {
 	GDCLASS(SceneTreeTimer, Reference);
@@ -54,6 +60,11 @@ class SceneTreeTimer : public Reference {
 	float time_left;
 	bool process_pause;
 
+	TimerWheel::Entry wheel_entry;
+	List<Ref<SceneTreeTimer>>::Element *tree_element = nullptr;
+
+	friend class SceneTree;
+
 protected:
 	static void _bind_methods();
 
@@ -80,9 +91,16 @@ public:
 private:
 	struct Group {
 		Vector<Node *> nodes;
+		LocalVector<int *> node_indices; // Each node's own copy of its position in nodes, kept in sync.
 		//uint64_t last_tree_version;
+		int removed; // Slots cleared by remove_from_group(), compacted before the group is used again.
 		bool changed;
-		Group() { changed = false; };
+		bool priority_order; // Whether the last sort took the process priority into account.
+		Group() {
+			removed = 0;
+			changed = false;
+			priority_order = false;
+		};
 	};
 
 	Window *root;
@@ -100,7 +118,7 @@ private:
 	bool pause;
 	int root_lock;
 
-	Map<StringName, Group> group_map;
+	HashMap<StringName, Group> group_map;
 	bool _quit;
 	bool initialized;
 
@@ -132,6 +150,16 @@ private:
 	bool ugc_locked;
 	void _flush_ugc();
 
+	// Process callbacks of nodes in a process thread group (see Node::set_process_thread_group())
+	// run on worker threads, one batch per group, after the main thread nodes.
+	int process_thread_group_nodes; // Nodes in the tree that opted into a group.
+	ProcessThreadBatcher process_thread_batcher;
+	int process_thread_notification;
+
+	static void _process_thread_node(Node *p_node, void *p_userdata);
+	void _run_process_thread_batches(int p_notification);
+
+	void _compact_group(Group &g);
 	_FORCE_INLINE_ void _update_group_order(Group &g, bool p_use_priority = false);
 	void _update_listener();
 
@@ -152,8 +180,23 @@ private:
 	void _change_scene(Node *p_to);
 	//void _call_group(uint32_t p_call_flags,const StringName& p_group,const StringName& p_function,const Variant& p_arg1,const Variant& p_arg2);
 
+	enum TimerWheelType {
+		TIMER_WHEEL_NODE_IDLE,
+		TIMER_WHEEL_NODE_PHYSICS,
+		TIMER_WHEEL_TREE,
+		TIMER_WHEEL_TREE_PAUSABLE,
+		TIMER_WHEEL_MAX
+	};
+
+	// Timer nodes and SceneTreeTimers are scheduled here, so only the ones that expire are touched each frame.
+	TimerWheel timer_wheels[TIMER_WHEEL_MAX];
 	List<Ref<SceneTreeTimer>> timers;
 
+	void _process_timers(TimerWheelType p_type, float p_time);
+	void _update_timer_wheel(SceneTreeTimer *p_timer);
+	friend class Timer;
+	friend class SceneTreeTimer;
+
 	///network///
 
 	Ref<MultiplayerAPI> multiplayer;
@@ -174,8 +217,8 @@ private:
 	void node_removed(Node *p_node);
 	void node_renamed(Node *p_node);
 
-	Group *add_to_group(const StringName &p_group, Node *p_node);
-	void remove_from_group(const StringName &p_group, Node *p_node);
+	Group *add_to_group(const StringName &p_group, Node *p_node, int *p_index);
+	void remove_from_group(const StringName &p_group, Node *p_node, int *p_index);
 	void make_group_changed(const StringName &p_group);
 
 	void _notify_group_pause(const StringName &p_group, int p_notification);
@@ -187,8 +230,47 @@ private:
 	friend class CanvasItem;
 	friend class Node3D;
 	friend class Viewport;
+	friend class VisualInstance3D;
+
+	// Node3D transforms, recomputed in one pass when transform notifications are flushed.
+	TransformStore3D transform_store_3d;
+	ThreadWorkPool *transform_store_3d_pool; // Only with "rendering/threads/parallel_transform_update".
 
 	SelfList<Node>::List xform_change_list;
+	Mutex xform_change_mutex; // Process thread groups may move nodes concurrently.
+
+	_FORCE_INLINE_ void _queue_xform_change(SelfList<Node> *p_xform_change) {
+		if (process_thread_batcher.is_running()) {
+			MutexLock lock(xform_change_mutex);
+			if (!p_xform_change->in_list()) {
+				xform_change_list.add(p_xform_change);
+			}
+		} else if (!p_xform_change->in_list()) {
+			xform_change_list.add(p_xform_change);
+		}
+	}
+
+	_FORCE_INLINE_ void _unqueue_xform_change(SelfList<Node> *p_xform_change) {
+		if (process_thread_batcher.is_running()) {
+			MutexLock lock(xform_change_mutex);
+			if (p_xform_change->in_list()) {
+				xform_change_list.remove(p_xform_change);
+			}
+		} else if (p_xform_change->in_list()) {
+			xform_change_list.remove(p_xform_change);
+		}
+	}
+
+	// Instance transforms changed while flushing transform notifications, sent to
+	// the RenderingServer in a single call once the flush is done.
+	int xform_change_flushing;
+	Vector<RID> xform_change_instances;
+	Vector<Transform> xform_change_instance_transforms;
+
+	_FORCE_INLINE_ void _queue_instance_transform(RID p_instance, const Transform &p_transform) {
+		xform_change_instances.push_back(p_instance);
+		xform_change_instance_transforms.push_back(p_transform);
+	}
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -210,6 +292,19 @@ private:
 	void _call_input_pause(const StringName &p_group, const StringName &p_method, const Ref<InputEvent> &p_input, Viewport *p_viewport);
 
 protected:
+	// Realtime group call. Groups are usually made of nodes of the same class,
+	// so the method is resolved once and reused until a node of another class comes.
+	struct GroupMethodCall {
+		StringName function;
+		const Variant **args = nullptr;
+		int argcount = 0;
+
+		StringName method_class;
+		MethodBind *method = nullptr;
+
+		void call(Node *p_node);
+	};
+
 	void _notification(int p_notification);
 	static void _bind_methods();
 
@@ -250,6 +345,7 @@ public:
 	void quit(int p_exit_code = -1);
 
 	_FORCE_INLINE_ float get_physics_process_time() const { return physics_process_time; }
+	_FORCE_INLINE_ bool is_processing_thread_groups() const { return process_thread_batcher.is_running(); }
 	_FORCE_INLINE_ float get_idle_process_time() const { return idle_process_time; }
 
 #ifdef TOOLS_ENABLED
@@ -31,6 +31,7 @@
 #include "timer.h"
 
 #include "core/engine.h"
+#include "scene/main/scene_tree.h"
 
 void Timer::_notification(int p_what) {
 	switch (p_what) {
@@ -45,38 +46,13 @@ void Timer::_notification(int p_what) {
 				autostart = false;
 			}
 		} break;
-		case NOTIFICATION_INTERNAL_PROCESS: {
-			if (timer_process_mode == TIMER_PROCESS_PHYSICS || !is_processing_internal()) {
-				return;
-			}
-			time_left -= get_process_delta_time();
-
-			if (time_left < 0) {
-				if (!one_shot) {
-					time_left += wait_time;
-				} else {
-					stop();
-				}
-
-				emit_signal("timeout");
-			}
-
+		case NOTIFICATION_ENTER_TREE:
+		case NOTIFICATION_PAUSED:
+		case NOTIFICATION_UNPAUSED: {
+			_update_schedule();
 		} break;
-		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-			if (timer_process_mode == TIMER_PROCESS_IDLE || !is_physics_processing_internal()) {
-				return;
-			}
-			time_left -= get_physics_process_delta_time();
-
-			if (time_left < 0) {
-				if (!one_shot) {
-					time_left += wait_time;
-				} else {
-					stop();
-				}
-				emit_signal("timeout");
-			}
-
+		case NOTIFICATION_EXIT_TREE: {
+			_unschedule();
 		} break;
 	}
 }
@@ -112,13 +88,16 @@ void Timer::start(float p_time) {
 	if (p_time > 0) {
 		set_wait_time(p_time);
 	}
+	_unschedule();
 	time_left = wait_time;
-	_set_process(true);
+	processing = true;
+	_update_schedule();
 }
 
 void Timer::stop() {
+	_unschedule();
 	time_left = -1;
-	_set_process(false);
+	processing = false;
 	autostart = false;
 }
 
@@ -128,7 +107,7 @@ void Timer::set_paused(bool p_paused) {
 	}
 
 	paused = p_paused;
-	_set_process(processing);
+	_update_schedule();
 }
 
 bool Timer::is_paused() const {
@@ -140,6 +119,13 @@ bool Timer::is_stopped() const {
 }
 
 float Timer::get_time_left() const {
+	if (wheel_entry.expired) {
+		return 0;
+	}
+	if (wheel_entry.is_scheduled()) {
+		double left = wheel_entry.deadline - wheel_entry.get_wheel()->get_time();
+		return left > 0 ? left : 0;
+	}
 	return time_left > 0 ? time_left : 0;
 }
 
@@ -148,37 +134,64 @@ void Timer::set_timer_process_mode(TimerProcessMode p_mode) {
 		return;
 	}
 
-	switch (timer_process_mode) {
-		case TIMER_PROCESS_PHYSICS:
-			if (is_physics_processing_internal()) {
-				set_physics_process_internal(false);
-				set_process_internal(true);
-			}
-			break;
-		case TIMER_PROCESS_IDLE:
-			if (is_processing_internal()) {
-				set_process_internal(false);
-				set_physics_process_internal(true);
-			}
-			break;
-	}
+	_unschedule();
 	timer_process_mode = p_mode;
+	_update_schedule();
 }
 
 Timer::TimerProcessMode Timer::get_timer_process_mode() const {
 	return timer_process_mode;
 }
 
-void Timer::_set_process(bool p_process, bool p_force) {
-	switch (timer_process_mode) {
-		case TIMER_PROCESS_PHYSICS:
-			set_physics_process_internal(p_process && !paused);
-			break;
-		case TIMER_PROCESS_IDLE:
-			set_process_internal(p_process && !paused);
-			break;
+TimerWheel *Timer::_get_wheel() const {
+	return &get_tree()->timer_wheels[timer_process_mode == TIMER_PROCESS_PHYSICS ? SceneTree::TIMER_WHEEL_NODE_PHYSICS : SceneTree::TIMER_WHEEL_NODE_IDLE];
+}
+
+void Timer::_update_schedule() {
+	if (!processing || paused || !is_inside_tree() || !can_process()) {
+		_unschedule();
+		return;
+	}
+
+	if (wheel_entry.is_scheduled() || wheel_entry.expired) {
+		return;
+	}
+
+	TimerWheel *wheel = _get_wheel();
+	wheel->schedule(&wheel_entry, wheel->get_time() + time_left);
+}
+
+void Timer::_unschedule() {
+	if (wheel_entry.is_scheduled()) {
+		TimerWheel *wheel = wheel_entry.get_wheel();
+		time_left = wheel_entry.deadline - wheel->get_time();
+		wheel->remove(&wheel_entry);
+	} else if (wheel_entry.expired) {
+		// Expired but not delivered yet, fire as soon as it is scheduled again.
+		time_left = 0;
+		wheel_entry.expired = false;
+	}
+}
+
+void Timer::_timeout() {
+	if (!wheel_entry.expired) {
+		return;
 	}
-	processing = p_process;
+	wheel_entry.expired = false;
+
+	if (!can_process()) {
+		time_left = 0;
+		return;
+	}
+
+	if (!one_shot) {
+		TimerWheel *wheel = _get_wheel();
+		wheel->schedule(&wheel_entry, wheel_entry.deadline + wait_time);
+	} else {
+		stop();
+	}
+
+	emit_signal("timeout");
 }
 
 void Timer::_bind_methods() {
@@ -225,4 +238,5 @@ Timer::Timer() {
 	time_left = -1;
 	processing = false;
 	paused = false;
+	wheel_entry.owner = get_instance_id();
 }
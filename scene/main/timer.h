@@ -32,6 +32,7 @@
 #define TIMER_H
 
 #include "scene/main/node.h"
+#include "scene/main/timer_wheel.h"
 
 class Timer : public Node {
 	GDCLASS(Timer, Node);
@@ -44,6 +45,8 @@ class Timer : public Node {
 
 	double time_left;
 
+	TimerWheel::Entry wheel_entry;
+
 protected:
 	void _notification(int p_what);
 	static void _bind_methods();
@@ -79,7 +82,12 @@ public:
 
 private:
 	TimerProcessMode timer_process_mode;
-	void _set_process(bool p_process, bool p_force = false);
+
+	friend class SceneTree;
+	TimerWheel *_get_wheel() const;
+	void _update_schedule();
+	void _unschedule();
+	void _timeout();
 };
 
 VARIANT_ENUM_CAST(Timer::TimerProcessMode);
@@ -0,0 +1,208 @@
+/*************************************************************************/
+/*  timer_wheel.cpp                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "timer_wheel.h"
+
+#include "core/sort_array.h"
+
+struct _TimerWheelDeadlineSort {
+	_FORCE_INLINE_ bool operator()(const TimerWheel::Entry *p_a, const TimerWheel::Entry *p_b) const {
+		return p_a->deadline < p_b->deadline;
+	}
+};
+
+TimerWheel::Entry::~Entry() {
+	if (wheel) {
+		wheel->remove(this);
+	}
+}
+
+void TimerWheel::_place(Entry *p_entry) {
+	if (p_entry->tick <= current_tick) {
+		due.add_last(&p_entry->list);
+		return;
+	}
+
+	uint64_t diff = p_entry->tick - current_tick;
+	for (int i = 0; i < LEVEL_COUNT; i++) {
+		if (diff < (uint64_t(1) << (SLOT_BITS * (i + 1)))) {
+			slots[i][(p_entry->tick >> (SLOT_BITS * i)) & SLOT_MASK].add_last(&p_entry->list);
+			return;
+		}
+	}
+
+	overflow.add_last(&p_entry->list);
+}
+
+void TimerWheel::_cascade(SelfList<Entry>::List &p_list) {
+	// Detach everything first, far away entries may be placed back into the same list.
+	LocalVector<Entry *> entries;
+	while (p_list.first()) {
+		SelfList<Entry> *E = p_list.first();
+		p_list.remove(E);
+		entries.push_back(E->self());
+	}
+
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		_place(entries[i]);
+	}
+}
+
+void TimerWheel::schedule(Entry *p_entry, double p_deadline) {
+	ERR_FAIL_NULL(p_entry);
+
+	if (p_entry->wheel) {
+		p_entry->wheel->remove(p_entry);
+	}
+
+	p_entry->deadline = p_deadline;
+	p_entry->tick = _get_tick(p_deadline);
+	p_entry->wheel = this;
+	p_entry->expired = false;
+	count++;
+	_place(p_entry);
+}
+
+void TimerWheel::remove(Entry *p_entry) {
+	ERR_FAIL_NULL(p_entry);
+	ERR_FAIL_COND(p_entry->wheel != this);
+
+	p_entry->list.remove_from_list();
+	p_entry->wheel = nullptr;
+	p_entry->expired = false;
+	count--;
+}
+
+void TimerWheel::move_to(Entry *p_entry, TimerWheel *p_wheel) {
+	ERR_FAIL_NULL(p_entry);
+	ERR_FAIL_NULL(p_wheel);
+	ERR_FAIL_COND(p_entry->wheel != this);
+
+	if (p_wheel == this) {
+		return;
+	}
+
+	double left = p_entry->deadline - time;
+	p_wheel->schedule(p_entry, p_wheel->time + left);
+}
+
+void TimerWheel::advance(double p_delta, LocalVector<ObjectID> &r_expired) {
+	time += p_delta;
+
+	uint64_t target = _get_tick(time);
+	if (count == 0) {
+		current_tick = MAX(current_tick, target);
+		return;
+	}
+
+	if (target > current_tick && target - current_tick > MAX_TICK_WALK) {
+		current_tick = target;
+		for (int i = 0; i < LEVEL_COUNT; i++) {
+			for (int j = 0; j < SLOT_COUNT; j++) {
+				_cascade(slots[i][j]);
+			}
+		}
+		_cascade(overflow);
+	}
+
+	while (current_tick < target) {
+		current_tick++;
+
+		if ((current_tick & SLOT_MASK) == 0) {
+			// Cascade from the coarsest level down, so entries land in slots that are still to be visited.
+			for (int i = LEVEL_COUNT - 1; i > 0; i--) {
+				uint64_t level_mask = (uint64_t(1) << (SLOT_BITS * i)) - 1;
+				if ((current_tick & level_mask) != 0) {
+					continue;
+				}
+				_cascade(slots[i][(current_tick >> (SLOT_BITS * i)) & SLOT_MASK]);
+				if (i == LEVEL_COUNT - 1) {
+					_cascade(overflow);
+				}
+			}
+		}
+
+		SelfList<Entry>::List &slot = slots[0][current_tick & SLOT_MASK];
+		while (slot.first()) {
+			SelfList<Entry> *E = slot.first();
+			slot.remove(E);
+			due.add_last(E);
+		}
+	}
+
+	LocalVector<Entry *> expired;
+	SelfList<Entry> *E = due.first();
+	while (E) {
+		SelfList<Entry> *N = E->next();
+		Entry *entry = E->self();
+		if (entry->deadline < time) {
+			due.remove(E);
+			entry->wheel = nullptr;
+			entry->expired = true;
+			count--;
+			expired.push_back(entry);
+		}
+		E = N;
+	}
+
+	if (expired.size() > 1) {
+		SortArray<Entry *, _TimerWheelDeadlineSort> sorter;
+		sorter.sort(expired.ptr(), expired.size());
+	}
+
+	for (uint32_t i = 0; i < expired.size(); i++) {
+		r_expired.push_back(expired[i]->owner);
+	}
+}
+
+void TimerWheel::clear() {
+	LocalVector<SelfList<Entry>::List *> lists;
+	for (int i = 0; i < LEVEL_COUNT; i++) {
+		for (int j = 0; j < SLOT_COUNT; j++) {
+			lists.push_back(&slots[i][j]);
+		}
+	}
+	lists.push_back(&overflow);
+	lists.push_back(&due);
+
+	for (uint32_t i = 0; i < lists.size(); i++) {
+		while (lists[i]->first()) {
+			SelfList<Entry> *E = lists[i]->first();
+			lists[i]->remove(E);
+			E->self()->wheel = nullptr;
+			E->self()->expired = false;
+		}
+	}
+	count = 0;
+}
+
+TimerWheel::~TimerWheel() {
+	clear();
+}
@@ -0,0 +1,109 @@
+/*************************************************************************/
+/*  timer_wheel.h                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "core/local_vector.h"
+#include "core/object_id.h"
+#include "core/self_list.h"
+
+// Hierarchical timing wheel. Scheduling and removing a timer is constant
+// time, and advancing the clock only touches the slots that come due, so
+// idle timers cost nothing per frame.
+class TimerWheel {
+public:
+	struct Entry {
+	private:
+		friend class TimerWheel;
+
+		SelfList<Entry> list;
+		TimerWheel *wheel = nullptr;
+		uint64_t tick = 0;
+
+	public:
+		ObjectID owner;
+		double deadline = 0.0;
+		// Set when the wheel returned this entry from advance(), cleared when it is scheduled or removed again.
+		bool expired = false;
+
+		_FORCE_INLINE_ bool is_scheduled() const { return wheel != nullptr; }
+		_FORCE_INLINE_ TimerWheel *get_wheel() const { return wheel; }
+
+		Entry() :
+				list(this) {}
+		~Entry();
+	};
+
+private:
+	enum {
+		TICKS_PER_SECOND = 1000,
+		SLOT_BITS = 6,
+		SLOT_COUNT = 1 << SLOT_BITS,
+		SLOT_MASK = SLOT_COUNT - 1,
+		LEVEL_COUNT = 4,
+		// Jumps longer than this are handled by rescheduling every timer, instead of walking the ticks.
+		MAX_TICK_WALK = 1 << 16,
+	};
+
+	SelfList<Entry>::List slots[LEVEL_COUNT][SLOT_COUNT];
+	SelfList<Entry>::List overflow; // Further away than the wheel spans.
+	SelfList<Entry>::List due; // Tick already reached, waiting for the clock to pass the deadline.
+
+	double time = 0.0;
+	uint64_t current_tick = 0;
+	uint32_t count = 0;
+
+	static _FORCE_INLINE_ uint64_t _get_tick(double p_time) {
+		return p_time > 0.0 ? uint64_t(p_time * TICKS_PER_SECOND) : 0;
+	}
+
+	void _place(Entry *p_entry);
+	void _cascade(SelfList<Entry>::List &p_list);
+
+public:
+	void schedule(Entry *p_entry, double p_deadline);
+	void remove(Entry *p_entry);
+	// Schedules a timer of this wheel on another one, with the time it had left on this one.
+	void move_to(Entry *p_entry, TimerWheel *p_wheel);
+
+	// Moves the clock forward and returns the owners of the timers whose deadline was passed, earliest first.
+	void advance(double p_delta, LocalVector<ObjectID> &r_expired);
+
+	_FORCE_INLINE_ double get_time() const { return time; }
+	_FORCE_INLINE_ uint32_t get_count() const { return count; }
+
+	void clear();
+
+	TimerWheel() {}
+	~TimerWheel();
+};
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,400 @@
+/*************************************************************************/
+/*  transform_store_3d.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "transform_store_3d.h"
+
+#include "core/safe_refcount.h"
+#include "core/thread_work_pool.h"
+
+void TransformStore3D::_mark_changed(Level *p_level, uint32_t p_index) {
+	uint8_t &flags = p_level->flags[p_index];
+	if (!(flags & FLAG_CHANGED)) {
+		flags |= FLAG_CHANGED;
+		atomic_increment(&p_level->changes);
+		atomic_increment(&pending_changes);
+	}
+}
+
+void TransformStore3D::_append(ID p_id, uint32_t p_depth, const Transform &p_local, uint8_t p_flags) {
+	while (levels.size() <= p_depth) {
+		levels.push_back(memnew(Level));
+	}
+
+	Level *level = levels[p_depth];
+	Entry &e = entries[p_id];
+	e.depth = p_depth;
+	e.index = level->ids.size();
+
+	level->local.push_back(p_local);
+	level->global.push_back(p_local); // Computed by the next update.
+	level->parent.push_back(e.parent == INVALID_ID ? uint32_t(INVALID_ID) : entries[e.parent].index);
+	level->flags.push_back(p_flags & ~(FLAG_CHANGED | FLAG_UPDATED | FLAG_REPORT));
+	level->ids.push_back(p_id);
+	_mark_changed(level, e.index);
+}
+
+void TransformStore3D::_remove(ID p_id) {
+	Entry &e = entries[p_id];
+	Level *level = levels[e.depth];
+	uint32_t last = level->ids.size() - 1;
+
+	if (e.index != last) {
+		// Fill the gap with the last entry, its children have to follow it.
+		level->local[e.index] = level->local[last];
+		level->global[e.index] = level->global[last];
+		level->parent[e.index] = level->parent[last];
+		level->flags[e.index] = level->flags[last];
+		level->ids[e.index] = level->ids[last];
+
+		Entry &moved = entries[level->ids[e.index]];
+		moved.index = e.index;
+		for (uint32_t i = 0; i < moved.children.size(); i++) {
+			const Entry &child = entries[moved.children[i]];
+			if (child.depth != INVALID_ID) {
+				levels[child.depth]->parent[child.index] = e.index;
+			}
+		}
+	}
+
+	level->local.resize(last);
+	level->global.resize(last);
+	level->parent.resize(last);
+	level->flags.resize(last);
+	level->ids.resize(last);
+	e.depth = INVALID_ID;
+}
+
+void TransformStore3D::_detach(ID p_id) {
+	Entry &e = entries[p_id];
+	if (e.parent == INVALID_ID) {
+		return;
+	}
+
+	LocalVector<ID> &siblings = entries[e.parent].children;
+	uint32_t last = siblings.size() - 1;
+	if (e.child_index != last) {
+		siblings[e.child_index] = siblings[last];
+		entries[siblings[e.child_index]].child_index = e.child_index;
+	}
+	siblings.resize(last);
+	e.parent = INVALID_ID;
+}
+
+void TransformStore3D::_attach(ID p_id, ID p_parent) {
+	Entry &e = entries[p_id];
+	e.parent = p_parent;
+	if (p_parent != INVALID_ID) {
+		LocalVector<ID> &siblings = entries[p_parent].children;
+		e.child_index = siblings.size();
+		siblings.push_back(p_id);
+	}
+}
+
+void TransformStore3D::_relocate_subtree(ID p_id) {
+	// Parents come before their children in this order.
+	LocalVector<ID> subtree;
+	subtree.push_back(p_id);
+	for (uint32_t i = 0; i < subtree.size(); i++) {
+		const Entry &e = entries[subtree[i]];
+		for (uint32_t j = 0; j < e.children.size(); j++) {
+			subtree.push_back(e.children[j]);
+		}
+	}
+
+	LocalVector<Transform> locals;
+	LocalVector<uint8_t> flags;
+	locals.resize(subtree.size());
+	flags.resize(subtree.size());
+
+	for (uint32_t i = subtree.size(); i-- > 0;) {
+		const Entry &e = entries[subtree[i]];
+		const Level *level = levels[e.depth];
+		locals[i] = level->local[e.index];
+		flags[i] = level->flags[e.index];
+		_remove(subtree[i]);
+	}
+
+	for (uint32_t i = 0; i < subtree.size(); i++) {
+		const Entry &e = entries[subtree[i]];
+		uint32_t depth = e.parent == INVALID_ID ? 0 : entries[e.parent].depth + 1;
+		_append(subtree[i], depth, locals[i], flags[i]);
+	}
+}
+
+Transform TransformStore3D::_get_global(uint32_t p_depth, uint32_t p_index, bool &r_stale) const {
+	const Level *level = levels[p_depth];
+	uint8_t flags = level->flags[p_index];
+
+	bool parent_stale = false;
+	Transform parent_global;
+	if (p_depth > 0) {
+		parent_global = _get_global(p_depth - 1, level->parent[p_index], parent_stale);
+	}
+
+	if (!parent_stale && !(flags & FLAG_CHANGED)) {
+		r_stale = false;
+		return level->global[p_index];
+	}
+
+	r_stale = true;
+	Transform global = p_depth > 0 ? parent_global * level->local[p_index] : level->local[p_index];
+	if (flags & FLAG_DISABLE_SCALE) {
+		global.basis.orthonormalize();
+	}
+	return global;
+}
+
+void TransformStore3D::_update_range(const UpdateLevel &p_level, uint32_t p_from, uint32_t p_to) {
+	Level *level = levels[p_level.depth];
+	const Level *parent_level = p_level.depth > 0 ? levels[p_level.depth - 1] : nullptr;
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+		uint8_t flags = level->flags[i];
+		bool parent_updated = p_level.parent_updated && (parent_level->flags[level->parent[i]] & FLAG_UPDATED);
+
+		if (!parent_updated && !(flags & FLAG_CHANGED)) {
+			level->flags[i] = flags & ~FLAG_UPDATED;
+			continue;
+		}
+
+		Transform &global = level->global[i];
+		global = parent_level ? parent_level->global[level->parent[i]] * level->local[i] : level->local[i];
+		if (flags & FLAG_DISABLE_SCALE) {
+			global.basis.orthonormalize();
+		}
+
+		// A change made with notifications off is still reported if the parent moved too.
+		bool report = (flags & FLAG_NOTIFY) && (parent_updated || !(flags & FLAG_SKIP_NOTIFY));
+		flags = (flags & ~(FLAG_CHANGED | FLAG_SKIP_NOTIFY)) | FLAG_UPDATED;
+		if (report) {
+			flags |= FLAG_REPORT;
+		}
+		level->flags[i] = flags;
+	}
+}
+
+void TransformStore3D::_update_chunk(uint32_t p_chunk, UpdateLevel p_level) {
+	uint32_t from = p_chunk * PARALLEL_CHUNK_SIZE;
+	uint32_t to = MIN(from + PARALLEL_CHUNK_SIZE, levels[p_level.depth]->ids.size());
+	_update_range(p_level, from, to);
+}
+
+TransformStore3D::ID TransformStore3D::create(ID p_parent, ObjectID p_owner) {
+	ERR_FAIL_COND_V(p_parent != INVALID_ID && !_is_valid(p_parent), INVALID_ID);
+
+	ID id;
+	if (free_ids.size()) {
+		id = free_ids[free_ids.size() - 1];
+		free_ids.resize(free_ids.size() - 1);
+	} else {
+		id = entries.size();
+		entries.push_back(Entry());
+	}
+
+	entries[id].owner = p_owner;
+	_attach(id, p_parent);
+	_append(id, p_parent == INVALID_ID ? 0 : entries[p_parent].depth + 1, Transform(), 0);
+	count++;
+
+	return id;
+}
+
+void TransformStore3D::free(ID p_id) {
+	ERR_FAIL_COND(!_is_valid(p_id));
+	ERR_FAIL_COND_MSG(entries[p_id].children.size(), "Can't free a transform that still has children.");
+
+	_detach(p_id);
+	_remove(p_id);
+	entries[p_id].owner = ObjectID();
+	free_ids.push_back(p_id);
+	count--;
+}
+
+void TransformStore3D::set_parent(ID p_id, ID p_parent) {
+	ERR_FAIL_COND(!_is_valid(p_id));
+	ERR_FAIL_COND(p_parent != INVALID_ID && !_is_valid(p_parent));
+
+	if (entries[p_id].parent == p_parent) {
+		return;
+	}
+	for (ID p = p_parent; p != INVALID_ID; p = entries[p].parent) {
+		ERR_FAIL_COND_MSG(p == p_id, "Can't parent a transform to itself or one of its children.");
+	}
+
+	_detach(p_id);
+	_attach(p_id, p_parent);
+	_relocate_subtree(p_id);
+}
+
+TransformStore3D::ID TransformStore3D::get_parent(ID p_id) const {
+	ERR_FAIL_COND_V(!_is_valid(p_id), INVALID_ID);
+	return entries[p_id].parent;
+}
+
+uint32_t TransformStore3D::get_depth(ID p_id) const {
+	ERR_FAIL_COND_V(!_is_valid(p_id), INVALID_ID);
+	return entries[p_id].depth;
+}
+
+void TransformStore3D::set_local(ID p_id, const Transform &p_local, bool p_notify) {
+	ERR_FAIL_COND(!_is_valid(p_id));
+	const Entry &e = entries[p_id];
+	Level *level = levels[e.depth];
+
+	level->local[e.index] = p_local;
+	_mark_changed(level, e.index);
+	if (p_notify) {
+		level->flags[e.index] &= ~FLAG_SKIP_NOTIFY;
+	} else {
+		level->flags[e.index] |= FLAG_SKIP_NOTIFY;
+	}
+}
+
+Transform TransformStore3D::get_local(ID p_id) const {
+	ERR_FAIL_COND_V(!_is_valid(p_id), Transform());
+	const Entry &e = entries[p_id];
+	return levels[e.depth]->local[e.index];
+}
+
+Transform TransformStore3D::get_global(ID p_id) const {
+	ERR_FAIL_COND_V(!_is_valid(p_id), Transform());
+	const Entry &e = entries[p_id];
+	if (!pending_changes) {
+		return levels[e.depth]->global[e.index];
+	}
+
+	bool stale;
+	return _get_global(e.depth, e.index, stale);
+}
+
+bool TransformStore3D::is_global_stale(ID p_id) const {
+	ERR_FAIL_COND_V(!_is_valid(p_id), false);
+	if (!pending_changes) {
+		return false;
+	}
+
+	uint32_t depth = entries[p_id].depth;
+	uint32_t index = entries[p_id].index;
+	while (true) {
+		const Level *level = levels[depth];
+		if (level->flags[index] & FLAG_CHANGED) {
+			return true;
+		}
+		if (depth == 0) {
+			return false;
+		}
+		index = level->parent[index];
+		depth--;
+	}
+}
+
+void TransformStore3D::set_disable_scale(ID p_id, bool p_disable) {
+	ERR_FAIL_COND(!_is_valid(p_id));
+	const Entry &e = entries[p_id];
+	Level *level = levels[e.depth];
+
+	if (bool(level->flags[e.index] & FLAG_DISABLE_SCALE) == p_disable) {
+		return;
+	}
+	if (p_disable) {
+		level->flags[e.index] |= FLAG_DISABLE_SCALE;
+	} else {
+		level->flags[e.index] &= ~FLAG_DISABLE_SCALE;
+	}
+	_mark_changed(level, e.index);
+}
+
+void TransformStore3D::set_notify(ID p_id, bool p_notify) {
+	ERR_FAIL_COND(!_is_valid(p_id));
+	const Entry &e = entries[p_id];
+	if (p_notify) {
+		levels[e.depth]->flags[e.index] |= FLAG_NOTIFY;
+	} else {
+		levels[e.depth]->flags[e.index] &= ~FLAG_NOTIFY;
+	}
+}
+
+void TransformStore3D::skip_notify(ID p_id) {
+	ERR_FAIL_COND(!_is_valid(p_id));
+	const Entry &e = entries[p_id];
+	levels[e.depth]->flags[e.index] |= FLAG_SKIP_NOTIFY;
+}
+
+void TransformStore3D::update(LocalVector<ObjectID> &r_notify, ThreadWorkPool *p_pool) {
+	if (!pending_changes) {
+		return;
+	}
+
+	bool parent_updated = false;
+	for (uint32_t depth = 0; depth < levels.size(); depth++) {
+		Level *level = levels[depth];
+		if (!level->changes && !parent_updated) {
+			continue; // Nothing here or below the previous level moved.
+		}
+
+		UpdateLevel update_level;
+		update_level.depth = depth;
+		update_level.parent_updated = parent_updated;
+
+		uint32_t size = level->ids.size();
+		if (p_pool && size >= PARALLEL_MIN_LEVEL_SIZE) {
+			// Entries only read the previous level, so a level splits freely.
+			p_pool->do_work((size + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE, this, &TransformStore3D::_update_chunk, update_level);
+		} else {
+			_update_range(update_level, 0, size);
+		}
+		level->changes = 0;
+
+		parent_updated = false;
+		uint8_t *flags = level->flags.ptr();
+		for (uint32_t i = 0; i < size; i++) {
+			if (flags[i] & FLAG_UPDATED) {
+				parent_updated = true;
+			}
+			if (flags[i] & FLAG_REPORT) {
+				flags[i] &= ~FLAG_REPORT;
+				r_notify.push_back(entries[level->ids[i]].owner);
+			}
+		}
+	}
+
+	pending_changes = 0;
+}
+
+uint32_t TransformStore3D::get_level_size(uint32_t p_depth) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_depth, levels.size(), 0);
+	return levels[p_depth]->ids.size();
+}
+
+TransformStore3D::~TransformStore3D() {
+	for (uint32_t i = 0; i < levels.size(); i++) {
+		memdelete(levels[i]);
+	}
+}
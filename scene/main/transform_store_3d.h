@@ -0,0 +1,148 @@
+/*************************************************************************/
+/*  transform_store_3d.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TRANSFORM_STORE_3D_H
+#define TRANSFORM_STORE_3D_H
+
+#include "core/local_vector.h"
+#include "core/math/transform.h"
+#include "core/object_id.h"
+
+class ThreadWorkPool;
+
+// Keeps the local and global transforms of a Node3D hierarchy in contiguous
+// arrays, one level per depth, so every parent sits in the level before its
+// children. Setting a local transform only flags the entry; update() then
+// recomputes the stale global transforms level by level in a linear pass,
+// optionally spreading large levels over a thread pool. Entries are addressed
+// by stable IDs, as moving an entry to another depth relocates its subtree.
+class TransformStore3D {
+public:
+	typedef uint32_t ID;
+
+	enum {
+		INVALID_ID = 0xFFFFFFFF,
+		PARALLEL_MIN_LEVEL_SIZE = 1024, // Smaller levels aren't worth waking the threads.
+		PARALLEL_CHUNK_SIZE = 256,
+	};
+
+private:
+	enum {
+		FLAG_CHANGED = 1, // Local transform, parent or scale mode changed since the last update.
+		FLAG_UPDATED = 2, // Global transform was recomputed by the current update.
+		FLAG_NOTIFY = 4, // Owner wants to be told when its global transform changes.
+		FLAG_SKIP_NOTIFY = 8, // Last change was made with notifications off.
+		FLAG_REPORT = 16, // Owner must be notified once the current level is done.
+		FLAG_DISABLE_SCALE = 32,
+	};
+
+	struct Level {
+		LocalVector<Transform> local;
+		LocalVector<Transform> global;
+		LocalVector<uint32_t> parent; // Index in the previous level, INVALID_ID in the first one.
+		LocalVector<uint8_t> flags;
+		LocalVector<ID> ids;
+		volatile uint32_t changes = 0; // Nonzero if some entry may have FLAG_CHANGED.
+	};
+
+	struct Entry {
+		uint32_t depth = INVALID_ID; // INVALID_ID while free or being relocated.
+		uint32_t index = 0;
+		ID parent = INVALID_ID;
+		uint32_t child_index = 0; // Position in the parent's children.
+		LocalVector<ID> children;
+		ObjectID owner;
+	};
+
+	struct UpdateLevel {
+		uint32_t depth = 0;
+		bool parent_updated = false;
+	};
+
+	LocalVector<Level *> levels;
+	LocalVector<Entry> entries;
+	LocalVector<ID> free_ids;
+	volatile uint32_t pending_changes = 0;
+	uint32_t count = 0;
+
+	_FORCE_INLINE_ bool _is_valid(ID p_id) const {
+		return p_id < entries.size() && entries[p_id].depth != INVALID_ID;
+	}
+
+	void _mark_changed(Level *p_level, uint32_t p_index);
+	void _append(ID p_id, uint32_t p_depth, const Transform &p_local, uint8_t p_flags);
+	void _remove(ID p_id);
+	void _detach(ID p_id);
+	void _attach(ID p_id, ID p_parent);
+	void _relocate_subtree(ID p_id);
+	Transform _get_global(uint32_t p_depth, uint32_t p_index, bool &r_stale) const;
+
+	void _update_range(const UpdateLevel &p_level, uint32_t p_from, uint32_t p_to);
+	void _update_chunk(uint32_t p_chunk, UpdateLevel p_level);
+
+public:
+	// Adds an entry with an identity local transform below p_parent, or as a
+	// root if p_parent is INVALID_ID. p_owner is what update() reports.
+	ID create(ID p_parent, ObjectID p_owner);
+	// Removes an entry, which must not have children anymore.
+	void free(ID p_id);
+
+	void set_parent(ID p_id, ID p_parent);
+	ID get_parent(ID p_id) const;
+	uint32_t get_depth(ID p_id) const;
+
+	void set_local(ID p_id, const Transform &p_local, bool p_notify = true);
+	Transform get_local(ID p_id) const;
+
+	// Always up to date, computing from the nearest changed parent if the last
+	// update() is stale.
+	Transform get_global(ID p_id) const;
+	// True if the global transform changed since the last update().
+	bool is_global_stale(ID p_id) const;
+
+	void set_disable_scale(ID p_id, bool p_disable);
+	void set_notify(ID p_id, bool p_notify);
+	// Don't report p_id for its own pending changes in the next update().
+	void skip_notify(ID p_id);
+
+	// Recomputes every stale global transform, parents first, appending the
+	// owners of the entries that changed and want notifications to r_notify.
+	void update(LocalVector<ObjectID> &r_notify, ThreadWorkPool *p_pool = nullptr);
+	_FORCE_INLINE_ bool has_pending_changes() const { return pending_changes != 0; }
+
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+	_FORCE_INLINE_ uint32_t get_level_count() const { return levels.size(); }
+	uint32_t get_level_size(uint32_t p_depth) const;
+
+	TransformStore3D() {}
+	~TransformStore3D();
+};
+
+#endif // TRANSFORM_STORE_3D_H
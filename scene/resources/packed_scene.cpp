@@ -45,6 +45,90 @@ bool SceneState::can_instance() const {
 	return nodes.size() > 0;
 }
 
+const SceneState::InstanceProgram *SceneState::_get_instance_program() const {
+	MutexLock lock(instance_program_mutex);
+
+	if (instance_program) {
+		return instance_program;
+	}
+
+	InstanceProgram *program = memnew(InstanceProgram);
+
+	int nc = nodes.size();
+	program->nodes.resize(nc);
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+
+		if (n.type == TYPE_INSTANCED || n.instance >= 0 || (i == 0 && base_scene_idx >= 0)) {
+			continue; // Created by another scene, its class is only known once instanced.
+		}
+		if (n.type < 0 || n.type >= names.size() || !ClassDB::is_class_enabled(names[n.type])) {
+			continue;
+		}
+
+		StringName type = ClassDB::get_compatibility_remapped_class(names[n.type]);
+		if (!ClassDB::is_parent_class(type, "Node")) {
+			continue; // instance() substitutes a generic node, let it warn about it.
+		}
+
+		InstanceProgram::NodeProgram &np = program->nodes.write[i];
+		np.creation_func = ClassDB::get_creation_func(names[n.type]);
+		if (!np.creation_func) {
+			continue;
+		}
+
+		np.setters.resize(n.properties.size());
+		for (int j = 0; j < n.properties.size(); j++) {
+			if (n.properties[j].name < 0 || n.properties[j].name >= names.size()) {
+				continue;
+			}
+
+			ClassDB::PropertySetGet psg;
+			if (ClassDB::get_property_setget(type, names[n.properties[j].name], &psg) && psg._setptr) {
+				np.setters.write[j].method = psg._setptr;
+				np.setters.write[j].index = psg.index;
+			}
+		}
+	}
+
+	program->connection_binds.resize(connections.size());
+	for (int i = 0; i < connections.size(); i++) {
+		const ConnectionData &c = connections[i];
+		Vector<Variant> &binds = program->connection_binds.write[i];
+
+		binds.resize(c.binds.size());
+		for (int j = 0; j < c.binds.size(); j++) {
+			binds.write[j] = variants[c.binds[j]];
+		}
+	}
+
+	instance_program = program;
+	return instance_program;
+}
+
+void SceneState::_clear_instance_program() {
+	MutexLock lock(instance_program_mutex);
+
+	if (instance_program) {
+		memdelete(instance_program);
+		instance_program = nullptr;
+	}
+}
+
+static _FORCE_INLINE_ void _call_property_setter(Object *p_object, MethodBind *p_setter, int p_index, const Variant &p_value) {
+	// Same call ClassDB::set_property() makes, minus the lookups.
+	Callable::CallError ce;
+	if (p_index >= 0) {
+		Variant index = p_index;
+		const Variant *args[2] = { &index, &p_value };
+		p_setter->call(p_object, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		p_setter->call(p_object, args, 1, ce);
+	}
+}
+
 Node *SceneState::instance(GenEditState p_edit_state) const {
 	// nodes where instancing failed (because something is missing)
 	List<Node *> stray_instances;
@@ -84,6 +168,13 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 	Map<Ref<Resource>, Ref<Resource>> resources_local_to_scene;
 
+	// Pre-resolved constructors and setters are only used at runtime. In the
+	// editor everything goes through Object::set(), which also tracks edits.
+	const InstanceProgram *program = nullptr;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		program = _get_instance_program();
+	}
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
 
@@ -147,6 +238,10 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 				}
 #endif
 			}
+		} else if (program && program->nodes[i].creation_func) {
+			//node belongs to this scene, and its constructor was resolved beforehand
+			node = Object::cast_to<Node>(program->nodes[i].creation_func());
+
 		} else if (ClassDB::is_class_enabled(snames[n.type])) {
 			//node belongs to this scene and must be created
 			Object *obj = ClassDB::instance(snames[n.type]);
@@ -186,6 +281,10 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 			int nprop_count = n.properties.size();
 			if (nprop_count) {
 				const NodeData::Property *nprops = &n.properties[0];
+				const InstanceProgram::Setter *setters = nullptr;
+				if (program && program->nodes[i].creation_func && program->nodes[i].setters.size() == nprop_count) {
+					setters = program->nodes[i].setters.ptr();
+				}
 
 				for (int j = 0; j < nprop_count; j++) {
 					bool valid;
@@ -243,7 +342,12 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
 						}
-						node->set(snames[nprops[j].name], value, &valid);
+
+						if (setters && setters[j].method && !node->get_script_instance()) {
+							_call_property_setter(node, setters[j].method, setters[j].index, value);
+						} else {
+							node->set(snames[nprops[j].name], value, &valid);
+						}
 					}
 				}
 			}
@@ -317,7 +421,9 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 		}
 
 		Vector<Variant> binds;
-		if (c.binds.size()) {
+		if (program) {
+			binds = program->connection_binds[i];
+		} else if (c.binds.size()) {
 			binds.resize(c.binds.size());
 			for (int j = 0; j < c.binds.size(); j++) {
 				binds.write[j] = props[c.binds[j]];
@@ -900,6 +1006,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instance_program();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1056,6 +1163,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_clear_instance_program();
+
 	int version = 1;
 	if (p_dictionary.has("version")) {
 		version = p_dictionary["version"];
@@ -1510,6 +1619,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.instance = p_instance;
 	nd.index = p_index;
 
+	_clear_instance_program();
 	nodes.push_back(nd);
 
 	return nodes.size() - 1;
@@ -1520,6 +1630,8 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	ERR_FAIL_INDEX(p_name, names.size());
 	ERR_FAIL_INDEX(p_value, variants.size());
 
+	_clear_instance_program();
+
 	NodeData::Property prop;
 	prop.name = p_name;
 	prop.value = p_value;
@@ -1534,6 +1646,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instance_program();
 	base_scene_idx = p_idx;
 }
 
@@ -1551,6 +1664,7 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	c.method = p_method;
 	c.flags = p_flags;
 	c.binds = p_binds;
+	_clear_instance_program();
 	connections.push_back(c);
 }
 
@@ -1601,6 +1715,11 @@ void SceneState::_bind_methods() {
 SceneState::SceneState() {
 	base_scene_idx = -1;
 	last_modified_time = 0;
+	instance_program = nullptr;
+}
+
+SceneState::~SceneState() {
+	_clear_instance_program();
 }
 
 ////////////////
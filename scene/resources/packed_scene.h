@@ -31,6 +31,7 @@
 #ifndef PACKED_SCENE_H
 #define PACKED_SCENE_H
 
+#include "core/os/mutex.h"
 #include "core/resource.h"
 #include "scene/main/node.h"
 
@@ -88,6 +89,29 @@ class SceneState : public Reference {
 
 	Vector<ConnectionData> connections;
 
+	// Work that is the same for every instance, resolved by instance() on first
+	// use so it is not repeated per node. Dropped whenever the state changes.
+	struct InstanceProgram {
+		struct Setter {
+			MethodBind *method = nullptr; // nullptr if the property must go through Object::set().
+			int index = -1;
+		};
+
+		struct NodeProgram {
+			Object *(*creation_func)() = nullptr;
+			Vector<Setter> setters; // Parallel to NodeData::properties, empty if the class is not known.
+		};
+
+		Vector<NodeProgram> nodes;
+		Vector<Vector<Variant>> connection_binds;
+	};
+
+	mutable Mutex instance_program_mutex;
+	mutable InstanceProgram *instance_program;
+
+	const InstanceProgram *_get_instance_program() const;
+	void _clear_instance_program();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
@@ -186,6 +210,7 @@ public:
 	uint64_t get_last_modified_time() const { return last_modified_time; }
 
 	SceneState();
+	~SceneState();
 };
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
@@ -763,6 +763,8 @@ void ResourceLoaderText::get_dependencies(FileAccess *p_f, List<String> *p_depen
 }
 
 Error ResourceLoaderText::rename_dependencies(FileAccess *p_f, const String &p_path, const Map<String, String> &p_map) {
+	// The rest of the file is copied verbatim from the position after the last parsed tag.
+	stream.readahead_enabled = false;
 	open(p_f, true);
 	ERR_FAIL_COND_V(error != OK, error);
 	ignore_resource_parsing = true;
@@ -960,7 +962,7 @@ Error ResourceLoaderText::save_as_binary(FileAccess *p_f, const String &p_path)
 	wf->store_32(0); //64 bits file, false for now
 	wf->store_32(VERSION_MAJOR);
 	wf->store_32(VERSION_MINOR);
-	static const int save_format_version = 3; //use format version 3 for saving
+	static const int save_format_version = 4; //use format version 4 for saving, string arrays are written with VARIANT_STRING_ARRAY_UTF8
 	wf->store_32(save_format_version);
 
 	bs_save_unicode_string(wf.f, is_scene ? "PackedScene" : resource_type);
@@ -31,6 +31,7 @@
 #include "texture.h"
 
 #include "core/core_string_names.h"
+#include "core/io/file_access_async.h"
 #include "core/io/image_loader.h"
 #include "core/method_bind_ext.gen.inc"
 #include "core/os/os.h"
@@ -353,37 +354,76 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 		Vector<Ref<Image>> mipmap_images;
 		int total_size = 0;
 
-		bool first = true;
+		//find where each mipmap is first, so all of them can be requested at once
+		Vector<Vector<uint8_t>> mipmap_data;
+		Vector<FileAccessAsync::Read> reads;
 
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			uint32_t size = f->get_32();
+			uint64_t ofs = f->get_position();
+			f->seek(ofs + size);
 
 			if (p_size_limit > 0 && i < (mipmaps - 1) && (sw > p_size_limit || sh > p_size_limit)) {
 				//can't load this due to size limit
 				sw = MAX(sw >> 1, 1);
 				sh = MAX(sh >> 1, 1);
-				f->seek(f->get_position() + size);
 				continue;
 			}
 
 			Vector<uint8_t> pv;
 			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
+			mipmap_data.push_back(pv);
+
+			FileAccessAsync::Read read;
+			read.file = f;
+			read.offset = ofs;
+			read.length = size;
+			reads.push_back(read);
+
+			sw = MAX(sw >> 1, 1);
+			sh = MAX(sh >> 1, 1);
+		}
+
+		//with positional reads, the smaller mipmaps are read on the I/O threads while the bigger ones are decoded
+		bool async = f->has_concurrent_reads() && reads.size() > 1;
+		Vector<FileAccessAsync::RequestID> read_ids;
+		for (int i = 0; i < reads.size(); i++) {
+			reads.write[i].dst = mipmap_data.write[i].ptrw();
+		}
+		if (async) {
+			read_ids.resize(reads.size());
+			FileAccessAsync::read_batch(reads.ptr(), reads.size(), read_ids.ptrw());
+		}
+
+		bool first = true;
+		bool failed = false;
+
+		for (int i = 0; i < reads.size(); i++) {
+			int read = 0;
+			if (async) {
+				FileAccessAsync::wait(read_ids[i], &read);
+			} else {
+				read = f->get_buffer_at(reads[i].offset, reads[i].dst, reads[i].length);
+			}
+
+			//all pending reads still need to be waited on, as they write into mipmap_data
+			if (failed || read != reads[i].length) {
+				failed = true;
+				continue;
 			}
 
 			Ref<Image> img;
 			if (data_format == DATA_FORMAT_BASIS_UNIVERSAL) {
-				img = Image::basis_universal_unpacker(pv);
+				img = Image::basis_universal_unpacker(mipmap_data[i]);
 			} else if (data_format == DATA_FORMAT_LOSSLESS) {
-				img = Image::lossless_unpacker(pv);
+				img = Image::lossless_unpacker(mipmap_data[i]);
 			} else {
-				img = Image::lossy_unpacker(pv);
+				img = Image::lossy_unpacker(mipmap_data[i]);
 			}
 
 			if (img.is_null() || img->empty()) {
-				ERR_FAIL_COND_V(img.is_null() || img->empty(), Ref<Image>());
+				failed = true;
+				continue;
 			}
 
 			if (first) {
@@ -398,11 +438,10 @@ Ref<Image> StreamTexture2D::load_image_from_file(FileAccess *f, int p_size_limit
 			total_size += img->get_data().size();
 
 			mipmap_images.push_back(img);
-
-			sw = MAX(sw >> 1, 1);
-			sh = MAX(sh >> 1, 1);
 		}
 
+		ERR_FAIL_COND_V(failed, Ref<Image>());
+
 		//print_line("mipmap read total: " + itos(mipmap_images.size()));
 
 		Ref<Image> image;
@@ -99,6 +99,7 @@ SceneStringNames::SceneStringNames() {
 	_enter_world = StaticCString::create("_enter_world");
 	_exit_world = StaticCString::create("_exit_world");
 	_ready = StaticCString::create("_ready");
+	_pool_reset = StaticCString::create("_pool_reset");
 
 	_update_scroll = StaticCString::create("_update_scroll");
 	_update_xform = StaticCString::create("_update_xform");
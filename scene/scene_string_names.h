@@ -120,6 +120,7 @@ public:
 	StringName _draw;
 	StringName _input;
 	StringName _ready;
+	StringName _pool_reset;
 	StringName _unhandled_input;
 	StringName _unhandled_key_input;
 
@@ -601,11 +601,8 @@ void RenderingServerScene::instance_set_layer_mask(RID p_instance, uint32_t p_ma
 	instance->layer_mask = p_mask;
 }
 
-void RenderingServerScene::instance_set_transform(RID p_instance, const Transform &p_transform) {
-	Instance *instance = instance_owner.getornull(p_instance);
-	ERR_FAIL_COND(!instance);
-
-	if (instance->transform == p_transform) {
+void RenderingServerScene::_instance_set_transform(Instance *p_instance, const Transform &p_transform) {
+	if (p_instance->transform == p_transform) {
 		return; //must be checked to avoid worst evil
 	}
 
@@ -622,8 +619,31 @@ void RenderingServerScene::instance_set_transform(RID p_instance, const Transfor
 	}
 
 #endif
-	instance->transform = p_transform;
-	_instance_queue_update(instance, true);
+	p_instance->transform = p_transform;
+	_instance_queue_update(p_instance, true);
+}
+
+void RenderingServerScene::instance_set_transform(RID p_instance, const Transform &p_transform) {
+	Instance *instance = instance_owner.getornull(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	_instance_set_transform(instance, p_transform);
+}
+
+void RenderingServerScene::instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	int count = p_instances.size();
+	const RID *instances = p_instances.ptr();
+	const Transform *transforms = p_transforms.ptr();
+
+	for (int i = 0; i < count; i++) {
+		Instance *instance = instance_owner.getornull(instances[i]);
+		if (!instance) {
+			continue; // Batches are gathered during one flush_transform_notifications() pass, and a notification handler may have freed the instance before it was sent.
+		}
+		_instance_set_transform(instance, transforms[i]);
+	}
 }
 
 void RenderingServerScene::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
@@ -0,0 +1,176 @@
+/*************************************************************************/
+/*  test_file_access_async.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_FILE_ACCESS_ASYNC_H
+#define TEST_FILE_ACCESS_ASYNC_H
+
+#include "core/io/file_access_async.h"
+#include "core/io/file_access_memory.h"
+#include "core/os/dir_access.h"
+#include "core/os/os.h"
+#include "core/safe_refcount.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestFileAccessAsync {
+
+static Vector<uint8_t> _make_data(int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		data.write[i] = uint8_t(i * 7 + i / 256);
+	}
+	return data;
+}
+
+static bool _matches(const Vector<uint8_t> &p_data, uint64_t p_offset, const uint8_t *p_read, int p_length) {
+	for (int i = 0; i < p_length; i++) {
+		if (p_data[p_offset + i] != p_read[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Reads a few overlapping ranges at once, and one past the end.
+static void _check_batch(FileAccess *p_file, const Vector<uint8_t> &p_data) {
+	const int count = 4;
+	const uint64_t offsets[count] = { 0, 1000, 4096, uint64_t(p_data.size() - 100) };
+	uint8_t buffers[count][500];
+
+	FileAccessAsync::Read reads[count];
+	for (int i = 0; i < count; i++) {
+		reads[i].file = p_file;
+		reads[i].offset = offsets[i];
+		reads[i].dst = buffers[i];
+		reads[i].length = 500;
+	}
+
+	FileAccessAsync::RequestID ids[count];
+	FileAccessAsync::read_batch(reads, count, ids);
+
+	for (int i = 0; i < count - 1; i++) {
+		int read = 0;
+		CHECK(FileAccessAsync::wait(ids[i], &read) == OK);
+		CHECK(read == 500);
+		CHECK(_matches(p_data, offsets[i], buffers[i], 500));
+		CHECK(FileAccessAsync::is_done(ids[i]));
+	}
+
+	int read = 0;
+	CHECK(FileAccessAsync::wait(ids[count - 1], &read) == ERR_FILE_EOF);
+	CHECK(read == 100);
+	CHECK(_matches(p_data, offsets[count - 1], buffers[count - 1], 100));
+}
+
+TEST_CASE("[FileAccessAsync] Ranged reads from a file") {
+	Vector<uint8_t> data = _make_data(16384);
+	const String test_path = OS::get_singleton()->get_cache_path().plus_file("godot_test_file_access_async");
+	{
+		FileAccessRef f = FileAccess::open(test_path, FileAccess::WRITE);
+		REQUIRE(f);
+		f->store_buffer(data.ptr(), data.size());
+	}
+
+	FileAccessRef f = FileAccess::open(test_path, FileAccess::READ);
+	REQUIRE(f);
+	_check_batch(f.f, data);
+
+	// Positional reads leave the cursor alone.
+	CHECK(f->get_position() == 0);
+	f->close();
+
+	DirAccess::remove_file_or_error(test_path);
+}
+
+TEST_CASE("[FileAccessAsync] Ranged reads from files without concurrent reads") {
+	Vector<uint8_t> data = _make_data(8192);
+
+	FileAccessMemory *first = memnew(FileAccessMemory);
+	FileAccessMemory *second = memnew(FileAccessMemory);
+	REQUIRE(first->open_custom(data.ptr(), data.size()) == OK);
+	REQUIRE(second->open_custom(data.ptr(), data.size()) == OK);
+	CHECK_FALSE(first->has_concurrent_reads());
+
+	_check_batch(first, data);
+	_check_batch(second, data);
+
+	memdelete(first);
+	memdelete(second);
+}
+
+struct CompletionData {
+	volatile uint32_t completed = 0;
+	volatile uint32_t bytes = 0;
+	Semaphore done;
+};
+
+static void _completion(void *p_userdata, FileAccessAsync::RequestID p_id, Error p_error, int p_read) {
+	CompletionData *cd = (CompletionData *)p_userdata;
+	if (p_error == OK) {
+		atomic_add(&cd->bytes, (uint32_t)p_read);
+	}
+	atomic_increment(&cd->completed);
+	cd->done.post();
+}
+
+TEST_CASE("[FileAccessAsync] Completion callbacks") {
+	Vector<uint8_t> data = _make_data(4096);
+	FileAccessMemory *file = memnew(FileAccessMemory);
+	REQUIRE(file->open_custom(data.ptr(), data.size()) == OK);
+
+	CompletionData cd;
+	uint8_t buffers[8][256];
+	FileAccessAsync::Read reads[8];
+	for (int i = 0; i < 8; i++) {
+		reads[i].file = file;
+		reads[i].offset = i * 512;
+		reads[i].dst = buffers[i];
+		reads[i].length = 256;
+		reads[i].completion = _completion;
+		reads[i].userdata = &cd;
+	}
+	FileAccessAsync::read_batch(reads, 8);
+
+	for (int i = 0; i < 8; i++) {
+		cd.done.wait();
+	}
+	CHECK(cd.completed == 8);
+	CHECK(cd.bytes == 8 * 256);
+	for (int i = 0; i < 8; i++) {
+		CHECK(_matches(data, i * 512, buffers[i], 256));
+	}
+
+	memdelete(file);
+}
+
+} // namespace TestFileAccessAsync
+
+#endif // TEST_FILE_ACCESS_ASYNC_H
@@ -0,0 +1,219 @@
+/*************************************************************************/
+/*  test_http_connection_pool.h                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_HTTP_CONNECTION_POOL_H
+#define TEST_HTTP_CONNECTION_POOL_H
+
+#include "core/set.h"
+#include "scene/main/http_connection_pool.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestHTTPConnectionPool {
+
+// Clients stay "connected" until closed or dropped, without any server.
+class StubPool : public HTTPConnectionPool {
+public:
+	Set<HTTPClient *> dropped;
+	Set<HTTPClient *> closed;
+	int created = 0;
+	uint64_t now = 0;
+
+protected:
+	virtual Ref<HTTPClient> _create_client() override {
+		created++;
+		Ref<HTTPClient> client;
+		client.instance();
+		return client;
+	}
+	virtual bool _is_client_connected(Ref<HTTPClient> p_client) override {
+		return !dropped.has(p_client.ptr()) && !closed.has(p_client.ptr());
+	}
+	virtual void _close_client(Ref<HTTPClient> p_client) override {
+		closed.insert(p_client.ptr());
+	}
+	virtual uint64_t _get_ticks_msec() const override {
+		return now;
+	}
+};
+
+TEST_CASE("[HTTPConnectionPool] Released connections are reused") {
+	StubPool pool;
+	const String key = HTTPConnectionPool::make_key(false, "example.com", 80, true);
+	CHECK(key != HTTPConnectionPool::make_key(true, "example.com", 80, true));
+
+	Ref<HTTPClient> first;
+	bool reused = true;
+	CHECK(pool.acquire(key, first, reused) == OK);
+	CHECK(!reused);
+	CHECK(pool.get_active_count(key) == 1);
+
+	pool.release(key, first, true);
+	CHECK(pool.get_active_count(key) == 0);
+	CHECK(pool.get_idle_count(key) == 1);
+
+	Ref<HTTPClient> second;
+	CHECK(pool.acquire(key, second, reused) == OK);
+	CHECK(reused);
+	CHECK(second == first);
+	CHECK(pool.created == 1);
+
+	// Not kept when the response asked to close it.
+	pool.release(key, second, false);
+	CHECK(pool.get_idle_count(key) == 0);
+	CHECK(pool.closed.has(second.ptr()));
+
+	// Nor when the server dropped it while idle.
+	Ref<HTTPClient> third;
+	pool.acquire(key, third, reused);
+	pool.release(key, third, true);
+	pool.dropped.insert(third.ptr());
+	Ref<HTTPClient> fourth;
+	CHECK(pool.acquire(key, fourth, reused) == OK);
+	CHECK(!reused);
+	CHECK(fourth != third);
+	pool.release(key, fourth, true);
+
+	// Nor once expired.
+	pool.now += pool.get_keep_alive_msec() + 1;
+	Ref<HTTPClient> fifth;
+	CHECK(pool.acquire(key, fifth, reused) == OK);
+	CHECK(!reused);
+	CHECK(pool.closed.has(fourth.ptr()));
+	pool.release(key, fifth, true);
+}
+
+TEST_CASE("[HTTPConnectionPool] Active and idle connections are capped per host") {
+	StubPool pool;
+	pool.set_max_connections_per_host(2);
+	const String key = HTTPConnectionPool::make_key(true, "example.com", 443, true);
+	const String other_key = HTTPConnectionPool::make_key(true, "example.org", 443, true);
+
+	Ref<HTTPClient> a;
+	Ref<HTTPClient> b;
+	Ref<HTTPClient> c;
+	bool reused;
+	CHECK(pool.acquire(key, a, reused) == OK);
+	CHECK(pool.acquire(key, b, reused) == OK);
+
+	Semaphore waiter;
+	CHECK(pool.acquire(key, c, reused, &waiter) == ERR_BUSY);
+	CHECK(pool.acquire(other_key, c, reused) == OK);
+	pool.release(other_key, c, true);
+
+	// Releasing wakes the waiting request up.
+	CHECK(!waiter.try_wait());
+	pool.release(key, a, true);
+	CHECK(waiter.try_wait());
+	CHECK(pool.acquire(key, c, reused) == OK);
+	CHECK(reused);
+	CHECK(c == a);
+
+	// The waiting list doesn't outlive a cancel.
+	Ref<HTTPClient> d;
+	CHECK(pool.acquire(key, d, reused, &waiter) == ERR_BUSY);
+	pool.cancel_wait(key, &waiter);
+	pool.release(key, b, true);
+	CHECK(!waiter.try_wait());
+	pool.release(key, c, true);
+	CHECK(pool.get_idle_count(key) == 2);
+
+	// No more idle connections than allowed active ones.
+	pool.set_max_connections_per_host(1);
+	CHECK(pool.acquire(key, d, reused) == OK);
+	pool.release(key, d, true);
+	CHECK(pool.get_idle_count(key) == 1);
+}
+
+TEST_CASE("[HTTPConnectionPool] No limit keeps every idle connection") {
+	StubPool pool;
+	pool.set_max_connections_per_host(0);
+	const String key = HTTPConnectionPool::make_key(false, "example.com", 8080, false);
+
+	Vector<Ref<HTTPClient>> clients;
+	for (int i = 0; i < 10; i++) {
+		Ref<HTTPClient> client;
+		bool reused;
+		CHECK(pool.acquire(key, client, reused) == OK);
+		clients.push_back(client);
+	}
+	CHECK(pool.get_active_count(key) == 10);
+	for (int i = 0; i < clients.size(); i++) {
+		pool.release(key, clients[i], true);
+	}
+	CHECK(pool.get_idle_count(key) == 10);
+	CHECK(pool.closed.size() == 0);
+}
+
+TEST_CASE("[HTTPConnectionPool] Retrying on a new connection") {
+	StubPool pool;
+	const String key = HTTPConnectionPool::make_key(false, "example.com", 80, true);
+
+	Ref<HTTPClient> client;
+	bool reused;
+	pool.acquire(key, client, reused);
+	Ref<HTTPClient> renewed = pool.renew(client);
+	CHECK(renewed != client);
+	CHECK(pool.closed.has(client.ptr()));
+	CHECK(pool.get_active_count(key) == 1); // Still the same slot.
+	pool.release(key, renewed, true);
+	CHECK(pool.get_active_count(key) == 0);
+
+	CHECK(HTTPConnectionPool::can_retry(HTTPClient::METHOD_GET));
+	CHECK(HTTPConnectionPool::can_retry(HTTPClient::METHOD_HEAD));
+	CHECK(!HTTPConnectionPool::can_retry(HTTPClient::METHOD_POST));
+	CHECK(!HTTPConnectionPool::can_retry(HTTPClient::METHOD_PUT));
+	CHECK(!HTTPConnectionPool::can_retry(HTTPClient::METHOD_PATCH));
+}
+
+TEST_CASE("[HTTPConnectionPool] Connection header options") {
+	Vector<String> headers;
+	headers.push_back("Content-Length: 5");
+	CHECK(HTTPConnectionPool::is_keep_alive(headers));
+
+	headers.push_back("Connection: keep-alive");
+	CHECK(HTTPConnectionPool::is_keep_alive(headers));
+
+	headers.write[1] = "connection:Keep-Alive, Close";
+	CHECK(!HTTPConnectionPool::is_keep_alive(headers));
+
+	headers.write[1] = "CONNECTION : close";
+	CHECK(!HTTPConnectionPool::is_keep_alive(headers));
+
+	// Only the Connection header counts.
+	headers.write[1] = "X-Note: connection: close";
+	CHECK(HTTPConnectionPool::is_keep_alive(headers));
+	headers.write[1] = "Connection: closed-captions";
+	CHECK(HTTPConnectionPool::is_keep_alive(headers));
+}
+
+} // namespace TestHTTPConnectionPool
+
+#endif // TEST_HTTP_CONNECTION_POOL_H
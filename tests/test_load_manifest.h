@@ -0,0 +1,138 @@
+/*************************************************************************/
+/*  test_load_manifest.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_LOAD_MANIFEST_H
+#define TEST_LOAD_MANIFEST_H
+
+#include "core/io/resource_loader.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestLoadManifest {
+
+// Written to user data, which is recorded like project files, so the tests don't touch the project.
+static const char *test_files[] = {
+	"user://godot_test_load_manifest_a",
+	"user://godot_test_load_manifest_b",
+	"user://godot_test_load_manifest_c",
+};
+
+static const char *manifest_path = "user://godot_test_load_manifest";
+
+static void _create_files() {
+	DirAccessRef user_dir = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	user_dir->make_dir_recursive(OS::get_singleton()->get_user_data_dir());
+	for (int i = 0; i < 3; i++) {
+		FileAccessRef f = FileAccess::open(test_files[i], FileAccess::WRITE);
+		REQUIRE(f);
+		f->store_string("data");
+	}
+}
+
+static void _remove_files() {
+	DirAccessRef da = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	for (int i = 0; i < 3; i++) {
+		da->remove(test_files[i]);
+	}
+	da->remove(manifest_path);
+}
+
+static void _open(const String &p_path) {
+	FileAccessRef f = FileAccess::open(p_path, FileAccess::READ);
+	CHECK(f);
+}
+
+// Returns the recorded paths, checking that each comes with a time that doesn't go back.
+static Vector<String> _read_manifest() {
+	Vector<String> paths;
+	FileAccessRef f = FileAccess::open(manifest_path, FileAccess::READ);
+	REQUIRE(f);
+	int64_t last_usec = 0;
+	while (!f->eof_reached()) {
+		Vector<String> line = f->get_csv_line();
+		if (line.size() == 0 || line[0] == String()) {
+			continue;
+		}
+		REQUIRE(line.size() == 2);
+		CHECK(line[1].is_valid_integer());
+		CHECK(line[1].to_int() >= last_usec);
+		last_usec = line[1].to_int();
+		paths.push_back(line[0]);
+	}
+	return paths;
+}
+
+TEST_CASE("[LoadManifest] Files are recorded once, in the order they are first opened") {
+	_create_files();
+
+	ResourceLoader::begin_load_manifest_recording();
+	CHECK(ResourceLoader::is_recording_load_manifest());
+	_open(test_files[2]);
+	_open(test_files[0]);
+	_open(test_files[2]);
+	CHECK(ResourceLoader::end_load_manifest_recording(manifest_path) == OK);
+	CHECK_FALSE(ResourceLoader::is_recording_load_manifest());
+
+	Vector<String> manifest = _read_manifest();
+	REQUIRE(manifest.size() == 2);
+	CHECK(manifest[0] == test_files[2]);
+	CHECK(manifest[1] == test_files[0]);
+
+	_remove_files();
+}
+
+TEST_CASE("[LoadManifest] Prefetching does not end up in a recording") {
+	_create_files();
+
+	ResourceLoader::begin_load_manifest_recording();
+	_open(test_files[0]);
+	_open(test_files[1]);
+	_open(test_files[2]);
+	CHECK(ResourceLoader::end_load_manifest_recording(manifest_path) == OK);
+
+	ResourceLoader::begin_load_manifest_recording();
+	CHECK(ResourceLoader::prefetch_load_manifest(manifest_path) == OK);
+	ResourceLoader::wait_for_load_manifest_prefetch();
+	_open(test_files[1]);
+	CHECK(ResourceLoader::end_load_manifest_recording(manifest_path) == OK);
+
+	Vector<String> manifest = _read_manifest();
+	REQUIRE(manifest.size() == 1);
+	CHECK(manifest[0] == test_files[1]);
+
+	_remove_files();
+}
+
+} // namespace TestLoadManifest
+
+#endif // TEST_LOAD_MANIFEST_H
@@ -37,17 +37,32 @@
 #include "test_class_db.h"
 #include "test_color.h"
 #include "test_expression.h"
+#include "test_file_access_async.h"
 #include "test_gdnative_string.h"
 #include "test_gradient.h"
 #include "test_gui.h"
+#include "test_http_connection_pool.h"
+#include "test_load_manifest.h"
+#include "test_marshalls.h"
 #include "test_math.h"
+#include "test_multiplayer_loopback.h"
+#include "test_node.h"
+#include "test_node_path_cache.h"
+#include "test_node_pool.h"
 #include "test_oa_hash_map.h"
 #include "test_ordered_hash_map.h"
+#include "test_packed_scene.h"
 #include "test_physics_2d.h"
 #include "test_physics_3d.h"
+#include "test_process_thread_batcher.h"
 #include "test_render.h"
+#include "test_resource_soft_cache.h"
+#include "test_scene_tree.h"
 #include "test_shader_lang.h"
 #include "test_string.h"
+#include "test_timer_wheel.h"
+#include "test_transform_store_3d.h"
+#include "test_udp_server.h"
 #include "test_validate_testing.h"
 #include "test_variant.h"
 
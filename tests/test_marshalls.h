@@ -0,0 +1,126 @@
+/*************************************************************************/
+/*  test_marshalls.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_MARSHALLS_H
+#define TEST_MARSHALLS_H
+
+#include "core/io/marshalls.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestMarshalls {
+
+TEST_CASE("[Marshalls] BitWriter and BitReader round trip") {
+	Vector<uint8_t> buffer;
+	BitWriter writer(buffer);
+
+	writer.put_bits(5, 3);
+	writer.put_bool(true);
+	writer.put_bits(0x1FFFF, 17);
+	writer.put_bits(0xDEADBEEFCAFEull, 48);
+	writer.put_float(-1.5f);
+	writer.put_varint(0);
+	writer.put_varint(127);
+	writer.put_varint(128);
+	writer.put_varint(UINT64_MAX);
+	writer.put_zigzag(-1);
+	writer.put_zigzag(INT64_MIN);
+	writer.put_zigzag(123456789);
+	const uint8_t bytes[3] = { 1, 2, 3 };
+	writer.put_bytes(bytes, 3);
+	writer.put_bool(false);
+
+	const int size = writer.get_byte_size();
+	REQUIRE(size <= buffer.size());
+
+	BitReader reader(buffer.ptr(), size);
+	CHECK(reader.get_bits(3) == 5);
+	CHECK(reader.get_bool());
+	CHECK(reader.get_bits(17) == 0x1FFFF);
+	CHECK(reader.get_bits(48) == 0xDEADBEEFCAFEull);
+	CHECK(reader.get_float() == -1.5f);
+	CHECK(reader.get_varint() == 0);
+	CHECK(reader.get_varint() == 127);
+	CHECK(reader.get_varint() == 128);
+	CHECK(reader.get_varint() == UINT64_MAX);
+	CHECK(reader.get_zigzag() == -1);
+	CHECK(reader.get_zigzag() == INT64_MIN);
+	CHECK(reader.get_zigzag() == 123456789);
+	const uint8_t *read = reader.read_bytes(3);
+	REQUIRE(read != nullptr);
+	CHECK(read[0] == 1);
+	CHECK(read[1] == 2);
+	CHECK(read[2] == 3);
+	CHECK_FALSE(reader.get_bool());
+	CHECK_FALSE(reader.has_error());
+	CHECK(reader.get_byte_position() == size);
+}
+
+TEST_CASE("[Marshalls] BitWriter keeps bytes before its offset") {
+	Vector<uint8_t> buffer;
+	buffer.resize(2);
+	buffer.write[0] = 0xAB;
+	buffer.write[1] = 0xCD;
+
+	BitWriter writer(buffer, 2);
+	writer.put_bits(0x3, 2);
+	writer.put_zigzag(-64);
+	CHECK(buffer[0] == 0xAB);
+	CHECK(buffer[1] == 0xCD);
+
+	BitReader reader(buffer.ptr(), writer.get_byte_size(), 2);
+	CHECK(reader.get_bits(2) == 0x3);
+	CHECK(reader.get_zigzag() == -64);
+	CHECK_FALSE(reader.has_error());
+}
+
+TEST_CASE("[Marshalls] BitReader reports reads past the end") {
+	const uint8_t data[2] = { 0xFF, 0x01 };
+
+	BitReader reader(data, 2);
+	CHECK(reader.get_bits(12) == 0x1FF);
+	CHECK_FALSE(reader.has_error());
+	CHECK(reader.get_bits(8) == 0);
+	CHECK(reader.has_error());
+
+	BitReader bytes_reader(data, 2);
+	CHECK(bytes_reader.read_bytes(3) == nullptr);
+	CHECK(bytes_reader.has_error());
+
+	// Every group has its continuation bit set, so the varint never ends.
+	const uint8_t endless[2] = { 0xFF, 0xFF };
+	BitReader varint_reader(endless, 2);
+	varint_reader.get_varint();
+	CHECK(varint_reader.has_error());
+}
+
+} // namespace TestMarshalls
+
+#endif // TEST_MARSHALLS_H
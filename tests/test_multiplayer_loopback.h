@@ -0,0 +1,790 @@
+/*************************************************************************/
+/*  test_multiplayer_loopback.h                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef TEST_MULTIPLAYER_LOOPBACK_H
+#define TEST_MULTIPLAYER_LOOPBACK_H
+
+#include "core/hash_map.h"
+#include "core/io/multiplayer_api.h"
+#include "core/io/networked_multiplayer_peer.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "scene/main/node.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMultiplayerLoopback {
+
+class LoopbackMultiplayerPeer;
+
+// Simulates the network between one server and many clients, all in the same process.
+// Time is virtual and only moves forward with advance(), so runs are deterministic
+// for a given seed and do not depend on the speed of the machine.
+class LoopbackNetwork : public Reference {
+	friend class LoopbackMultiplayerPeer;
+
+public:
+	struct Message {
+		enum Type {
+			DATA,
+			CONNECT,
+			DISCONNECT,
+		};
+
+		Type type = DATA;
+		int from = 0;
+		int to = 0;
+		NetworkedMultiplayerPeer::TransferMode mode = NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE;
+		Vector<uint8_t> data;
+	};
+
+	int latency_msec = 0; // One way.
+	int jitter_msec = 0; // Added to the latency, uniformly distributed in [0, jitter_msec].
+	float loss = 0; // Probability of losing a packet. Lost reliable packets are delivered after a retransmission delay instead.
+	int bandwidth = 0; // Bytes per second for each direction of each link, 0 means unlimited.
+
+private:
+	struct Link {
+		uint64_t tx_free_usec = 0; // When the link is done serializing the previous packets.
+		uint64_t ordered_usec[3] = { 0, 0, 0 }; // Last delivery time per transfer mode, to keep ordered modes in order.
+	};
+
+	uint64_t time_usec = 0;
+	RandomPCG rng;
+	int last_id = 1;
+	HashMap<int, LoopbackMultiplayerPeer *> peers;
+	HashMap<uint64_t, Link> links;
+	Map<uint64_t, List<Message>> in_flight; // Keyed by delivery time.
+
+	void _send(const Message &p_message);
+	void _deliver(const Message &p_message);
+
+public:
+	uint64_t get_time_usec() const { return time_usec; }
+	int get_in_flight_count() const;
+	void advance(uint64_t p_usec);
+
+	Ref<LoopbackMultiplayerPeer> create_server();
+	Ref<LoopbackMultiplayerPeer> create_client();
+
+	LoopbackNetwork(uint64_t p_seed = 0) :
+			rng(p_seed) {}
+};
+
+class LoopbackMultiplayerPeer : public NetworkedMultiplayerPeer {
+	GDCLASS(LoopbackMultiplayerPeer, NetworkedMultiplayerPeer);
+
+	friend class LoopbackNetwork;
+
+public:
+	struct Stats {
+		uint64_t packets_sent = 0;
+		uint64_t bytes_sent = 0;
+		uint64_t packets_received = 0;
+		uint64_t bytes_received = 0;
+		uint64_t packets_lost = 0; // Sent by this peer and never delivered.
+	};
+
+private:
+	struct Packet {
+		int from = 0;
+		Vector<uint8_t> data;
+	};
+
+	Ref<LoopbackNetwork> network;
+	int unique_id = 0;
+	bool server = false;
+	bool refuse_connections = false;
+	ConnectionStatus status = CONNECTION_DISCONNECTED;
+	TransferMode transfer_mode = TRANSFER_MODE_RELIABLE;
+	int target_peer = 0;
+	Set<int> connected;
+	List<LoopbackNetwork::Message> incoming;
+	List<Packet> packets;
+	Packet current_packet;
+	Stats stats;
+
+	void _send(LoopbackNetwork::Message::Type p_type, int p_to, const uint8_t *p_data = nullptr, int p_size = 0);
+
+public:
+	virtual void set_transfer_mode(TransferMode p_mode) { transfer_mode = p_mode; }
+	virtual TransferMode get_transfer_mode() const { return transfer_mode; }
+	virtual void set_target_peer(int p_peer_id) { target_peer = p_peer_id; }
+	virtual int get_packet_peer() const;
+	virtual bool is_server() const { return server; }
+	virtual void poll();
+	virtual int get_unique_id() const { return unique_id; }
+	virtual void set_refuse_new_connections(bool p_enable) { refuse_connections = p_enable; }
+	virtual bool is_refusing_new_connections() const { return refuse_connections; }
+	virtual ConnectionStatus get_connection_status() const { return status; }
+
+	virtual int get_available_packet_count() const { return packets.size(); }
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size);
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size);
+	virtual int get_max_packet_size() const { return 1 << 24; }
+
+	void close_connection();
+	int get_connected_count() const { return connected.size(); }
+	const Stats &get_stats() const { return stats; }
+
+	~LoopbackMultiplayerPeer();
+};
+
+int LoopbackNetwork::get_in_flight_count() const {
+	int count = 0;
+	for (const Map<uint64_t, List<Message>>::Element *E = in_flight.front(); E; E = E->next()) {
+		count += E->get().size();
+	}
+	return count;
+}
+
+void LoopbackNetwork::_send(const Message &p_message) {
+	const uint64_t link_key = (uint64_t(uint32_t(p_message.from)) << 32) | uint32_t(p_message.to);
+	Link *link = links.getptr(link_key);
+	if (!link) {
+		links.set(link_key, Link());
+		link = links.getptr(link_key);
+	}
+
+	// Serialization on a capped link queues packets behind each other.
+	uint64_t depart = time_usec;
+	if (bandwidth > 0) {
+		depart = MAX(depart, link->tx_free_usec) + uint64_t(p_message.data.size()) * 1000000 / bandwidth;
+		link->tx_free_usec = depart;
+	}
+
+	uint64_t deliver = depart + uint64_t(latency_msec) * 1000;
+	if (jitter_msec > 0) {
+		deliver += rng.rand() % (uint32_t(jitter_msec) * 1000 + 1);
+	}
+
+	if (loss > 0) {
+		if (p_message.type == Message::DATA && p_message.mode != NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE) {
+			if (rng.randf() < loss) {
+				LoopbackMultiplayerPeer **sender = peers.getptr(p_message.from);
+				if (sender) {
+					(*sender)->stats.packets_lost++;
+				}
+				return;
+			}
+		} else {
+			// Each loss costs a round trip before the retransmission.
+			while (rng.randf() < loss) {
+				deliver += uint64_t(MAX(latency_msec, 1)) * 2000;
+			}
+		}
+	}
+
+	if (p_message.mode != NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE || p_message.type != Message::DATA) {
+		// Ordered modes, and connection events, can't overtake earlier ones on the same link.
+		uint64_t &ordered = link->ordered_usec[p_message.type == Message::DATA ? p_message.mode : NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE];
+		deliver = MAX(deliver, ordered);
+		ordered = deliver;
+	}
+
+	Map<uint64_t, List<Message>>::Element *E = in_flight.find(deliver);
+	if (!E) {
+		E = in_flight.insert(deliver, List<Message>());
+	}
+	E->get().push_back(p_message);
+}
+
+void LoopbackNetwork::_deliver(const Message &p_message) {
+	LoopbackMultiplayerPeer **peer = peers.getptr(p_message.to);
+	if (!peer || (*peer)->status == NetworkedMultiplayerPeer::CONNECTION_DISCONNECTED) {
+		return;
+	}
+	(*peer)->incoming.push_back(p_message);
+}
+
+void LoopbackNetwork::advance(uint64_t p_usec) {
+	time_usec += p_usec;
+	while (in_flight.front() && in_flight.front()->key() <= time_usec) {
+		const List<Message> &list = in_flight.front()->get();
+		for (const List<Message>::Element *E = list.front(); E; E = E->next()) {
+			_deliver(E->get());
+		}
+		in_flight.erase(in_flight.front());
+	}
+}
+
+Ref<LoopbackMultiplayerPeer> LoopbackNetwork::create_server() {
+	ERR_FAIL_COND_V_MSG(peers.has(NetworkedMultiplayerPeer::TARGET_PEER_SERVER), Ref<LoopbackMultiplayerPeer>(), "The loopback network already has a server.");
+
+	Ref<LoopbackMultiplayerPeer> peer = memnew(LoopbackMultiplayerPeer);
+	peer->network = Ref<LoopbackNetwork>(this);
+	peer->unique_id = NetworkedMultiplayerPeer::TARGET_PEER_SERVER;
+	peer->server = true;
+	peer->status = NetworkedMultiplayerPeer::CONNECTION_CONNECTED;
+	peers.set(peer->unique_id, peer.ptr());
+	return peer;
+}
+
+Ref<LoopbackMultiplayerPeer> LoopbackNetwork::create_client() {
+	Ref<LoopbackMultiplayerPeer> peer = memnew(LoopbackMultiplayerPeer);
+	peer->network = Ref<LoopbackNetwork>(this);
+	peer->unique_id = ++last_id;
+	peer->status = NetworkedMultiplayerPeer::CONNECTION_CONNECTING;
+	peers.set(peer->unique_id, peer.ptr());
+	peer->_send(Message::CONNECT, NetworkedMultiplayerPeer::TARGET_PEER_SERVER);
+	return peer;
+}
+
+void LoopbackMultiplayerPeer::_send(LoopbackNetwork::Message::Type p_type, int p_to, const uint8_t *p_data, int p_size) {
+	LoopbackNetwork::Message msg;
+	msg.type = p_type;
+	msg.from = unique_id;
+	msg.to = p_to;
+	msg.mode = transfer_mode;
+	if (p_size > 0) {
+		msg.data.resize(p_size);
+		copymem(msg.data.ptrw(), p_data, p_size);
+	}
+	network->_send(msg);
+}
+
+int LoopbackMultiplayerPeer::get_packet_peer() const {
+	ERR_FAIL_COND_V(packets.empty(), 0);
+	return packets.front()->get().from;
+}
+
+Error LoopbackMultiplayerPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
+	ERR_FAIL_COND_V(packets.empty(), ERR_UNAVAILABLE);
+
+	current_packet = packets.front()->get();
+	packets.pop_front();
+	*r_buffer = current_packet.data.ptr();
+	r_buffer_size = current_packet.data.size();
+	return OK;
+}
+
+Error LoopbackMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
+	ERR_FAIL_COND_V(status != CONNECTION_CONNECTED, ERR_UNCONFIGURED);
+
+	if (!server) {
+		// Clients only talk to the server, like with server relay disabled.
+		ERR_FAIL_COND_V(target_peer > TARGET_PEER_SERVER, ERR_INVALID_PARAMETER);
+		if (target_peer == -TARGET_PEER_SERVER) {
+			return OK;
+		}
+		_send(LoopbackNetwork::Message::DATA, TARGET_PEER_SERVER, p_buffer, p_buffer_size);
+		stats.packets_sent++;
+		stats.bytes_sent += p_buffer_size;
+		return OK;
+	}
+
+	if (target_peer > 0) {
+		ERR_FAIL_COND_V_MSG(!connected.has(target_peer), ERR_INVALID_PARAMETER, "Invalid target peer: " + itos(target_peer));
+		_send(LoopbackNetwork::Message::DATA, target_peer, p_buffer, p_buffer_size);
+		stats.packets_sent++;
+		stats.bytes_sent += p_buffer_size;
+		return OK;
+	}
+
+	for (Set<int>::Element *E = connected.front(); E; E = E->next()) {
+		if (E->get() == -target_peer) {
+			continue;
+		}
+		_send(LoopbackNetwork::Message::DATA, E->get(), p_buffer, p_buffer_size);
+		stats.packets_sent++;
+		stats.bytes_sent += p_buffer_size;
+	}
+	return OK;
+}
+
+void LoopbackMultiplayerPeer::poll() {
+	while (!incoming.empty()) {
+		LoopbackNetwork::Message msg = incoming.front()->get();
+		incoming.pop_front();
+
+		switch (msg.type) {
+			case LoopbackNetwork::Message::CONNECT: {
+				if (server) {
+					if (refuse_connections) {
+						_send(LoopbackNetwork::Message::DISCONNECT, msg.from);
+						break;
+					}
+					connected.insert(msg.from);
+					_send(LoopbackNetwork::Message::CONNECT, msg.from);
+					emit_signal("peer_connected", msg.from);
+				} else if (status == CONNECTION_CONNECTING) {
+					status = CONNECTION_CONNECTED;
+					connected.insert(msg.from);
+					emit_signal("peer_connected", msg.from);
+					emit_signal("connection_succeeded");
+				}
+			} break;
+			case LoopbackNetwork::Message::DISCONNECT: {
+				if (server) {
+					if (connected.has(msg.from)) {
+						connected.erase(msg.from);
+						emit_signal("peer_disconnected", msg.from);
+					}
+				} else {
+					bool was_connected = status == CONNECTION_CONNECTED;
+					status = CONNECTION_DISCONNECTED;
+					connected.clear();
+					incoming.clear();
+					packets.clear();
+					emit_signal(was_connected ? "server_disconnected" : "connection_failed");
+					return;
+				}
+			} break;
+			case LoopbackNetwork::Message::DATA: {
+				if (!connected.has(msg.from)) {
+					break;
+				}
+				stats.packets_received++;
+				stats.bytes_received += msg.data.size();
+				Packet packet;
+				packet.from = msg.from;
+				packet.data = msg.data;
+				packets.push_back(packet);
+			} break;
+		}
+	}
+}
+
+void LoopbackMultiplayerPeer::close_connection() {
+	if (status == CONNECTION_DISCONNECTED) {
+		return;
+	}
+	if (server) {
+		for (Set<int>::Element *E = connected.front(); E; E = E->next()) {
+			_send(LoopbackNetwork::Message::DISCONNECT, E->get());
+		}
+	} else {
+		_send(LoopbackNetwork::Message::DISCONNECT, TARGET_PEER_SERVER);
+	}
+	status = CONNECTION_DISCONNECTED;
+	connected.clear();
+	incoming.clear();
+	packets.clear();
+}
+
+LoopbackMultiplayerPeer::~LoopbackMultiplayerPeer() {
+	if (network.is_valid()) {
+		close_connection();
+		network->peers.erase(unique_id);
+	}
+}
+
+static void _connect(Ref<LoopbackNetwork> p_network, Ref<LoopbackMultiplayerPeer> p_server, Ref<LoopbackMultiplayerPeer> p_client) {
+	// Needs a round trip, retransmissions included.
+	for (int i = 0; i < 100 && p_client->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTING; i++) {
+		p_network->advance(100000);
+		p_server->poll();
+		p_client->poll();
+	}
+}
+
+TEST_CASE("[MultiplayerLoopback] Clients connect after the simulated latency") {
+	Ref<LoopbackNetwork> network = memnew(LoopbackNetwork);
+	network->latency_msec = 100;
+
+	Ref<LoopbackMultiplayerPeer> server = network->create_server();
+	Vector<Ref<LoopbackMultiplayerPeer>> clients;
+	for (int i = 0; i < 3; i++) {
+		clients.push_back(network->create_client());
+	}
+
+	network->advance(50000);
+	server->poll();
+	CHECK_MESSAGE(server->get_connected_count() == 0, "Connection requests should still be in flight.");
+
+	network->advance(60000);
+	server->poll();
+	CHECK(server->get_connected_count() == 3);
+	CHECK(clients[0]->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTING);
+
+	network->advance(100000);
+	for (int i = 0; i < clients.size(); i++) {
+		clients.write[i]->poll();
+		CHECK(clients[i]->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED);
+	}
+
+	clients.write[1]->close_connection();
+	network->advance(100000);
+	server->poll();
+	CHECK(server->get_connected_count() == 2);
+}
+
+TEST_CASE("[MultiplayerLoopback] Reliable packets are never lost and keep their order") {
+	Ref<LoopbackNetwork> network = memnew(LoopbackNetwork(42));
+	network->latency_msec = 20;
+	network->jitter_msec = 20;
+	network->loss = 0.5;
+
+	Ref<LoopbackMultiplayerPeer> server = network->create_server();
+	Ref<LoopbackMultiplayerPeer> client = network->create_client();
+	_connect(network, server, client);
+	REQUIRE(client->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED);
+
+	client->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_RELIABLE);
+	for (uint8_t i = 0; i < 100; i++) {
+		client->put_packet(&i, 1);
+	}
+	network->advance(100000000);
+	server->poll();
+
+	REQUIRE(server->get_available_packet_count() == 100);
+	bool in_order = true;
+	for (int i = 0; i < 100; i++) {
+		const uint8_t *buf;
+		int size;
+		server->get_packet(&buf, size);
+		in_order = in_order && size == 1 && buf[0] == i;
+	}
+	CHECK_MESSAGE(in_order, "Reliable packets should arrive in the order they were sent.");
+	CHECK(client->get_stats().packets_lost == 0);
+}
+
+TEST_CASE("[MultiplayerLoopback] Unreliable packets are lost at the configured rate") {
+	Ref<LoopbackNetwork> network = memnew(LoopbackNetwork(7));
+	network->loss = 0.25;
+
+	Ref<LoopbackMultiplayerPeer> server = network->create_server();
+	Ref<LoopbackMultiplayerPeer> client = network->create_client();
+	_connect(network, server, client);
+	REQUIRE(client->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED);
+
+	server->set_transfer_mode(NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE);
+	const uint8_t byte = 0;
+	for (int i = 0; i < 1000; i++) {
+		server->put_packet(&byte, 1);
+	}
+	network->advance(1000);
+	client->poll();
+
+	const int received = client->get_available_packet_count();
+	CHECK(received > 650);
+	CHECK(received < 850);
+	CHECK(server->get_stats().packets_lost == uint64_t(1000 - received));
+}
+
+TEST_CASE("[MultiplayerLoopback] Bandwidth caps delay delivery") {
+	Ref<LoopbackNetwork> network = memnew(LoopbackNetwork);
+	network->bandwidth = 1000;
+
+	Ref<LoopbackMultiplayerPeer> server = network->create_server();
+	Ref<LoopbackMultiplayerPeer> client = network->create_client();
+	_connect(network, server, client);
+	REQUIRE(client->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED);
+
+	uint8_t buf[100] = {};
+	for (int i = 0; i < 10; i++) {
+		server->put_packet(buf, sizeof(buf));
+	}
+	network->advance(500000);
+	client->poll();
+	CHECK_MESSAGE(client->get_available_packet_count() == 5, "1000 bytes per second should only let half of the packets through in half a second.");
+
+	network->advance(500000);
+	client->poll();
+	CHECK(client->get_available_packet_count() == 10);
+}
+
+TEST_CASE("[MultiplayerLoopback] MultiplayerAPI exchanges messages over the loopback") {
+	Ref<LoopbackNetwork> network = memnew(LoopbackNetwork);
+	network->latency_msec = 10;
+
+	Node *server_root = memnew(Node);
+	Node *client_root = memnew(Node);
+	Ref<MultiplayerAPI> server_api = memnew(MultiplayerAPI);
+	Ref<MultiplayerAPI> client_api = memnew(MultiplayerAPI);
+	server_api->set_root_node(server_root);
+	client_api->set_root_node(client_root);
+	server_api->set_network_peer(network->create_server());
+	client_api->set_network_peer(network->create_client());
+
+	for (int i = 0; i < 3; i++) {
+		network->advance(10000);
+		server_api->poll();
+		client_api->poll();
+	}
+	REQUIRE(client_api->get_network_connected_peers().size() == 1);
+	CHECK(server_api->get_network_connected_peers().size() == 1);
+
+	Vector<uint8_t> payload;
+	payload.push_back(1);
+	payload.push_back(2);
+	CHECK(server_api->send_bytes(payload) == OK);
+	server_api->poll();
+	network->advance(10000);
+	client_api->poll();
+
+	Ref<LoopbackMultiplayerPeer> client_peer = client_api->get_network_peer();
+	CHECK(client_peer->get_stats().packets_received == 1);
+	CHECK(client_peer->get_stats().bytes_received == uint64_t(payload.size() + 1));
+
+	server_api->set_network_peer(Ref<NetworkedMultiplayerPeer>());
+	client_api->set_network_peer(Ref<NetworkedMultiplayerPeer>());
+	memdelete(server_root);
+	memdelete(client_root);
+}
+
+// Exposes the path caches, so sending paths can be checked without a SceneTree.
+class PathCacheMultiplayerAPI : public MultiplayerAPI {
+public:
+	int cache_path(const NodePath &p_path) { return _get_path_send_cache(p_path)->id; }
+	String get_sent_path(int p_id) const { return String::utf8(path_send_cache_by_id[p_id - 1]->path_utf8.get_data()); }
+	uint32_t get_epoch() const { return path_send_cache_epoch; }
+
+	// Only takes the fast path, nodes outside of the tree have no path to cache.
+	int get_node_path_id(Node *p_node) { return _get_path_send_cache(p_node)->id; }
+	bool confirm_path(Node *p_node, int p_id, int p_target) { return _send_confirm_path(p_node, path_send_cache_by_id[p_id - 1], p_target); }
+
+	NodePath get_received_path(int p_from, int p_id) const {
+		const Map<int, PathGetCache>::Element *E = path_get_cache.find(p_from);
+		if (!E || !E->get().nodes.has(p_id)) {
+			return NodePath();
+		}
+		return E->get().nodes[p_id].path;
+	}
+};
+
+TEST_CASE("[MultiplayerLoopback] Node paths are cached and sent once per peer") {
+	Ref<LoopbackNetwork> network = memnew(LoopbackNetwork);
+	network->latency_msec = 10;
+
+	const String name = String::utf8("Jugador_ñ");
+	Node *server_root = memnew(Node);
+	Node *client_root = memnew(Node);
+	Node *server_node = memnew(Node);
+	Node *client_node = memnew(Node);
+	server_node->set_name(name);
+	client_node->set_name(name);
+	server_root->add_child(server_node);
+	client_root->add_child(client_node);
+
+	Ref<PathCacheMultiplayerAPI> server_api = memnew(PathCacheMultiplayerAPI);
+	Ref<PathCacheMultiplayerAPI> client_api = memnew(PathCacheMultiplayerAPI);
+	server_api->set_root_node(server_root);
+	client_api->set_root_node(client_root);
+	server_api->set_network_peer(network->create_server());
+	client_api->set_network_peer(network->create_client());
+	for (int i = 0; i < 3; i++) {
+		network->advance(10000);
+		server_api->poll();
+		client_api->poll();
+	}
+	REQUIRE(client_api->get_network_connected_peers().size() == 1);
+	const int client_id = client_api->get_network_unique_id();
+
+	// Each path gets its own ID, with the UTF-8 encoding kept for sending.
+	const int id = server_api->cache_path(NodePath(name));
+	CHECK(id > 0);
+	CHECK(server_api->cache_path(NodePath(name)) == id);
+	CHECK(server_api->cache_path(NodePath("Other")) == id + 1);
+	CHECK(server_api->get_sent_path(id) == name);
+
+	// Nodes remembering their ID don't need their path again.
+	server_node->set_network_path_id(server_api->get_instance_id(), server_api->get_epoch(), id);
+	CHECK(server_api->get_node_path_id(server_node) == id);
+
+	// The path goes out once, and is only used by ID after the peer confirmed it.
+	CHECK_FALSE(server_api->confirm_path(server_node, id, client_id));
+	for (int i = 0; i < 3; i++) {
+		network->advance(10000);
+		client_api->poll();
+		server_api->poll();
+	}
+	CHECK(client_api->get_received_path(1, id) == NodePath(name));
+	Ref<LoopbackMultiplayerPeer> server_peer = server_api->get_network_peer();
+	const uint64_t sent = server_peer->get_stats().packets_sent;
+	CHECK(server_api->confirm_path(server_node, id, client_id));
+	CHECK(server_peer->get_stats().packets_sent == sent);
+
+	// Remembered IDs are dropped when the path or the root changes.
+	server_node->notification(Node::NOTIFICATION_PATH_CHANGED);
+	CHECK(server_node->get_network_path_id(server_api->get_instance_id(), server_api->get_epoch()) == 0);
+	server_node->set_network_path_id(server_api->get_instance_id(), server_api->get_epoch(), id);
+	server_api->set_root_node(server_root);
+	CHECK(server_node->get_network_path_id(server_api->get_instance_id(), server_api->get_epoch()) == 0);
+
+	server_api->set_network_peer(Ref<NetworkedMultiplayerPeer>());
+	client_api->set_network_peer(Ref<NetworkedMultiplayerPeer>());
+	memdelete(server_root);
+	memdelete(client_root);
+}
+
+// Counts the raw messages a MultiplayerAPI hands to the game.
+class BenchmarkReceiver : public Object {
+	GDCLASS(BenchmarkReceiver, Object);
+
+public:
+	uint64_t messages = 0;
+
+	void _on_packet(int p_from, const Vector<uint8_t> &p_data) {
+		messages++;
+	}
+};
+
+static int _get_arg(List<String> &p_args, const String &p_name, int p_default) {
+	const List<String>::Element *E = p_args.find(p_name);
+	if (E && E->next()) {
+		return E->next()->get().to_int();
+	}
+	return p_default;
+}
+
+// Simulates a server ticking with many clients: every tick the server sends a state update
+// to each client and each client sends its input to the server, all through MultiplayerAPI.
+// Run with `godot --test multiplayer-benchmark`, network conditions can be set with
+// --clients, --ticks, --tick-rate, --payload, --latency, --jitter (msec), --loss (percent),
+// --bandwidth (bytes per second per link) and --batching (0 or 1).
+void benchmark_multiplayer() {
+	List<String> args = OS::get_singleton()->get_cmdline_args();
+	const int client_count = _get_arg(args, "--clients", 1000);
+	const int ticks = _get_arg(args, "--ticks", 600);
+	const int tick_rate = MAX(_get_arg(args, "--tick-rate", 60), 1);
+	const int payload_size = MAX(_get_arg(args, "--payload", 64), 1);
+
+	Ref<LoopbackNetwork> network = memnew(LoopbackNetwork);
+	network->latency_msec = _get_arg(args, "--latency", 50);
+	network->jitter_msec = _get_arg(args, "--jitter", 10);
+	network->loss = _get_arg(args, "--loss", 1) / 100.0;
+	network->bandwidth = _get_arg(args, "--bandwidth", 0);
+	const bool batching = _get_arg(args, "--batching", 0) != 0;
+
+	BenchmarkReceiver *server_receiver = memnew(BenchmarkReceiver);
+	BenchmarkReceiver *client_receiver = memnew(BenchmarkReceiver);
+
+	Node *server_root = memnew(Node);
+	Ref<MultiplayerAPI> server_api = memnew(MultiplayerAPI);
+	server_api->set_root_node(server_root);
+	server_api->set_packet_batching_enabled(batching);
+	server_api->set_network_peer(network->create_server());
+	server_api->connect("network_peer_packet", callable_mp(server_receiver, &BenchmarkReceiver::_on_packet));
+
+	Node *client_root = memnew(Node);
+	Vector<Ref<MultiplayerAPI>> client_apis;
+	Vector<Ref<LoopbackMultiplayerPeer>> client_peers;
+	client_apis.resize(client_count);
+	client_peers.resize(client_count);
+	for (int i = 0; i < client_count; i++) {
+		Ref<MultiplayerAPI> api = memnew(MultiplayerAPI);
+		api->set_root_node(client_root);
+		api->set_packet_batching_enabled(batching);
+		client_peers.write[i] = network->create_client();
+		api->set_network_peer(client_peers[i]);
+		api->connect("network_peer_packet", callable_mp(client_receiver, &BenchmarkReceiver::_on_packet));
+		client_apis.write[i] = api;
+	}
+
+	Vector<uint8_t> payload;
+	payload.resize(payload_size);
+	for (int i = 0; i < payload_size; i++) {
+		payload.write[i] = i & 0xFF;
+	}
+
+	const uint64_t tick_usec = 1000000 / tick_rate;
+	Vector<uint64_t> tick_times;
+	tick_times.resize(ticks);
+	uint64_t client_usec = 0;
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	for (int t = 0; t < ticks; t++) {
+		network->advance(tick_usec);
+
+		uint64_t client_begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < client_count; i++) {
+			MultiplayerAPI *api = client_apis.write[i].ptr();
+			api->poll();
+			if (client_peers[i]->get_connection_status() == NetworkedMultiplayerPeer::CONNECTION_CONNECTED) {
+				api->send_bytes(payload, NetworkedMultiplayerPeer::TARGET_PEER_SERVER, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE_ORDERED);
+			}
+		}
+		client_usec += OS::get_singleton()->get_ticks_usec() - client_begin;
+
+		uint64_t tick_begin = OS::get_singleton()->get_ticks_usec();
+		server_api->poll();
+		server_api->send_bytes(payload, NetworkedMultiplayerPeer::TARGET_PEER_BROADCAST, NetworkedMultiplayerPeer::TRANSFER_MODE_UNRELIABLE);
+		tick_times.write[t] = OS::get_singleton()->get_ticks_usec() - tick_begin;
+	}
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	uint64_t tick_total = 0;
+	for (int t = 0; t < ticks; t++) {
+		tick_total += tick_times[t];
+	}
+	tick_times.sort();
+	const uint64_t tick_p99 = ticks > 0 ? tick_times[MIN(ticks - 1, ticks * 99 / 100)] : 0;
+	const uint64_t tick_max = ticks > 0 ? tick_times[ticks - 1] : 0;
+
+	Ref<LoopbackMultiplayerPeer> server_peer = server_api->get_network_peer();
+	const LoopbackMultiplayerPeer::Stats &server_stats = server_peer->get_stats();
+	LoopbackMultiplayerPeer::Stats client_stats;
+	for (int i = 0; i < client_count; i++) {
+		const LoopbackMultiplayerPeer::Stats &s = client_peers[i]->get_stats();
+		client_stats.packets_sent += s.packets_sent;
+		client_stats.bytes_sent += s.bytes_sent;
+		client_stats.packets_received += s.packets_received;
+		client_stats.bytes_received += s.bytes_received;
+		client_stats.packets_lost += s.packets_lost;
+	}
+
+	const double seconds = ticks / double(tick_rate);
+	const int clients = MAX(client_count, 1);
+	OS *os = OS::get_singleton();
+	os->print("Simulated %d clients for %d ticks at %d Hz (%d msec latency, %d msec jitter, %.1f%% loss, %s bandwidth, batching %s).\n",
+			client_count, ticks, tick_rate, network->latency_msec, network->jitter_msec, network->loss * 100.0,
+			network->bandwidth > 0 ? (itos(network->bandwidth) + " B/s").utf8().get_data() : "unlimited", batching ? "on" : "off");
+	os->print("Server tick: %.3f msec average, %.3f msec p99, %.3f msec max (budget %.3f msec).\n",
+			tick_total / 1000.0 / MAX(ticks, 1), tick_p99 / 1000.0, tick_max / 1000.0, tick_usec / 1000.0);
+	os->print("Server: sent %d packets (%d KiB), received %d packets (%d KiB), %d connected.\n",
+			int(server_stats.packets_sent), int(server_stats.bytes_sent / 1024), int(server_stats.packets_received), int(server_stats.bytes_received / 1024), server_peer->get_connected_count());
+	os->print("Per client per second: sent %.1f packets (%.1f B), received %.1f packets (%.1f B), lost %.1f packets.\n",
+			client_stats.packets_sent / seconds / clients, client_stats.bytes_sent / seconds / clients,
+			client_stats.packets_received / seconds / clients, client_stats.bytes_received / seconds / clients,
+			(server_stats.packets_lost / double(clients) + client_stats.packets_lost / double(clients)) / seconds);
+	os->print("Messages delivered: %d to the server, %d to clients, %.0f per second of wall time (%.2f sec total, %.2f sec in clients).\n",
+			int(server_receiver->messages), int(client_receiver->messages), (server_receiver->messages + client_receiver->messages) / (elapsed / 1000000.0),
+			elapsed / 1000000.0, client_usec / 1000000.0);
+
+	server_api->set_network_peer(Ref<NetworkedMultiplayerPeer>());
+	for (int i = 0; i < client_count; i++) {
+		client_apis.write[i]->set_network_peer(Ref<NetworkedMultiplayerPeer>());
+	}
+	client_apis.clear();
+	client_peers.clear();
+	server_api.unref();
+	memdelete(server_root);
+	memdelete(client_root);
+	memdelete(server_receiver);
+	memdelete(client_receiver);
+}
+
+REGISTER_TEST_COMMAND("multiplayer-benchmark", &benchmark_multiplayer);
+
+} // namespace TestMultiplayerLoopback
+
+#endif // TEST_MULTIPLAYER_LOOPBACK_H
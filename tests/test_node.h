@@ -0,0 +1,281 @@
+/*************************************************************************/
+/*  test_node.h                                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NODE_H
+#define TEST_NODE_H
+
+#include "scene/main/node.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestNode {
+
+// Enough children to go past the threshold at which Node indexes children by name.
+static const int MANY_CHILDREN = 200;
+
+static Node *_make_parent(int p_children) {
+	Node *parent = memnew(Node);
+	for (int i = 0; i < p_children; i++) {
+		Node *child = memnew(Node);
+		child->set_name("Child" + itos(i));
+		parent->add_child(child);
+	}
+	return parent;
+}
+
+TEST_CASE("[Node] Lookup by name with many children") {
+	Node *parent = _make_parent(MANY_CHILDREN);
+
+	CHECK(parent->get_node_or_null(NodePath("Child0")) == parent->get_child(0));
+	CHECK(parent->get_node_or_null(NodePath("Child150")) == parent->get_child(150));
+	CHECK(parent->get_node_or_null(NodePath("Missing")) == nullptr);
+
+	Node *child = parent->get_child(10);
+	child->set_name("Renamed");
+	CHECK(parent->get_node_or_null(NodePath("Renamed")) == child);
+	CHECK(parent->get_node_or_null(NodePath("Child10")) == nullptr);
+
+	// Renaming to a sibling's name must still produce a unique name.
+	child->set_name("Child20");
+	CHECK(String(child->get_name()) != "Child20");
+	CHECK(parent->get_node_or_null(NodePath("Child20")) == parent->get_child(20));
+	CHECK(parent->get_node_or_null(NodePath(child->get_name())) == child);
+
+	Node *removed = parent->get_child(30);
+	parent->remove_child(removed);
+	CHECK(parent->get_node_or_null(NodePath("Child30")) == nullptr);
+
+	// A new child with a taken name is renamed on add.
+	Node *duplicate = memnew(Node);
+	duplicate->set_name("Child40");
+	parent->add_child(duplicate);
+	CHECK(String(duplicate->get_name()) != "Child40");
+	CHECK(parent->get_node_or_null(NodePath("Child40")) == parent->get_child(39));
+
+	memdelete(removed);
+	memdelete(parent);
+}
+
+TEST_CASE("[Node] Child indices stay consistent after removals") {
+	Node *parent = _make_parent(MANY_CHILDREN);
+
+	Vector<Node *> removed;
+	for (int i = 0; i < 50; i++) {
+		Node *child = parent->get_child(0);
+		parent->remove_child(child);
+		removed.push_back(child);
+	}
+
+	CHECK(parent->get_child_count() == MANY_CHILDREN - 50);
+	CHECK(String(parent->get_child(0)->get_name()) == "Child50");
+	for (int i = 0; i < parent->get_child_count(); i++) {
+		CHECK(parent->get_child(i)->get_index() == i);
+	}
+
+	Node *first = parent->get_child(0);
+	parent->remove_child(first);
+	removed.push_back(first);
+	Node *added = memnew(Node);
+	parent->add_child(added);
+	CHECK(added->get_index() == parent->get_child_count() - 1);
+	CHECK(parent->get_child(0)->get_index() == 0);
+
+	parent->move_child(added, 0);
+	CHECK(added->get_index() == 0);
+	CHECK(parent->get_child(1)->get_index() == 1);
+
+	for (int i = 0; i < removed.size(); i++) {
+		CHECK(removed[i]->get_index() == -1);
+		memdelete(removed[i]);
+	}
+	memdelete(parent);
+}
+
+// Counts the index changes it is notified about.
+class MoveCounter : public Node {
+	GDCLASS(MoveCounter, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_MOVED_IN_PARENT) {
+			moves++;
+		}
+	}
+
+public:
+	int moves = 0;
+};
+
+TEST_CASE("[Node] Moving children only notifies the siblings that moved") {
+	Node *parent = memnew(Node);
+	Vector<MoveCounter *> children;
+	for (int i = 0; i < 10; i++) {
+		MoveCounter *child = memnew(MoveCounter);
+		parent->add_child(child);
+		children.push_back(child);
+	}
+
+	// The moved child knows its index right away, the others once asked.
+	parent->move_child(children[2], 6);
+	CHECK(children[2]->moves == 1);
+	CHECK(children[2]->get_index() == 6);
+	for (int i = 3; i <= 6; i++) {
+		CHECK(children[i]->moves == 0);
+	}
+
+	CHECK(children[4]->get_index() == 3);
+	for (int i = 0; i < 10; i++) {
+		int expected = (i >= 2 && i <= 6) ? 1 : 0;
+		CHECK(children[i]->moves == expected);
+		CHECK(parent->get_child(children[i]->get_index()) == children[i]);
+	}
+
+	// Moving back and forth before anything asks leaves the siblings alone.
+	parent->move_child(children[2], 0);
+	parent->move_child(children[2], 6);
+	CHECK(children[2]->moves == 3);
+	for (int i = 0; i < 10; i++) {
+		CHECK(parent->get_child(children[i]->get_index()) == children[i]);
+	}
+	CHECK(children[0]->moves == 0);
+	CHECK(children[4]->moves == 1);
+
+	memdelete(parent);
+}
+
+TEST_CASE("[Node] Adding children doesn't renumber the stale siblings") {
+	Node *parent = memnew(Node);
+	for (int i = 0; i < 10; i++) {
+		parent->add_child(memnew(MoveCounter));
+	}
+
+	// Churn: remove from the front, add to the back.
+	for (int i = 0; i < 5; i++) {
+		Node *first = parent->get_child(0);
+		parent->remove_child(first);
+		memdelete(first);
+		parent->add_child(memnew(MoveCounter));
+	}
+
+	for (int i = 0; i < parent->get_child_count(); i++) {
+		CHECK(Object::cast_to<MoveCounter>(parent->get_child(i))->moves == 0);
+	}
+
+	for (int i = 0; i < parent->get_child_count(); i++) {
+		CHECK(parent->get_child(i)->get_index() == i);
+	}
+	// Notified once each, however many times they shifted. Only the child added last kept its index.
+	for (int i = 0; i < parent->get_child_count(); i++) {
+		CHECK(Object::cast_to<MoveCounter>(parent->get_child(i))->moves == (i < 9 ? 1 : 0));
+	}
+
+	memdelete(parent);
+}
+
+static String _add_legible_child(Node *p_parent, const String &p_name) {
+	Node *child = memnew(Node);
+	child->set_name(p_name);
+	p_parent->add_child(child, true);
+	return child->get_name();
+}
+
+TEST_CASE("[Node] Serial child names continue after the last one handed out") {
+	Node *parent = memnew(Node);
+
+	CHECK(_add_legible_child(parent, "Enemy") == "Enemy");
+	String names[5];
+	for (int i = 0; i < 5; i++) {
+		names[i] = _add_legible_child(parent, "Enemy");
+		CHECK(names[i].begins_with("Enemy"));
+		CHECK(names[i].ends_with(itos(i + 2)));
+	}
+
+	// A freed number is not handed out again while the parent has children.
+	Node *second = parent->get_node(NodePath(names[0]));
+	parent->remove_child(second);
+	memdelete(second);
+	CHECK(_add_legible_child(parent, "Enemy").ends_with("7"));
+
+	// Decorated names continue from their own number when it is higher.
+	CHECK(_add_legible_child(parent, names[4]).ends_with("8"));
+
+	while (parent->get_child_count()) {
+		Node *child = parent->get_child(0);
+		parent->remove_child(child);
+		memdelete(child);
+	}
+	CHECK(_add_legible_child(parent, "Enemy") == "Enemy");
+	CHECK(_add_legible_child(parent, "Enemy").ends_with("2"));
+
+	memdelete(parent);
+}
+
+TEST_CASE("[Node] Nested path lookups follow renames, removals and moves") {
+	Node *root = memnew(Node);
+	Node *a = memnew(Node);
+	a->set_name("A");
+	root->add_child(a);
+	Node *b = memnew(Node);
+	b->set_name("B");
+	a->add_child(b);
+
+	uint64_t hits = Node::node_path_cache_hits;
+	uint64_t misses = Node::node_path_cache_misses;
+
+	CHECK(root->get_node_or_null(NodePath("A/B")) == b);
+	CHECK(root->get_node_or_null(NodePath("A/B")) == b);
+	CHECK(root->get_node_or_null(NodePath("A/C")) == nullptr);
+	CHECK(b->get_node_or_null(NodePath("../..")) == root);
+
+	b->set_name("C");
+	CHECK(root->get_node_or_null(NodePath("A/B")) == nullptr);
+	CHECK(root->get_node_or_null(NodePath("A/C")) == b);
+
+	// Moving the subtree changes every path through it.
+	a->remove_child(b);
+	root->add_child(b);
+	CHECK(root->get_node_or_null(NodePath("A/C")) == nullptr);
+	CHECK(root->get_node_or_null(NodePath("C")) == b);
+	CHECK(b->get_node_or_null(NodePath("../A")) == a);
+
+	root->remove_child(b);
+	memdelete(b);
+	CHECK(root->get_node_or_null(NodePath("C")) == nullptr);
+
+	// Outside the scene tree lookups are never cached.
+	CHECK(Node::node_path_cache_hits == hits);
+	CHECK(Node::node_path_cache_misses == misses);
+
+	memdelete(root);
+}
+
+} // namespace TestNode
+
+#endif // TEST_NODE_H
@@ -0,0 +1,152 @@
+/*************************************************************************/
+/*  test_node_path_cache.h                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NODE_PATH_CACHE_H
+#define TEST_NODE_PATH_CACHE_H
+
+#include "scene/main/node.h"
+#include "scene/main/node_path_cache.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestNodePathCache {
+
+static Node *_add_named(Node *p_parent, const String &p_name) {
+	Node *node = memnew(Node);
+	node->set_name(p_name);
+	if (p_parent) {
+		p_parent->add_child(node);
+	}
+	return node;
+}
+
+TEST_CASE("[NodePathCache] Hits and cached nulls") {
+	Node *root = _add_named(nullptr, "Root");
+	Node *a = _add_named(root, "A");
+	Node *b = _add_named(a, "B");
+
+	NodePathCache cache;
+	Node *found = nullptr;
+	CHECK(!cache.lookup(root, NodePath("A/B"), 1, found));
+
+	cache.store(NodePath("A/B"), b, 1);
+	CHECK(cache.lookup(root, NodePath("A/B"), 1, found));
+	CHECK(found == b);
+
+	cache.store(NodePath("A/C"), nullptr, 1);
+	found = b;
+	CHECK(cache.lookup(root, NodePath("A/C"), 1, found));
+	CHECK(found == nullptr);
+
+	// Once the tree changed, misses are resolved again, but entries still leading
+	// to their node are kept without being resolved.
+	CHECK(!cache.lookup(root, NodePath("A/C"), 2, found));
+	CHECK(cache.lookup(root, NodePath("A/B"), 2, found));
+	CHECK(found == b);
+	CHECK(cache.size() == 2);
+
+	memdelete(root);
+}
+
+TEST_CASE("[NodePathCache] Renamed, moved and freed nodes are not returned") {
+	Node *root = _add_named(nullptr, "Root");
+	Node *a = _add_named(root, "A");
+	Node *b = _add_named(a, "B");
+	Node *c = _add_named(a, "C");
+
+	NodePathCache cache;
+	Node *found = nullptr;
+	cache.store(NodePath("A/B"), b, 1);
+	cache.store(NodePath("A/C"), c, 1);
+	cache.store(NodePath("A"), a, 1);
+
+	b->set_name("Renamed");
+	CHECK(!cache.lookup(root, NodePath("A/B"), 2, found));
+
+	a->remove_child(c);
+	root->add_child(c);
+	CHECK(!cache.lookup(root, NodePath("A/C"), 2, found));
+	cache.store(NodePath("C"), c, 2);
+	CHECK(cache.lookup(root, NodePath("C"), 2, found));
+	CHECK(found == c);
+
+	// Not even at the version it was stored at, as the freed node's ID is gone.
+	root->remove_child(c);
+	memdelete(c);
+	CHECK(!cache.lookup(root, NodePath("C"), 2, found));
+
+	// Lookups from another node don't reach it the same way.
+	CHECK(!cache.lookup(b, NodePath("A"), 2, found));
+	CHECK(cache.lookup(root, NodePath("A"), 2, found));
+
+	memdelete(root);
+}
+
+TEST_CASE("[NodePathCache] Absolute and dotted paths") {
+	Node *root = _add_named(nullptr, "Root");
+	Node *a = _add_named(root, "A");
+	Node *b = _add_named(a, "B");
+	Node *other_root = _add_named(nullptr, "Root");
+	Node *other_a = _add_named(other_root, "A");
+
+	NodePathCache cache;
+	Node *found = nullptr;
+	cache.store(NodePath("/Root/A/B"), b, 1);
+	CHECK(cache.lookup(a, NodePath("/Root/A/B"), 2, found));
+	CHECK(found == b);
+	// Same names, but another tree.
+	CHECK(!cache.lookup(other_a, NodePath("/Root/A/B"), 2, found));
+
+	cache.store(NodePath("../A"), a, 1);
+	CHECK(cache.lookup(a, NodePath("../A"), 1, found));
+	CHECK(found == a);
+	// Not checked by walking up, resolved again after any change.
+	CHECK(!cache.lookup(a, NodePath("../A"), 2, found));
+
+	memdelete(root);
+	memdelete(other_root);
+}
+
+TEST_CASE("[NodePathCache] Starts over when full") {
+	NodePathCache cache;
+	for (int i = 0; i < NodePathCache::MAX_ENTRIES; i++) {
+		cache.store(NodePath("Missing" + itos(i)), nullptr, 1);
+	}
+	CHECK(cache.size() == NodePathCache::MAX_ENTRIES);
+	cache.store(NodePath("Missing0"), nullptr, 1);
+	CHECK(cache.size() == NodePathCache::MAX_ENTRIES);
+
+	cache.store(NodePath("Another"), nullptr, 1);
+	CHECK(cache.size() == 1);
+}
+
+} // namespace TestNodePathCache
+
+#endif // TEST_NODE_PATH_CACHE_H
@@ -0,0 +1,220 @@
+/*************************************************************************/
+/*  test_node_pool.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NODE_POOL_H
+#define TEST_NODE_POOL_H
+
+#include "core/message_queue.h"
+#include "scene/main/node_pool.h"
+#include "scene/resources/packed_scene.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestNodePool {
+
+// Full pools free what they get back with queue_free(), which goes through the
+// message queue when no SceneTree runs.
+class ScopedMessageQueue {
+	MessageQueue *owned = nullptr;
+
+public:
+	void flush() { MessageQueue::get_singleton()->flush(); }
+
+	ScopedMessageQueue() {
+		if (!MessageQueue::get_singleton()) {
+			owned = memnew(MessageQueue);
+		}
+	}
+	~ScopedMessageQueue() {
+		if (owned) {
+			owned->flush();
+			memdelete(owned);
+		}
+	}
+};
+
+static Ref<PackedScene> _make_scene() {
+	Node *root = memnew(Node);
+	root->set_name("Projectile");
+	Node *child = memnew(Node);
+	child->set_name("Trail");
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	scene->pack(root);
+	memdelete(root);
+	return scene;
+}
+
+TEST_CASE("[NodePool] Acquire and release") {
+	ScopedMessageQueue message_queue;
+	Ref<NodePool> pool;
+	pool.instance();
+	pool->set_scene(_make_scene());
+
+	pool->prewarm(2);
+	CHECK(pool->get_available_count() == 2);
+
+	Node *a = pool->acquire();
+	Node *b = pool->acquire();
+	Node *c = pool->acquire();
+	REQUIRE(a);
+	REQUIRE(b);
+	REQUIRE(c);
+	CHECK(c->get_node_or_null(NodePath("Trail")) != nullptr);
+	CHECK(pool->get_hit_count() == 2);
+	CHECK(pool->get_miss_count() == 1);
+	CHECK(pool->get_available_count() == 0);
+
+	Node *parent = memnew(Node);
+	parent->add_child(c);
+	pool->release(c);
+	CHECK(c->get_parent() == nullptr);
+	CHECK(pool->acquire() == c);
+	CHECK(pool->get_hit_count() == 3);
+
+	pool->set_max_size(1);
+	pool->release(a);
+	pool->release(b); // Freed, the pool is full.
+	pool->release(c); // Freed, the pool is full.
+	CHECK(pool->get_available_count() == 1);
+
+	pool->reset_stats();
+	CHECK(pool->get_hit_count() == 0);
+	CHECK(pool->get_miss_count() == 0);
+
+	memdelete(parent);
+}
+
+// Counts its uses, which the pool must clear before handing it out again.
+class PoolResetCounter : public Node {
+	GDCLASS(PoolResetCounter, Node);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("_pool_reset"), &PoolResetCounter::_pool_reset);
+	}
+
+public:
+	int uses = 0;
+	int resets = 0;
+
+	void _pool_reset() {
+		uses = 0;
+		resets++;
+	}
+};
+
+TEST_CASE("[NodePool] Reset hook runs before reuse") {
+	ScopedMessageQueue message_queue;
+	Ref<NodePool> pool;
+	pool.instance();
+	pool->set_scene(_make_scene());
+
+	// Pools take back any node, not only the ones instanced from their scene.
+	PoolResetCounter *node = memnew(PoolResetCounter);
+	node->uses = 3;
+
+	Node *parent = memnew(Node);
+	parent->add_child(node);
+	pool->release(node);
+	CHECK(node->resets == 1);
+	CHECK(node->uses == 0);
+
+	CHECK(pool->acquire() == node);
+	CHECK(node->uses == 0);
+	node->uses = 1;
+
+	// Once full, the pool frees what it gets back.
+	pool->set_max_size(1);
+	PoolResetCounter *other = memnew(PoolResetCounter);
+	pool->release(other);
+	CHECK(other->resets == 1);
+	ObjectID node_id = node->get_instance_id();
+	pool->release(node);
+	CHECK(node->resets == 2);
+	CHECK(pool->get_available_count() == 1);
+
+	// Freed once the message queue is flushed, as no SceneTree runs here.
+	CHECK(ObjectDB::get_instance(node_id) == node);
+	message_queue.flush();
+	CHECK(ObjectDB::get_instance(node_id) == nullptr);
+
+	memdelete(parent);
+}
+
+// Releases itself from one of its own methods, like a projectile that hit something.
+class PoolSelfReleaser : public Node {
+	GDCLASS(PoolSelfReleaser, Node);
+
+public:
+	Ref<NodePool> pool;
+	int hits = 0;
+
+	void hit() {
+		pool->release(this);
+		hits++; // Still running after the release.
+	}
+};
+
+TEST_CASE("[NodePool] Nodes can release themselves when the pool is full") {
+	ScopedMessageQueue message_queue;
+
+	Ref<NodePool> pool;
+	pool.instance();
+	pool->set_scene(_make_scene());
+	pool->set_max_size(1);
+	pool->prewarm(1);
+
+	Node *parent = memnew(Node);
+	PoolSelfReleaser *node = memnew(PoolSelfReleaser);
+	node->pool = pool;
+	parent->add_child(node);
+	ObjectID id = node->get_instance_id();
+
+	node->hit();
+	CHECK(ObjectDB::get_instance(id) == node);
+	CHECK(node->hits == 1);
+	CHECK(node->is_queued_for_deletion());
+	CHECK(node->get_parent() == nullptr);
+	CHECK(pool->get_available_count() == 1);
+
+	node->pool.unref();
+	message_queue.flush();
+	CHECK(ObjectDB::get_instance(id) == nullptr);
+
+	memdelete(parent);
+}
+
+} // namespace TestNodePool
+
+#endif // TEST_NODE_POOL_H
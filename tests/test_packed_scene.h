@@ -0,0 +1,105 @@
+/*************************************************************************/
+/*  test_packed_scene.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PACKED_SCENE_H
+#define TEST_PACKED_SCENE_H
+
+#include "scene/main/http_request.h"
+#include "scene/main/timer.h"
+#include "scene/resources/packed_scene.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestPackedScene {
+
+TEST_CASE("[PackedScene] Instanced properties match setting them through Object::set()") {
+	Node *root = memnew(Node);
+	root->set_name("Root");
+	root->set_process_priority(3);
+	root->set_pause_mode(Node::PAUSE_MODE_STOP);
+
+	Timer *timer = memnew(Timer);
+	timer->set_name("Timer");
+	timer->set_wait_time(2.5);
+	timer->set_one_shot(true);
+	timer->set_autostart(true);
+	timer->set_timer_process_mode(Timer::TIMER_PROCESS_PHYSICS);
+	root->add_child(timer);
+	timer->set_owner(root);
+
+	HTTPRequest *request = memnew(HTTPRequest);
+	request->set_name("Request");
+	request->set_use_threads(true);
+	request->set_max_redirects(3);
+	request->set_body_size_limit(1024);
+	request->set_download_file("user://packed_scene_test");
+	root->add_child(request);
+	request->set_owner(root);
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	REQUIRE(scene->pack(root) == OK);
+	memdelete(root);
+
+	Ref<SceneState> state = scene->get_state();
+	Node *instanced = scene->instance();
+	REQUIRE(instanced);
+
+	// Setters resolved once per scene must give the same result as the regular lookup.
+	for (int i = 0; i < state->get_node_count(); i++) {
+		Node *node = instanced->get_node_or_null(state->get_node_path(i));
+		REQUIRE(node);
+		Object *expected = ClassDB::instance(state->get_node_type(i));
+		REQUIRE(expected);
+		CHECK(node->get_class_name() == expected->get_class_name());
+
+		for (int j = 0; j < state->get_node_property_count(i); j++) {
+			expected->set(state->get_node_property_name(i, j), state->get_node_property_value(i, j));
+		}
+		for (int j = 0; j < state->get_node_property_count(i); j++) {
+			const StringName &name = state->get_node_property_name(i, j);
+			CHECK_MESSAGE(node->get(name) == expected->get(name), String(name));
+		}
+		memdelete(expected);
+	}
+
+	Timer *instanced_timer = Object::cast_to<Timer>(instanced->get_node_or_null(NodePath("Timer")));
+	REQUIRE(instanced_timer);
+	CHECK(instanced_timer->get_wait_time() == 2.5);
+	CHECK(instanced_timer->is_one_shot());
+	CHECK(instanced_timer->get_timer_process_mode() == Timer::TIMER_PROCESS_PHYSICS);
+	CHECK(instanced->get_process_priority() == 3);
+
+	memdelete(instanced);
+}
+
+} // namespace TestPackedScene
+
+#endif // TEST_PACKED_SCENE_H
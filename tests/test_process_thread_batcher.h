@@ -0,0 +1,145 @@
+/*************************************************************************/
+/*  test_process_thread_batcher.h                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PROCESS_THREAD_BATCHER_H
+#define TEST_PROCESS_THREAD_BATCHER_H
+
+#include "scene/main/node.h"
+#include "scene/main/process_thread_batcher.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestProcessThreadBatcher {
+
+struct BatchRecord {
+	HashMap<ObjectID, int> indices; // Filled before running, only read while batches run.
+	LocalVector<uint32_t> order;
+	LocalVector<Thread::ID> threads;
+	volatile uint32_t counter = 0;
+	ProcessThreadBatcher *batcher = nullptr;
+	volatile uint32_t outside_run = 0;
+
+	void track(Node *p_node) {
+		indices.set(p_node->get_instance_id(), order.size());
+		order.push_back(0);
+		threads.push_back(Thread::ID());
+	}
+};
+
+static void _record_node(Node *p_node, void *p_userdata) {
+	BatchRecord *record = (BatchRecord *)p_userdata;
+	int index = *record->indices.getptr(p_node->get_instance_id());
+	record->order[index] = atomic_increment(&record->counter);
+	record->threads[index] = Thread::get_caller_id();
+	if (!record->batcher->is_running()) {
+		atomic_increment(&record->outside_run);
+	}
+}
+
+TEST_CASE("[ProcessThreadBatcher] Every node is processed once, in order within its group") {
+	const int GROUPS = 4;
+	const int NODES_PER_GROUP = 50;
+
+	ProcessThreadBatcher batcher;
+	batcher.set_thread_count(3);
+	BatchRecord record;
+	record.batcher = &batcher;
+
+	Vector<Node *> nodes;
+	for (int i = 0; i < GROUPS * NODES_PER_GROUP; i++) {
+		Node *node = memnew(Node);
+		nodes.push_back(node);
+		record.track(node);
+		// Interleaved like the nodes of several groups in a process group.
+		batcher.add(1 + i % GROUPS, node);
+	}
+	CHECK(batcher.get_pending_batch_count() == GROUPS);
+	CHECK(batcher.get_pending_batch(0).size() == NODES_PER_GROUP);
+
+	batcher.run(_record_node, &record);
+
+	CHECK(!batcher.is_running());
+	CHECK(batcher.get_pending_batch_count() == 0);
+	CHECK(batcher.get_started_thread_count() == 3);
+	CHECK(record.counter == GROUPS * NODES_PER_GROUP);
+	CHECK(record.outside_run == 0);
+
+	for (int i = 0; i < nodes.size(); i++) {
+		CHECK(record.order[i] > 0);
+		if (i >= GROUPS) {
+			// Same group, added earlier.
+			CHECK(record.order[i] > record.order[i - GROUPS]);
+			CHECK(record.threads[i] == record.threads[i - GROUPS]);
+		}
+	}
+
+	for (int i = 0; i < nodes.size(); i++) {
+		memdelete(nodes[i]);
+	}
+}
+
+TEST_CASE("[ProcessThreadBatcher] Only nodes added since the last run are processed") {
+	ProcessThreadBatcher batcher;
+	batcher.set_thread_count(0);
+	BatchRecord record;
+	record.batcher = &batcher;
+
+	Node *first = memnew(Node);
+	Node *second = memnew(Node);
+	record.track(first);
+	record.track(second);
+
+	batcher.add(2, first);
+	batcher.add(5, second);
+	batcher.run(_record_node, &record);
+	CHECK(record.counter == 2);
+
+	// The calling thread takes batches too, so it works without workers.
+	CHECK(record.threads[0] == Thread::get_caller_id());
+	CHECK(batcher.get_started_thread_count() == 0);
+
+	batcher.add(5, second);
+	CHECK(batcher.get_pending_batch_count() == 1);
+	batcher.run(_record_node, &record);
+	CHECK(record.counter == 3);
+	CHECK(record.order[1] == 3);
+	CHECK(record.order[0] == 1);
+
+	// Running with nothing pending does nothing.
+	batcher.run(_record_node, &record);
+	CHECK(record.counter == 3);
+
+	memdelete(first);
+	memdelete(second);
+}
+
+} // namespace TestProcessThreadBatcher
+
+#endif // TEST_PROCESS_THREAD_BATCHER_H
@@ -0,0 +1,178 @@
+/*************************************************************************/
+/*  test_resource_soft_cache.h                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RESOURCE_SOFT_CACHE_H
+#define TEST_RESOURCE_SOFT_CACHE_H
+
+#include "core/resource.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestResourceSoftCache {
+
+static Ref<Resource> _retain(const String &p_path, uint64_t p_cost) {
+	Ref<Resource> res;
+	res.instance();
+	res->set_path(p_path);
+	ResourceCache::_soft_cache_retain(p_path, res, p_cost);
+	return res;
+}
+
+static bool _is_alive(ObjectID p_id) {
+	return ObjectDB::get_instance(p_id) != nullptr;
+}
+
+TEST_CASE("[ResourceSoftCache] Budget and eviction order") {
+	uint64_t old_budget = ResourceCache::get_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER);
+	ResourceCache::clear_soft_cache();
+	ResourceCache::set_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER, 100);
+	uint64_t evictions = ResourceCache::get_soft_cache_evictions();
+
+	Ref<Resource> a = _retain("res://soft_cache_test_a.tres", 40);
+	Ref<Resource> b = _retain("res://soft_cache_test_b.tres", 40);
+	Ref<Resource> c = _retain("res://soft_cache_test_c.tres", 40);
+	ObjectID a_id = a->get_instance_id();
+	ObjectID b_id = b->get_instance_id();
+	ObjectID c_id = c->get_instance_id();
+
+	// Resources still in use don't count towards the budget.
+	CHECK(ResourceCache::get_soft_cache_usage() == 0);
+
+	b.unref();
+	CHECK(ResourceCache::get_soft_cache_usage() == 40);
+	a.unref();
+	CHECK(ResourceCache::get_soft_cache_usage() == 80);
+	CHECK(_is_alive(a_id));
+	CHECK(_is_alive(b_id));
+
+	// Releasing the third one goes over the budget, so the first released is evicted.
+	c.unref();
+	CHECK(ResourceCache::get_soft_cache_usage() == 80);
+	CHECK(ResourceCache::get_soft_cache_evictions() == evictions + 1);
+	CHECK_FALSE(_is_alive(b_id));
+	CHECK(_is_alive(a_id));
+	CHECK(_is_alive(c_id));
+
+	ResourceCache::set_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER, 40);
+	CHECK(ResourceCache::get_soft_cache_usage() == 40);
+	CHECK_FALSE(_is_alive(a_id));
+	CHECK(_is_alive(c_id));
+
+	ResourceCache::clear_soft_cache();
+	CHECK(ResourceCache::get_soft_cache_usage() == 0);
+	CHECK_FALSE(_is_alive(c_id));
+
+	ResourceCache::set_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER, old_budget);
+}
+
+TEST_CASE("[ResourceSoftCache] Hits and reuse") {
+	uint64_t old_budget = ResourceCache::get_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER);
+	ResourceCache::clear_soft_cache();
+	ResourceCache::set_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER, 100);
+	uint64_t hits = ResourceCache::get_soft_cache_hits();
+
+	const String path = "res://soft_cache_test_hit.tres";
+	Ref<Resource> res = _retain(path, 60);
+	ObjectID id = res->get_instance_id();
+
+	uint64_t cost = 0;
+	CHECK(ResourceCache::_soft_cache_get_cost(path, &cost));
+	CHECK(cost == 60);
+
+	// Still in use elsewhere, so it would not have been loaded again.
+	Ref<Resource> loaded = res;
+	ResourceCache::_soft_cache_touch(path, loaded);
+	loaded.unref();
+	CHECK(ResourceCache::get_soft_cache_hits() == hits);
+
+	res.unref();
+	CHECK(_is_alive(id));
+	CHECK(ResourceCache::get_soft_cache_usage() == 60);
+
+	res = Ref<Resource>(ResourceCache::get(path));
+	REQUIRE(res.is_valid());
+	CHECK(res->get_instance_id() == id);
+	ResourceCache::_soft_cache_touch(path, res);
+	CHECK(ResourceCache::get_soft_cache_hits() == hits + 1);
+	CHECK(ResourceCache::get_soft_cache_usage() == 0);
+
+	// Released again before another one, so it is evicted first.
+	Ref<Resource> other = _retain("res://soft_cache_test_other.tres", 50);
+	ObjectID other_id = other->get_instance_id();
+	res.unref();
+	other.unref();
+	CHECK(_is_alive(other_id));
+	CHECK_FALSE(_is_alive(id));
+
+	ResourceCache::clear_soft_cache();
+	ResourceCache::set_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER, old_budget);
+}
+
+TEST_CASE("[ResourceSoftCache] Renamed resources") {
+	uint64_t old_budget = ResourceCache::get_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER);
+	ResourceCache::clear_soft_cache();
+	ResourceCache::set_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER, 100);
+
+	const String old_path = "res://soft_cache_test_old.tres";
+	const String new_path = "res://soft_cache_test_new.tres";
+	Ref<Resource> res = _retain(old_path, 30);
+	ObjectID id = res->get_instance_id();
+
+	// The entry follows the resource to its new path.
+	res->set_path(new_path);
+	uint64_t cost = 0;
+	CHECK_FALSE(ResourceCache::_soft_cache_get_cost(old_path, &cost));
+	CHECK(ResourceCache::_soft_cache_get_cost(new_path, &cost));
+	CHECK(cost == 30);
+
+	// Releases are still accounted for after the rename.
+	res.unref();
+	CHECK(_is_alive(id));
+	CHECK(ResourceCache::get_soft_cache_usage() == 30);
+
+	res = Ref<Resource>(ResourceCache::get(new_path));
+	REQUIRE(res.is_valid());
+	CHECK(res->get_instance_id() == id);
+	CHECK(ResourceCache::get_soft_cache_usage() == 0);
+
+	// Without a path it can't be loaded again, so it is dropped.
+	res->set_path("");
+	CHECK_FALSE(ResourceCache::_soft_cache_get_cost(new_path, &cost));
+	res.unref();
+	CHECK_FALSE(_is_alive(id));
+	CHECK(ResourceCache::get_soft_cache_usage() == 0);
+
+	ResourceCache::clear_soft_cache();
+	ResourceCache::set_soft_cache_budget(ResourceCache::SOFT_CACHE_OTHER, old_budget);
+}
+
+} // namespace TestResourceSoftCache
+
+#endif // TEST_RESOURCE_SOFT_CACHE_H
@@ -0,0 +1,129 @@
+/*************************************************************************/
+/*  test_scene_tree.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_SCENE_TREE_H
+#define TEST_SCENE_TREE_H
+
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneTree {
+
+// Exposes the realtime group call, so it can be run without a running tree.
+class TestSceneTree : public SceneTree {
+public:
+	typedef GroupMethodCall GroupCall;
+};
+
+// Two unrelated classes binding a method with the same name, so one's bind can't be used on the other.
+class GroupHitCounter : public Node {
+	GDCLASS(GroupHitCounter, Node);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("hit", "amount"), &GroupHitCounter::hit);
+	}
+
+public:
+	int hits = 0;
+
+	void hit(int p_amount) {
+		hits += p_amount;
+	}
+};
+
+class GroupHitLogger : public Node {
+	GDCLASS(GroupHitLogger, Node);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("hit", "amount"), &GroupHitLogger::hit);
+	}
+
+public:
+	Vector<int> log;
+
+	void hit(int p_amount) {
+		log.push_back(p_amount);
+	}
+};
+
+TEST_CASE("[SceneTree] Group calls on nodes of mixed classes") {
+	GroupHitCounter *first = memnew(GroupHitCounter);
+	GroupHitLogger *second = memnew(GroupHitLogger);
+	GroupHitCounter *third = memnew(GroupHitCounter);
+	Node *plain = memnew(Node);
+	GroupHitLogger *fifth = memnew(GroupHitLogger);
+	Node *nodes[] = { first, second, third, plain, fifth };
+
+	Variant amount = 2;
+	const Variant *args[] = { &amount };
+	TestSceneTree::GroupCall group_call;
+	group_call.function = "hit";
+	group_call.args = args;
+	group_call.argcount = 1;
+
+	for (int i = 0; i < 5; i++) {
+		group_call.call(nodes[i]);
+	}
+
+	CHECK_MESSAGE(first->hits == 2, "The method is called on the first node of its class.");
+	CHECK_MESSAGE(third->hits == 2, "The method is resolved again after a node of another class.");
+	CHECK(second->log.size() == 1);
+	CHECK(fifth->log.size() == 1);
+	CHECK(second->log[0] == 2);
+	CHECK(fifth->log[0] == 2);
+	CHECK(group_call.method_class == StringName("GroupHitLogger"));
+
+	// Nodes without the method are skipped, and the call goes on with the others.
+	group_call.call(plain);
+	CHECK(group_call.method == nullptr);
+	group_call.call(first);
+	CHECK(first->hits == 4);
+
+	// A call with missing arguments is reported and doesn't reach the method.
+	group_call.argcount = 0;
+	ERR_PRINT_OFF;
+	group_call.call(first);
+	group_call.call(second);
+	ERR_PRINT_ON;
+	CHECK(first->hits == 4);
+	CHECK(second->log.size() == 1);
+
+	for (int i = 0; i < 5; i++) {
+		memdelete(nodes[i]);
+	}
+}
+
+} // namespace TestSceneTree
+
+#endif // TEST_SCENE_TREE_H
@@ -0,0 +1,170 @@
+/*************************************************************************/
+/*  test_timer_wheel.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_TIMER_WHEEL_H
+#define TEST_TIMER_WHEEL_H
+
+#include "core/print_string.h"
+#include "scene/main/timer_wheel.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTimerWheel {
+
+static double _advance_until_expired(TimerWheel &p_wheel, double p_step, double p_limit, uint64_t p_id) {
+	while (p_wheel.get_time() < p_limit) {
+		LocalVector<ObjectID> expired;
+		p_wheel.advance(p_step, expired);
+		for (uint32_t i = 0; i < expired.size(); i++) {
+			if (expired[i] == ObjectID(p_id)) {
+				return p_wheel.get_time();
+			}
+		}
+	}
+	return -1.0;
+}
+
+TEST_CASE("[TimerWheel] Timers expire in deadline order") {
+	TimerWheel wheel;
+	TimerWheel::Entry entries[4];
+	const double deadlines[4] = { 0.5, 0.1, 3.0, 70.0 };
+	for (int i = 0; i < 4; i++) {
+		entries[i].owner = ObjectID(uint64_t(i + 1));
+		wheel.schedule(&entries[i], deadlines[i]);
+	}
+	CHECK(wheel.get_count() == 4);
+
+	const double step = 1.0 / 60.0;
+	LocalVector<ObjectID> order;
+	while (wheel.get_count() > 0 && wheel.get_time() < 100.0) {
+		LocalVector<ObjectID> expired;
+		wheel.advance(step, expired);
+		for (uint32_t i = 0; i < expired.size(); i++) {
+			const TimerWheel::Entry &entry = entries[expired[i].operator uint64_t() - 1];
+			CHECK_MESSAGE(entry.expired, "Returned entries are flagged as expired.");
+			CHECK_MESSAGE(wheel.get_time() > entry.deadline, "Timers never expire before their deadline.");
+			CHECK_MESSAGE(wheel.get_time() - step <= entry.deadline, "Timers expire on the first advance past their deadline.");
+			order.push_back(expired[i]);
+		}
+	}
+
+	REQUIRE(order.size() == 4);
+	CHECK(order[0] == ObjectID(uint64_t(2)));
+	CHECK(order[1] == ObjectID(uint64_t(1)));
+	CHECK(order[2] == ObjectID(uint64_t(3)));
+	CHECK(order[3] == ObjectID(uint64_t(4)));
+}
+
+TEST_CASE("[TimerWheel] Removed timers do not expire") {
+	TimerWheel wheel;
+	TimerWheel::Entry kept;
+	TimerWheel::Entry removed;
+	kept.owner = ObjectID(uint64_t(1));
+	removed.owner = ObjectID(uint64_t(2));
+	wheel.schedule(&kept, 1.0);
+	wheel.schedule(&removed, 0.5);
+	wheel.remove(&removed);
+	CHECK(!removed.is_scheduled());
+	CHECK(wheel.get_count() == 1);
+
+	LocalVector<ObjectID> expired;
+	wheel.advance(2.0, expired);
+	REQUIRE(expired.size() == 1);
+	CHECK(expired[0] == ObjectID(uint64_t(1)));
+	CHECK(wheel.get_count() == 0);
+
+	{
+		TimerWheel::Entry destroyed;
+		wheel.schedule(&destroyed, 3.0);
+	}
+	CHECK_MESSAGE(wheel.get_count() == 0, "Destroying an entry unschedules it.");
+}
+
+TEST_CASE("[TimerWheel] Far away timers") {
+	TimerWheel wheel;
+	TimerWheel::Entry entry;
+	entry.owner = ObjectID(uint64_t(1));
+
+	// Beyond the span of the wheel, reached one tick walk at a time.
+	wheel.schedule(&entry, 20000.0);
+	double fired = _advance_until_expired(wheel, 10.0, 30000.0, 1);
+	CHECK(fired > 20000.0);
+	CHECK(fired <= 20010.0);
+
+	// Reached through jumps too long to walk.
+	wheel.schedule(&entry, wheel.get_time() + 20000.0);
+	double start = wheel.get_time();
+	fired = _advance_until_expired(wheel, 1000.0, start + 30000.0, 1);
+	CHECK(fired > start + 20000.0);
+	CHECK(fired <= start + 21000.0);
+}
+
+TEST_CASE("[TimerWheel] Timers moved to another wheel") {
+	// Like SceneTree timers switching between the wheel that stops while paused and the one that doesn't.
+	TimerWheel pausable;
+	TimerWheel always;
+	TimerWheel::Entry entry;
+	entry.owner = ObjectID(uint64_t(1));
+
+	LocalVector<ObjectID> expired;
+	always.advance(10.0, expired);
+	pausable.schedule(&entry, 2.0);
+	pausable.advance(0.5, expired);
+	always.advance(0.5, expired);
+	CHECK(expired.size() == 0);
+
+	// Paused from here on, only the other wheel moves.
+	pausable.move_to(&entry, &always);
+	CHECK(entry.get_wheel() == &always);
+	CHECK(pausable.get_count() == 0);
+	CHECK(always.get_count() == 1);
+	CHECK(entry.deadline == doctest::Approx(always.get_time() + 1.5));
+
+	// Moving to the wheel it is already on keeps it as it is.
+	always.move_to(&entry, &always);
+	CHECK(entry.get_wheel() == &always);
+	CHECK(always.get_count() == 1);
+
+	// Only the wheel the timer is on can move it.
+	ERR_PRINT_OFF;
+	pausable.move_to(&entry, &pausable);
+	ERR_PRINT_ON;
+	CHECK(entry.get_wheel() == &always);
+	CHECK(pausable.get_count() == 0);
+
+	double start = always.get_time();
+	double fired = _advance_until_expired(always, 0.1, start + 5.0, 1);
+	CHECK(fired > start + 1.5 - 0.001);
+	CHECK(fired <= start + 1.6 + 0.001);
+}
+
+} // namespace TestTimerWheel
+
+#endif // TEST_TIMER_WHEEL_H
@@ -0,0 +1,278 @@
+/*************************************************************************/
+/*  test_transform_store_3d.h                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_TRANSFORM_STORE_3D_H
+#define TEST_TRANSFORM_STORE_3D_H
+
+#include "core/thread_work_pool.h"
+#include "scene/main/transform_store_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTransformStore3D {
+
+static Transform _offset(real_t p_x) {
+	return Transform(Basis(), Vector3(p_x, 0, 0));
+}
+
+static bool _has_owner(const LocalVector<ObjectID> &p_owners, uint64_t p_owner) {
+	return p_owners.find(ObjectID(p_owner)) >= 0;
+}
+
+TEST_CASE("[TransformStore3D] Entries are stored by depth") {
+	TransformStore3D store;
+	TransformStore3D::ID root = store.create(TransformStore3D::INVALID_ID, ObjectID());
+	TransformStore3D::ID a = store.create(root, ObjectID());
+	TransformStore3D::ID b = store.create(root, ObjectID());
+	TransformStore3D::ID c = store.create(a, ObjectID());
+
+	CHECK(store.size() == 4);
+	CHECK(store.get_level_count() == 3);
+	CHECK(store.get_level_size(0) == 1);
+	CHECK(store.get_level_size(1) == 2);
+	CHECK(store.get_level_size(2) == 1);
+	CHECK(store.get_depth(c) == 2);
+	CHECK(store.get_parent(c) == a);
+
+	// Removing an entry fills its slot with the last one of the level.
+	store.free(c);
+	store.free(a);
+	CHECK(store.get_level_size(1) == 1);
+	CHECK(store.get_parent(b) == root);
+	CHECK(store.size() == 2);
+
+	// Freed IDs are handed out again.
+	TransformStore3D::ID d = store.create(b, ObjectID());
+	CHECK((d == a || d == c));
+	CHECK(store.get_depth(d) == 2);
+
+	ERR_PRINT_OFF;
+	store.free(root); // Still has children.
+	ERR_PRINT_ON;
+	CHECK(store.size() == 3);
+}
+
+TEST_CASE("[TransformStore3D] Global transforms are right before and after an update") {
+	TransformStore3D store;
+	TransformStore3D::ID root = store.create(TransformStore3D::INVALID_ID, ObjectID());
+	TransformStore3D::ID a = store.create(root, ObjectID());
+	TransformStore3D::ID b = store.create(a, ObjectID());
+
+	store.set_local(root, _offset(1));
+	store.set_local(a, _offset(10));
+	store.set_local(b, _offset(100));
+	CHECK(store.is_global_stale(b));
+	CHECK(store.get_global(b).origin.is_equal_approx(Vector3(111, 0, 0)));
+
+	LocalVector<ObjectID> notify;
+	store.update(notify);
+	CHECK(!store.has_pending_changes());
+	CHECK(!store.is_global_stale(b));
+	CHECK(store.get_global(a).origin.is_equal_approx(Vector3(11, 0, 0)));
+	CHECK(store.get_global(b).origin.is_equal_approx(Vector3(111, 0, 0)));
+
+	// Moving a parent makes its subtree stale, but not its siblings.
+	TransformStore3D::ID sibling = store.create(root, ObjectID());
+	store.update(notify);
+	store.set_local(a, _offset(20));
+	CHECK(store.is_global_stale(b));
+	CHECK(!store.is_global_stale(sibling));
+	CHECK(store.get_global(b).origin.is_equal_approx(Vector3(121, 0, 0)));
+
+	store.update(notify);
+	CHECK(store.get_global(b).origin.is_equal_approx(Vector3(121, 0, 0)));
+	CHECK(store.get_global(sibling).origin.is_equal_approx(Vector3(1, 0, 0)));
+
+	// Scale can be kept out of the global transform.
+	store.set_local(a, Transform(Basis().scaled(Vector3(2, 2, 2)), Vector3()));
+	store.set_disable_scale(b, true);
+	CHECK(store.get_global(b).basis.get_scale().is_equal_approx(Vector3(1, 1, 1)));
+	store.update(notify);
+	CHECK(store.get_global(b).basis.get_scale().is_equal_approx(Vector3(1, 1, 1)));
+	CHECK(store.get_global(b).origin.is_equal_approx(Vector3(201, 0, 0)));
+}
+
+TEST_CASE("[TransformStore3D] Updates report the moved entries that want it") {
+	TransformStore3D store;
+	TransformStore3D::ID root = store.create(TransformStore3D::INVALID_ID, ObjectID(uint64_t(1)));
+	TransformStore3D::ID a = store.create(root, ObjectID(uint64_t(2)));
+	TransformStore3D::ID b = store.create(a, ObjectID(uint64_t(3)));
+	TransformStore3D::ID sibling = store.create(root, ObjectID(uint64_t(4)));
+	store.set_notify(a, true);
+	store.set_notify(b, true);
+	store.set_notify(sibling, true);
+
+	// New entries are reported once.
+	LocalVector<ObjectID> notify;
+	store.update(notify);
+	CHECK(notify.size() == 3);
+	notify.clear();
+	store.update(notify);
+	CHECK(notify.size() == 0);
+
+	// Children are reported along with their parent, root doesn't want to be.
+	store.set_local(root, _offset(1));
+	store.update(notify);
+	CHECK(notify.size() == 3);
+	CHECK(!_has_owner(notify, 1));
+
+	notify.clear();
+	store.set_local(a, _offset(1));
+	store.update(notify);
+	CHECK(notify.size() == 2);
+	CHECK(_has_owner(notify, 2));
+	CHECK(_has_owner(notify, 3));
+
+	// Changes made without notifications only skip the entry itself.
+	notify.clear();
+	store.set_local(a, _offset(2), false);
+	store.update(notify);
+	CHECK(notify.size() == 1);
+	CHECK(_has_owner(notify, 3));
+
+	// Unless its parent moved as well.
+	notify.clear();
+	store.set_local(a, _offset(3), false);
+	store.set_local(root, _offset(2));
+	store.update(notify);
+	CHECK(_has_owner(notify, 2));
+
+	// Entries notified early are not reported again for their own change.
+	notify.clear();
+	store.set_local(b, _offset(5));
+	store.skip_notify(b);
+	store.update(notify);
+	CHECK(notify.size() == 0);
+}
+
+TEST_CASE("[TransformStore3D] Reparenting moves the subtree to its new depth") {
+	TransformStore3D store;
+	TransformStore3D::ID root = store.create(TransformStore3D::INVALID_ID, ObjectID());
+	TransformStore3D::ID a = store.create(root, ObjectID());
+	TransformStore3D::ID b = store.create(a, ObjectID());
+	TransformStore3D::ID c = store.create(b, ObjectID());
+	TransformStore3D::ID other = store.create(root, ObjectID());
+	TransformStore3D::ID other_child = store.create(other, ObjectID());
+
+	store.set_local(root, _offset(1));
+	store.set_local(a, _offset(10));
+	store.set_local(b, _offset(100));
+	store.set_local(c, _offset(1000));
+	store.set_local(other, _offset(20));
+	store.set_local(other_child, _offset(200));
+	LocalVector<ObjectID> notify;
+	store.update(notify);
+
+	// Becoming a root, as top level nodes are.
+	store.set_parent(b, TransformStore3D::INVALID_ID);
+	CHECK(store.get_depth(b) == 0);
+	CHECK(store.get_depth(c) == 1);
+	CHECK(store.get_level_size(2) == 1);
+	CHECK(store.get_level_size(3) == 0);
+	CHECK(store.get_global(c).origin.is_equal_approx(Vector3(1100, 0, 0)));
+	store.update(notify);
+	CHECK(store.get_global(c).origin.is_equal_approx(Vector3(1100, 0, 0)));
+
+	// Going deeper, below a sibling subtree.
+	store.set_parent(b, other_child);
+	CHECK(store.get_depth(b) == 3);
+	CHECK(store.get_depth(c) == 4);
+	CHECK(store.get_parent(b) == other_child);
+	store.update(notify);
+	CHECK(store.get_global(c).origin.is_equal_approx(Vector3(1321, 0, 0)));
+
+	// The entries left behind are still right.
+	store.set_local(root, _offset(2));
+	store.update(notify);
+	CHECK(store.get_global(a).origin.is_equal_approx(Vector3(12, 0, 0)));
+	CHECK(store.get_global(c).origin.is_equal_approx(Vector3(1322, 0, 0)));
+
+	ERR_PRINT_OFF;
+	store.set_parent(other, c); // Would be a cycle.
+	ERR_PRINT_ON;
+	CHECK(store.get_parent(other) == root);
+}
+
+TEST_CASE("[TransformStore3D] Parallel updates match serial ones") {
+	TransformStore3D serial;
+	TransformStore3D parallel;
+	const uint32_t roots = 8;
+	const uint32_t children = TransformStore3D::PARALLEL_MIN_LEVEL_SIZE / 2;
+
+	LocalVector<TransformStore3D::ID> ids;
+	for (uint32_t i = 0; i < roots; i++) {
+		TransformStore3D::ID root = serial.create(TransformStore3D::INVALID_ID, ObjectID(uint64_t(ids.size() + 1)));
+		CHECK(parallel.create(TransformStore3D::INVALID_ID, ObjectID(uint64_t(ids.size() + 1))) == root);
+		ids.push_back(root);
+		for (uint32_t j = 0; j < children; j++) {
+			TransformStore3D::ID child = serial.create(root, ObjectID(uint64_t(ids.size() + 1)));
+			CHECK(parallel.create(root, ObjectID(uint64_t(ids.size() + 1))) == child);
+			ids.push_back(child);
+		}
+	}
+	for (uint32_t i = 0; i < ids.size(); i++) {
+		Transform xform(Basis(Vector3(0, 1, 0), i * 0.01), Vector3(i, i % 7, 0));
+		serial.set_local(ids[i], xform);
+		parallel.set_local(ids[i], xform);
+		serial.set_notify(ids[i], i % 3 == 0);
+		parallel.set_notify(ids[i], i % 3 == 0);
+	}
+
+	ThreadWorkPool pool;
+	pool.init(4);
+
+	LocalVector<ObjectID> serial_notify;
+	LocalVector<ObjectID> parallel_notify;
+	serial.update(serial_notify);
+	parallel.update(parallel_notify, &pool);
+
+	// Then only move some roots.
+	for (uint32_t i = 0; i < roots; i += 2) {
+		serial.set_local(ids[i * (children + 1)], _offset(i));
+		parallel.set_local(ids[i * (children + 1)], _offset(i));
+	}
+	serial.update(serial_notify);
+	parallel.update(parallel_notify, &pool);
+	pool.finish();
+
+	CHECK(serial_notify.size() == parallel_notify.size());
+	for (uint32_t i = 0; i < serial_notify.size(); i++) {
+		CHECK(serial_notify[i] == parallel_notify[i]);
+	}
+	bool same = true;
+	for (uint32_t i = 0; i < ids.size(); i++) {
+		same = same && serial.get_global(ids[i]).is_equal_approx(parallel.get_global(ids[i]));
+	}
+	CHECK(same);
+}
+
+} // namespace TestTransformStore3D
+
+#endif // TEST_TRANSFORM_STORE_3D_H
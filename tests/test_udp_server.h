@@ -0,0 +1,268 @@
+/*************************************************************************/
+/*  test_udp_server.h                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2020 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2020 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_UDP_SERVER_H
+#define TEST_UDP_SERVER_H
+
+#include "core/io/packet_peer_udp.h"
+#include "core/io/udp_server.h"
+#include "drivers/unix/net_socket_posix.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestUDPServer {
+
+// Exposes how many receive slots are allocated, and what is still queued for sending.
+class TestUDPServer : public UDPServer {
+public:
+	int get_recv_slots() const { return recv_buffer.size() / PACKET_BUFFER_SIZE; }
+	static int get_recv_slots_max() { return RECV_BATCH_MAX; }
+	int get_queued_count() const { return send_queue.size(); }
+	Ref<NetSocket> get_socket() const { return _sock; }
+	void set_socket(Ref<NetSocket> p_sock) { _sock = p_sock; }
+};
+
+class TestPacketPeerUDP : public PacketPeerUDP {
+public:
+	int get_recv_slots() const { return recv_buffer.size() / PACKET_BUFFER_SIZE; }
+	static int get_recv_slots_max() { return RECV_BATCH_MAX; }
+	Ref<NetSocket> get_socket() const { return _sock; }
+};
+
+// Sends at most send_budget datagrams per batch, like a socket with a full buffer.
+class LimitedSocket : public NetSocketPosix {
+public:
+	int send_budget = -1;
+	bool fail_sends = false;
+
+	virtual Error sendto_batch(const Datagram *p_datagrams, int p_count, int &r_sent) {
+		r_sent = 0;
+		if (fail_sends) {
+			return FAILED;
+		}
+		if (send_budget < 0 || p_count <= send_budget) {
+			return NetSocketPosix::sendto_batch(p_datagrams, p_count, r_sent);
+		}
+		Error err = NetSocketPosix::sendto_batch(p_datagrams, send_budget, r_sent);
+		return err == OK ? ERR_BUSY : err;
+	}
+};
+
+static const IP_Address localhost = IP_Address("127.0.0.1");
+
+static Vector<uint8_t> _make_packet(int p_index, int p_size) {
+	Vector<uint8_t> packet;
+	packet.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		packet.write[i] = uint8_t(p_index * 31 + i);
+	}
+	return packet;
+}
+
+// Loopback delivery is fast but not synchronous, wait on the socket a bounded number of times.
+static bool _wait_for_packets(Ref<PacketPeerUDP> p_peer, int p_count, Ref<NetSocket> p_sock, Ref<UDPServer> p_server = Ref<UDPServer>()) {
+	for (int i = 0; i < 100; i++) {
+		if (p_server.is_valid()) {
+			p_server->poll();
+		}
+		if (p_peer->get_available_packet_count() >= p_count) {
+			return true;
+		}
+		p_sock->poll(NetSocket::POLL_TYPE_IN, 100);
+	}
+	return false;
+}
+
+static bool _check_packets(Ref<PacketPeerUDP> p_peer, int p_count, int p_size, int p_first = 0) {
+	for (int i = p_first; i < p_first + p_count; i++) {
+		const uint8_t *buffer = nullptr;
+		int size = 0;
+		if (p_peer->get_packet(&buffer, size) != OK || size != p_size) {
+			return false;
+		}
+		Vector<uint8_t> expected = _make_packet(i, p_size);
+		for (int j = 0; j < size; j++) {
+			if (buffer[j] != expected[j]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Connects a client to the server, returning the server side peer.
+static Ref<PacketPeerUDP> _connect(Ref<TestUDPServer> p_server, Ref<TestPacketPeerUDP> p_client) {
+	if (p_client->connect_to_host(localhost, p_server->get_local_port()) != OK) {
+		return Ref<PacketPeerUDP>();
+	}
+	Vector<uint8_t> hello = _make_packet(0, 8);
+	p_client->put_packet(hello.ptr(), hello.size());
+	for (int i = 0; i < 100 && !p_server->is_connection_available(); i++) {
+		p_server->get_socket()->poll(NetSocket::POLL_TYPE_IN, 100);
+		p_server->poll();
+	}
+	if (!p_server->is_connection_available()) {
+		return Ref<PacketPeerUDP>();
+	}
+	Ref<PacketPeerUDP> peer = p_server->take_connection();
+	if (!_check_packets(peer, 1, 8)) {
+		return Ref<PacketPeerUDP>();
+	}
+	return peer;
+}
+
+TEST_CASE("[UDPServer] Listening on a port picked by the system") {
+	Ref<TestUDPServer> server = memnew(TestUDPServer);
+	REQUIRE(server->listen(0, localhost) == OK);
+	CHECK(server->get_local_port() > 0);
+
+	server->stop();
+	CHECK(server->get_local_port() == 0);
+}
+
+TEST_CASE("[UDPServer] Receive slots grow with bursts only") {
+	Ref<TestUDPServer> server = memnew(TestUDPServer);
+	REQUIRE(server->listen(0, localhost) == OK);
+	CHECK(server->get_recv_slots() == 0);
+
+	// A single datagram at a time only ever needs one slot.
+	Ref<TestPacketPeerUDP> client = memnew(TestPacketPeerUDP);
+	Ref<PacketPeerUDP> peer = _connect(server, client);
+	REQUIRE(peer.is_valid());
+	CHECK(server->get_recv_slots() == 1);
+
+	CHECK(client->get_available_packet_count() == 0);
+	CHECK(client->get_recv_slots() == 1);
+
+	// A burst fills whole batches, so more slots are used, up to the maximum.
+	const int burst = 40;
+	for (int i = 0; i < burst; i++) {
+		Vector<uint8_t> packet = _make_packet(i, 100);
+		client->put_packet(packet.ptr(), packet.size());
+	}
+	REQUIRE(_wait_for_packets(peer, burst, server->get_socket(), server));
+	CHECK(_check_packets(peer, burst, 100));
+	CHECK(server->get_recv_slots() > 1);
+	CHECK(server->get_recv_slots() <= TestUDPServer::get_recv_slots_max());
+
+	server->stop();
+	CHECK(server->get_recv_slots() == 0);
+	client->close();
+	CHECK(client->get_recv_slots() == 0);
+}
+
+TEST_CASE("[UDPServer] Batched sends and receives keep order and contents") {
+	Ref<TestUDPServer> server = memnew(TestUDPServer);
+	REQUIRE(server->listen(0, localhost) == OK);
+
+	Ref<TestPacketPeerUDP> client = memnew(TestPacketPeerUDP);
+	Ref<PacketPeerUDP> peer = _connect(server, client);
+	REQUIRE(peer.is_valid());
+
+	// Queued until the next poll, then sent with as few calls as possible.
+	server->set_send_batching_enabled(true);
+	const int count = 20;
+	for (int i = 0; i < count; i++) {
+		Vector<uint8_t> packet = _make_packet(i, 1000);
+		CHECK(peer->put_packet(packet.ptr(), packet.size()) == OK);
+	}
+	CHECK(client->get_socket()->poll(NetSocket::POLL_TYPE_IN, 10) == ERR_BUSY);
+	CHECK(server->get_queued_count() == count);
+	server->poll();
+	CHECK(server->get_queued_count() == 0);
+	REQUIRE(_wait_for_packets(client, count, client->get_socket()));
+	CHECK(_check_packets(client, count, 1000));
+	CHECK(client->get_recv_slots() > 1);
+	CHECK(client->get_recv_slots() <= TestPacketPeerUDP::get_recv_slots_max());
+
+	// Large datagrams fit in a single slot, and aren't truncated.
+	Vector<uint8_t> large = _make_packet(0, 30000);
+	client->put_packet(large.ptr(), large.size());
+	REQUIRE(_wait_for_packets(peer, 1, server->get_socket(), server));
+	CHECK(_check_packets(peer, 1, 30000));
+
+	server->stop();
+	client->close();
+}
+
+TEST_CASE("[UDPServer] Batched sends keep what the socket could not take") {
+	Ref<TestUDPServer> server = memnew(TestUDPServer);
+	Ref<LimitedSocket> sock = memnew(LimitedSocket);
+	server->set_socket(sock);
+	REQUIRE(server->listen(0, localhost) == OK);
+
+	Ref<TestPacketPeerUDP> client = memnew(TestPacketPeerUDP);
+	Ref<PacketPeerUDP> peer = _connect(server, client);
+	REQUIRE(peer.is_valid());
+
+	server->set_send_batching_enabled(true);
+	const int count = 12;
+	for (int i = 0; i < count; i++) {
+		Vector<uint8_t> packet = _make_packet(i, 500);
+		CHECK(peer->put_packet(packet.ptr(), packet.size()) == OK);
+	}
+
+	// Only part of the batch goes out, the tail stays queued in order.
+	sock->send_budget = 5;
+	CHECK(server->poll() == OK);
+	CHECK(server->get_queued_count() == count - 5);
+	REQUIRE(_wait_for_packets(client, 5, client->get_socket()));
+	CHECK(_check_packets(client, 5, 500));
+
+	sock->send_budget = 4;
+	CHECK(server->poll() == OK);
+	CHECK(server->get_queued_count() == count - 9);
+
+	sock->send_budget = -1;
+	CHECK(server->poll() == OK);
+	CHECK(server->get_queued_count() == 0);
+	REQUIRE(_wait_for_packets(client, count - 5, client->get_socket()));
+	CHECK(_check_packets(client, count - 5, 500, 5));
+
+	// A failing send doesn't stop incoming packets from being delivered.
+	Vector<uint8_t> packet = _make_packet(0, 500);
+	CHECK(peer->put_packet(packet.ptr(), packet.size()) == OK);
+	sock->fail_sends = true;
+	Vector<uint8_t> reply = _make_packet(3, 64);
+	client->put_packet(reply.ptr(), reply.size());
+	REQUIRE(sock->poll(NetSocket::POLL_TYPE_IN, 1000) == OK);
+	CHECK(server->poll() == FAILED);
+	CHECK(peer->get_available_packet_count() == 1);
+	CHECK(_check_packets(peer, 1, 64, 3));
+	// The datagram that failed is dropped instead of blocking the queue.
+	CHECK(server->get_queued_count() == 0);
+
+	server->stop();
+	client->close();
+}
+
+} // namespace TestUDPServer
+
+#endif // TEST_UDP_SERVER_H
@@ -31,6 +31,9 @@
 #ifndef TEST_VARIANT_H
 #define TEST_VARIANT_H
 
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
 #include "core/variant.h"
 #include "core/variant_parser.h"
 
@@ -106,6 +109,104 @@ TEST_CASE("[Variant] Writer and parser float") {
 	CHECK_MESSAGE(b64_float_parsed == 340282001837565597733306976381245063168.0, "Should not overflow.");
 }
 
+static String _make_parser_sample(int p_elements) {
+	String floats;
+	String ints;
+	for (int i = 0; i < p_elements; i++) {
+		floats += (i ? ", " : "") + rtos(i * -0.37) + (i % 50 == 0 ? "\n" : "");
+		ints += (i ? ", " : "") + itos(i * 7919);
+	}
+
+	String sample = "{\n";
+	sample += "\"floats\": PackedFloat32Array( " + floats + " ),\n";
+	sample += "\"ints\": PackedInt32Array( " + ints + " ),\n";
+	sample += "\"commented\": PackedVector2Array( 1, ; comment\n -2.5e-3 , 3e+2, 4 ),\n";
+	sample += "\"empty\": PackedInt64Array(  ),\n";
+	sample += "\"strings\": PackedStringArray( \"a\", \"b\\\"c\" ),\n";
+	sample += "\"nested\": [ Vector3( 1, 2, 3 ), Color( 0.1, 0.2, 0.3, 1 ), @\"name\", #ff00ff ]\n";
+	sample += "}\n";
+	return sample;
+}
+
+static Variant _parse_file(const String &p_path, bool p_readahead, int &r_line) {
+	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	VariantParser::StreamFile stream(p_readahead);
+	stream.f = f;
+
+	Variant parsed;
+	String errs;
+	r_line = 1;
+	VariantParser::parse(&stream, parsed, errs, r_line);
+	memdelete(f);
+
+	return parsed;
+}
+
+static String _to_string(const Variant &p_variant) {
+	String result;
+	VariantWriter::write_to_string(p_variant, result);
+	return result;
+}
+
+TEST_CASE("[VariantParser] File stream with readahead parses like a string stream") {
+	const String sample = _make_parser_sample(2000);
+	const String path = OS::get_singleton()->get_cache_path().plus_file("godot_test_variant_parser.txt");
+
+	FileAccess *f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f);
+	f->store_string(sample);
+	memdelete(f);
+
+	VariantParser::StreamString ss;
+	ss.s = sample;
+	Variant parsed;
+	String errs;
+	int line = 1;
+	Error err = VariantParser::parse(&ss, parsed, errs, line);
+	CHECK_MESSAGE(err == OK, "Sample should parse without errors.");
+
+	const String expected = _to_string(parsed);
+	int readahead_line;
+	int unbuffered_line;
+	CHECK_MESSAGE(_to_string(_parse_file(path, true, readahead_line)) == expected, "Readahead file stream should give the same result.");
+	CHECK_MESSAGE(_to_string(_parse_file(path, false, unbuffered_line)) == expected, "Unbuffered file stream should give the same result.");
+	CHECK_MESSAGE(readahead_line == line, "Line count should match.");
+	CHECK_MESSAGE(unbuffered_line == line, "Line count should match.");
+
+	Dictionary d = parsed;
+	CHECK(PackedFloat32Array(d["floats"]).size() == 2000);
+	CHECK(PackedVector2Array(d["commented"])[1] == Vector2(3e+2, 4));
+	CHECK(PackedInt64Array(d["empty"]).size() == 0);
+
+	DirAccess::remove_file_or_error(path);
+}
+
+// Run with `godot --test variant-parser-benchmark`.
+void benchmark_parser() {
+	const String sample = _make_parser_sample(500000);
+	const String path = OS::get_singleton()->get_cache_path().plus_file("godot_benchmark_variant_parser.txt");
+
+	FileAccess *f = FileAccess::open(path, FileAccess::WRITE);
+	ERR_FAIL_COND(!f);
+	f->store_string(sample);
+	uint64_t size = f->get_len();
+	memdelete(f);
+
+	for (int i = 0; i < 2; i++) {
+		bool readahead = i == 0;
+		int line;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		_parse_file(path, readahead, line);
+		uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		OS::get_singleton()->print("%s: %d KiB parsed in %.2f msec (%.2f MiB/s)\n", readahead ? "Readahead" : "Unbuffered", int(size / 1024), elapsed / 1000.0, (size / 1048576.0) / (elapsed / 1000000.0));
+	}
+
+	DirAccess::remove_file_or_error(path);
+}
+
+REGISTER_TEST_COMMAND("variant-parser-benchmark", &benchmark_parser);
+
 } // namespace TestVariant
 
 #endif // TEST_VARIANT_H